@@ -108,6 +108,8 @@ int main() {
         printf("knet_channel_ref_accept failed: %d\n", error);
     }
     
+    /* ߳Ҫ߳޸ĵclient_count, һֱȴ */
+    knet_loop_set_max_wait(main_loop, 1);
     /* β */
     for (; times < TEST_TIMES; times++) {
         total_connected = 0;
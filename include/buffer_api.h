@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFER_API_H
+#define BUFFER_API_H
+
+#include "config.h"
+
+/**
+ * һ̶ȵĻ, üΪ1
+ * @param size ȣֽڣ
+ * @return kbuffer_tʵ
+ */
+extern kbuffer_t* knet_buffer_create(uint32_t size);
+
+/**
+ * ü, ̰߳ȫ
+ *
+ * ͬһ͸ܵʱ, ÿεknet_stream_push_buffer֮ǰһü
+ * @param sb kbuffer_tʵ
+ * @return Ӻü
+ */
+extern int knet_buffer_incref(kbuffer_t* sb);
+
+/**
+ * ü, üΪʱٻ, ̰߳ȫ
+ * @param sb kbuffer_tʵ
+ * @return ٺü
+ */
+extern int knet_buffer_decref(kbuffer_t* sb);
+
+/**
+ * д
+ * @param sb kbuffer_tʵ
+ * @param temp ָֽ
+ * @param size ֽ鳤
+ * @retval 0 дʧ
+ * @retval >0 ʵдֽ
+ */
+extern uint32_t knet_buffer_put(kbuffer_t* sb, const char* temp, uint32_t size);
+
+/**
+ * ȡûݳ
+ * @param sb kbuffer_tʵ
+ * @return ݳ
+ */
+extern uint32_t knet_buffer_get_length(kbuffer_t* sb);
+
+/**
+ * ȡû󳤶
+ * @param sb kbuffer_tʵ
+ * @return 󳤶
+ */
+extern uint32_t knet_buffer_get_max_size(kbuffer_t* sb);
+
+/**
+ * ȡûʼַ
+ * @param sb kbuffer_tʵ
+ * @return ݳ
+ */
+extern char* knet_buffer_get_ptr(kbuffer_t* sb);
+
+/**
+ * ջ
+ * @param sb kbuffer_tʵ
+ */
+extern void knet_buffer_clear(kbuffer_t* sb);
+
+#endif /* BUFFER_API_H */
@@ -205,6 +205,8 @@ FuncExport void knet_channel_ref_set_cb(kchannel_ref_t* channel_ref, knet_channe
  * ùܵгʱ
  *
  * ܵгʱΪжϣtimeoutδпɶݼȴʱ
+ * ӽ򱻽ʱЧ, ʱÿtimeout봥һ. ܵԾʱ
+ * kloop_t, Ϊÿܵʱ
  * @param channel_ref kchannel_ref_tʵ
  * @param timeout ʱ룩
  */
@@ -284,6 +286,102 @@ FuncExport int knet_channel_ref_is_ipv6(kchannel_ref_t* channel_ref);
  */
 FuncExport int knet_channel_ref_set_reuseport(kchannel_ref_t* channel_ref);
 
+/**
+ * ջлΪӳģʽ
+ *
+ * ɶд, ÿνֻҪһϵͳ,
+ * knet_stream_peekԷȫɶ. , ܵĹܵҲῪ, ʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @retval error_ok ɹ
+ * @retval error_ringbuffer_mirror_fail ǰƽֻ̨֧ӳʧ, ͨģʽ
+ */
+FuncExport int knet_channel_ref_set_recv_mirror(kchannel_ref_t* channel_ref);
+
+/**
+ * ùģʽ
+ *
+ * ջΪʱݶȡloopĹջ, ջصֱӶȡջ,
+ * صûдݲŸƵܵԼĽջ. ܵԼĽջΪʱͷڴ,
+ * ڴӲһصܴϢĳ. صջܵʹ,
+ * ڻصⱣknet_stream_peekصָ. , ܵĹܵҲῪ, ʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param shared 0, 0ر
+ * @retval error_ok ɹ
+ */
+FuncExport int knet_channel_ref_set_recv_shared(kchannel_ref_t* channel_ref, int shared);
+
+/**
+ * üܵÿζ¼ܵ
+ *
+ * ܵһζ¼ѭܵȴֱûӻﵽ,
+ * ﵽʱʣһѭڽ, ʱܵò
+ * @param channel_ref kchannel_ref_tʵ
+ * @param budget ܵ, 0ΪĬֵ(64)
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters 
+ */
+FuncExport int knet_channel_ref_set_accept_budget(kchannel_ref_t* channel_ref, int budget);
+
+/**
+ * ýˮλ
+ *
+ * ¼Ϻɶֽﵽˮλʱͣȡ, channel_cb_event_recv_throttle֪ͨص,
+ * ԶTCPٶǹر. ͨܵȡ, ɶֽˮλʱָȡ,
+ * channel_cb_event_recv_resume֪ͨص. ú, ܵĹܵʹͬˮλ, ʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param high ˮλ(ֽ), 0Ϊر, رʱָܵȡ
+ * @param low ˮλ(ֽ), Сڸˮλ
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters ˮλСڸˮλ
+ */
+FuncExport int knet_channel_ref_set_recv_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low);
+
+/**
+ * ǷΪﵽոˮλͣȡ
+ * @param channel_ref kchannel_ref_tʵ
+ * @retval 0 ûͣ
+ * @retval 0 ͣ
+ */
+FuncExport int knet_channel_ref_check_recv_throttle(kchannel_ref_t* channel_ref);
+
+/**
+ * ÷ˮλ
+ *
+ * ȴ͵ֽﵽˮλʱchannel_cb_event_send_high֪ͨص, ֮󽵵ˮλʱ
+ * channel_cb_event_send_drained֪ͨص, ߿Ծݴͣͻָд. loop߳дʱ,
+ * صд뺯ǰ. ú, ܵĹܵʹͬˮλ, ʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param high ˮλ(ֽ), 0Ϊر
+ * @param low ˮλ(ֽ), Сڸˮλ
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters ˮλСڸˮλ
+ */
+FuncExport int knet_channel_ref_set_send_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low);
+
+/**
+ * ȡõȴ͵ֽ
+ * loop߳ڵ, ߳д뵫δloop̵߳ݲ
+ * @param channel_ref kchannel_ref_tʵ
+ * @return ȴ͵ֽ
+ */
+FuncExport uint64_t knet_channel_ref_get_send_pending_bytes(kchannel_ref_t* channel_ref);
+
+/**
+ * ýջӦ
+ *
+ * ջʼ(С), ֮, ȴﵽ󳤶Ⱥ,
+ * дʱĴ̶ͬ. ջΪҳidleûյʱسʼ.
+ * Ҫloop߳ڻ߹ܵloop֮ǰ. ú, ܵĹܵʹͬ, ʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param init_size ʼ(ֽ)
+ * @param max_size 󳤶(ֽ), 0Ϊ
+ * @param idle ʱ(), 0Ϊ
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters ʼΪ0ߴ󳤶
+ */
+FuncExport int knet_channel_ref_set_recv_buffer_adaptive(kchannel_ref_t* channel_ref, uint32_t init_size,
+    uint32_t max_size, int idle);
+
 /** @} */
 
 #endif /* CHANNEL_REF_API_H */
@@ -86,8 +86,11 @@
     #include <fcntl.h>
     #include <unistd.h>
     #include <pthread.h>
+    #include <sys/uio.h>
     #ifndef __APPLE__
     #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <sys/timerfd.h>
     #endif /*__APPLE__*/
     #define socket_len_t socklen_t
     #define thread_id_t pthread_t
@@ -135,10 +138,13 @@ typedef struct _thread_runner_t kthread_runner_t;
 typedef struct _stream_t kstream_t;
 typedef struct _kdlist_t kdlist_t;
 typedef struct _kdlist_node_t kdlist_node_t;
+typedef struct _kmpsc_queue_t kmpsc_queue_t;
+typedef struct _kmpsc_node_t kmpsc_node_t;
 typedef struct _ringbuffer_t kringbuffer_t;
 typedef struct _buffer_t kbuffer_t;
 typedef struct _ktimer_loop_t ktimer_loop_t;
 typedef struct _ktimer_t ktimer_t;
+typedef struct _ktimer_node_t ktimer_node_t;
 typedef struct _logger_t klogger_t;
 typedef struct _hash_t khash_t;
 typedef struct _hash_value_t khash_value_t;
@@ -149,6 +155,11 @@ typedef struct _rwlock_t krwlock_t;
 typedef struct _cond_t kcond_t;
 typedef struct _rb_tree_t krbtree_t;
 typedef struct _rb_node_t krbnode_t;
+typedef struct _write_batch_t kwrite_batch_t;
+typedef struct _send_pool_t ksend_pool_t;
+typedef struct _channel_pool_t kchannel_pool_t;
+typedef struct _socket_options_t ksocket_options_t;
+typedef struct _send_queue_t ksend_queue_t;
 
 /* 管道可投递事件 */
 typedef enum _channel_event_e {
@@ -172,6 +183,14 @@ typedef enum _ktimer_type_e {
     ktimer_type_times  = 3, /*! 多次运行 */
 } ktimer_type_e;
 
+/**
+ * 定时器循环类型
+ */
+typedef enum _ktimer_loop_type_e {
+    ktimer_loop_type_rbtree = 1, /*! 红黑树 */
+    ktimer_loop_type_wheel  = 2, /*! 分层时间轮 */
+} ktimer_loop_type_e;
+
 /*! 负载均衡配置 */
 typedef enum _loop_balance_option_e {
     loop_balancer_in  = 1, /*! 开启其他kloop_t的管道在当前kloop_t负载 */
@@ -235,6 +254,7 @@ typedef enum _error_e {
     error_router_wire_exist,
     error_ringbuffer_not_found,
     error_getaddrinfo_fail,
+    error_ringbuffer_mirror_fail,
 } knet_error_e;
 
 /*! 管道回调事件 */
@@ -246,6 +266,10 @@ typedef enum _channel_cb_event_e {
     channel_cb_event_close = 16,           /*! 管道关闭 */
     channel_cb_event_timeout = 32,         /*! 管道读空闲 */
     channel_cb_event_connect_timeout = 64, /*! 主动发起连接，但连接超时 */
+    channel_cb_event_recv_throttle = 128,  /*! 可读字节数达到高水位, 暂停读取 */
+    channel_cb_event_recv_resume = 256,    /*! 可读字节数降到低水位, 恢复读取 */
+    channel_cb_event_send_high = 512,      /*! 等待发送的字节数达到高水位 */
+    channel_cb_event_send_drained = 1024,  /*! 等待发送的字节数降到低水位 */
 } knet_channel_cb_event_e;
 
 /* 日志等级 */
@@ -265,12 +289,22 @@ typedef enum _logger_mode_e {
     logger_mode_override = 8, /* 覆盖已存在的日志文件 */
 } knet_logger_mode_e;
 
+/*! 分散写入的数据块 */
+typedef struct _iovec_t {
+    const void* data; /*! 数据指针 */
+    int         size; /*! 数据长度 */
+} kiovec_t;
+
 /*! 线程函数 */
 typedef void (*knet_thread_func_t)(kthread_runner_t*);
 /*! 管道事件回调函数 */
 typedef void (*knet_channel_ref_cb_t)(kchannel_ref_t*, knet_channel_cb_event_e);
+/*! 零拷贝发送数据释放回调函数, 参数依次为数据指针, 数据长度, 用户参数 */
+typedef void (*knet_write_free_cb_t)(void*, int, void*);
 /*! 定时器回调函数 */
 typedef void (*ktimer_cb_t)(ktimer_t*, void*);
+/*! 嵌入式定时器回调函数 */
+typedef void (*ktimer_node_cb_t)(ktimer_node_t*, void*);
 /*! RPC加密回调函数, 返回 非零 加密后长度, 0 失败 */
 typedef uint16_t (*krpc_encrypt_t)(void*, uint16_t, void*, uint16_t);
 /*! RPC解密回调函数, 返回 非零 解密后长度, 0 失败 */
@@ -291,6 +325,10 @@ typedef void(*knet_rb_node_destroy_cb_t)(void*, uint64_t);
 #elif __APPLE__
     #define LOOP_EPOLL 0   /* epoll */
     #define LOOP_SELECT 1  /* select */
+#elif defined(KNET_USE_URING)
+    #define LOOP_URING 1   /* io_uring, 需要Linux 6.0及以上内核 */
+    #define LOOP_EPOLL 0   /* epoll */
+    #define LOOP_SELECT 0  /* select */
 #else
     #define LOOP_EPOLL 1   /* epoll */
     #define LOOP_SELECT 0  /* select */
@@ -87,6 +87,30 @@ FuncExport kchannel_ref_t* knet_loop_create_channel(kloop_t* loop, uint32_t max_
  */
 FuncExport kchannel_ref_t* knet_loop_create_channel6(kloop_t* loop, uint32_t max_send_list_len, uint32_t recv_ring_len);
 
+/**
+ * ʹ׽ѡôܵ
+ *
+ * ڽ׽ʱӦ, ΪʱܵĹܵʹͬһ, Ϊʱʹͬһ
+ * @param loop kloop_tʵ
+ * @param max_send_list_len ͻ󳤶
+ * @param recv_ring_len ܻλ󳤶
+ * @param options ksocket_options_tʵ, Ϊ0ʱknet_loop_create_channelͬ
+ * @return kchannel_ref_tʵ
+ */
+FuncExport kchannel_ref_t* knet_loop_create_channel_with_options(kloop_t* loop, uint32_t max_send_list_len,
+    uint32_t recv_ring_len, const ksocket_options_t* options);
+
+/**
+ * ʹ׽ѡôIPV6ܵ
+ * @param loop kloop_tʵ
+ * @param max_send_list_len ͻ󳤶
+ * @param recv_ring_len ܻλ󳤶
+ * @param options ksocket_options_tʵ, Ϊ0ʱknet_loop_create_channel6ͬ
+ * @return kchannel_ref_tʵ
+ */
+FuncExport kchannel_ref_t* knet_loop_create_channel6_with_options(kloop_t* loop, uint32_t max_send_list_len,
+    uint32_t recv_ring_len, const ksocket_options_t* options);
+
 /**
  * ʹѴڵ׽ִܵ
  * @param loop kloop_tʵ
@@ -133,6 +157,22 @@ FuncExport int knet_loop_run(kloop_t* loop);
  */
 FuncExport void knet_loop_exit(kloop_t* loop);
 
+/**
+ * ѡȡȴʱ
+ * Ĭû¼͵ڶʱʱѡȡһֱȴ, Լѭڵknet_loop_run_once
+ * Ҫʱ, ȴʱ
+ * @param loop kloop_tʵ
+ * @param ms ȴʱ䣨룩, С㲻
+ */
+FuncExport void knet_loop_set_max_wait(kloop_t* loop, int ms);
+
+/**
+ * ȡѡȡȴʱ
+ * @param loop kloop_tʵ
+ * @return ȴʱ䣨룩, С㲻
+ */
+FuncExport int knet_loop_get_max_wait(kloop_t* loop);
+
 /**
  * ȡԾܵ
  * @param loop kloop_tʵ
@@ -154,6 +194,36 @@ FuncExport int knet_loop_get_close_channel_count(kloop_t* loop);
  */
 FuncExport kloop_profile_t* knet_loop_get_profile(kloop_t* loop);
 
+/**
+ * ȡkloop_tڲĶʱѭ(ֲʱ)
+ *
+ * kloop_tÿλʱ, Ƕʽʱktimer_node_t, ֻkloop_t߳ʹ
+ * @param loop kloop_tʵ
+ * @return ktimer_loop_tʵ
+ */
+FuncExport ktimer_loop_t* knet_loop_get_timer_loop(kloop_t* loop);
+
+/**
+ * ߾ȶʱ
+ *
+ * ڲʱֵĵδΪtick_us΢, ʹktimer_node_start_usȺǺ뼶ʱ.
+ * epollʵѡȡעtimerfd, ÿεȴǰΪĵʱ; io_uringʵֵĵȴʱȷ΢;
+ * ʵԺΪλȴ
+ * @param loop kloop_tʵ
+ * @param tick_us ʱֵδ𳤶ȣ΢룩
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_loop_enable_hrtimer(kloop_t* loop, time_t tick_us);
+
+/**
+ * Ƿ˸߾ȶʱ
+ * @param loop kloop_tʵ
+ * @retval 0 δ
+ * @retval  ѿ
+ */
+FuncExport int knet_loop_check_hrtimer(kloop_t* loop);
+
 /** @} */
 
 #endif /* LOOP_API_H */
@@ -113,6 +113,15 @@ extern uint32_t ringbuffer_find(kringbuffer_t* rb, const char* target, uint32_t*
  */
 extern uint32_t ringbuffer_available(kringbuffer_t* rb);
 
+/**
+ * ȡÿɶݵʼַԼʵֽ, ıλ
+ * ģʽ¿ȫɶ, ͨģʽݿԽĩβʱֻĩβ֮ǰĲ
+ * @param rb kringbuffer_tʵ
+ * @param size ʵֽ
+ * @return ɶʼַ
+ */
+extern char* ringbuffer_peek(kringbuffer_t* rb, uint32_t* size);
+
 /**
  * пɶֽ
  * @param rb kringbuffer_tʵ
@@ -192,6 +201,15 @@ extern uint32_t ringbuffer_write_lock_size(kringbuffer_t* rb);
  */
 extern char* ringbuffer_write_lock_ptr(kringbuffer_t* rb);
 
+/**
+ * дȫдռ, дռԽĩβʱΪ, һϵͳ÷ɢ
+ * ʱ, дringbuffer_write_commitύʵдܳ
+ * @param rb kringbuffer_tʵ
+ * @param iov д, Ԫ
+ * @return д
+ */
+extern int ringbuffer_write_lock_iov(kringbuffer_t* rb, kiovec_t* iov);
+
 /**
  * ύɹдֽ
  * @param rb kringbuffer_tʵ
@@ -228,6 +246,39 @@ extern int ringbuffer_empty(kringbuffer_t* rb);
  */
 extern uint32_t ringbuffer_get_max_size(kringbuffer_t* rb);
 
+/**
+ * лΪӳģʽ
+ *
+ * ͬһҳڵַռӳ, ɶд򶼿ͨһָ,
+ * дΪƶض. Ȼ϶뵽ҳ, ݱ
+ * @param rb kringbuffer_tʵ
+ * @retval error_ok ɹ
+ * @retval error_ringbuffer_mirror_fail ǰƽֻ̨֧ӳʧ, ԭģʽ
+ * @retval error_recvbuffer_locked ״̬
+ */
+extern int ringbuffer_set_mirror(kringbuffer_t* rb);
+
+/**
+ * ǷΪӳģʽ
+ * @param rb kringbuffer_tʵ
+ * @retval 0 
+ * @retval 0 
+ */
+extern int ringbuffer_is_mirror(kringbuffer_t* rb);
+
+/**
+ * , ͷŶڴ
+ *
+ * ³Сڿɶݳʱɶݳ, Сڵǰʱκβ.
+ * ӳģʽ³϶뵽ҳ. Ϊʱ³ȿΪ0, ͷȫڴ, ֮дʱ·
+ * @param rb kringbuffer_tʵ
+ * @param size ³
+ * @retval error_ok ɹ
+ * @retval error_recvbuffer_locked ״̬
+ * @retval error_ringbuffer_mirror_fail ӳʧ, 
+ */
+extern int ringbuffer_shrink(kringbuffer_t* rb, uint32_t size);
+
 /**
  * ݴӡĻ
  * @param rb kringbuffer_tʵ
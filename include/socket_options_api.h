@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SOCKET_OPTIONS_API_H
+#define SOCKET_OPTIONS_API_H
+
+#include "config.h"
+
+/**
+ * ׽ѡ
+ *
+ * ڹܵʱӦõ׽, Ĭֵδʹʱͬ: رӳٷ, رlingerkeep-alive,
+ * /дջͬ. ñܵĹ̳ܵ,
+ * ѾӼ׽ּ̳еѡᱻ. ʹõĹ֮ܵǰñ뱣Ч,
+ * ֵ֧ѡ
+ * @return ksocket_options_tʵ
+ */
+FuncExport ksocket_options_t* knet_socket_options_create();
+
+/**
+ * ׽ѡ
+ * @param options ksocket_options_tʵ
+ */
+FuncExport void knet_socket_options_destroy(ksocket_options_t* options);
+
+/**
+ * Ƿرӳٷ(TCP_NODELAY)
+ * @param options ksocket_options_tʵ
+ * @param on Ϊرӳٷ, ĬΪ1
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_nodelay(ksocket_options_t* options, int on);
+
+/**
+ * linger
+ * @param options ksocket_options_tʵ
+ * @param on Ƿ, ĬϹر
+ * @param seconds رʱȴδݵʱ䣨룩
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_linger(ksocket_options_t* options, int on, int seconds);
+
+/**
+ * keep-alive
+ * @param options ksocket_options_tʵ
+ * @param on Ƿ, ĬϹر
+ * @param idle ӿжúʼ̽룩, Ϊ0ʱʹϵͳĬֵ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_keepalive(ksocket_options_t* options, int on, int idle);
+
+/**
+ * /д
+ * @param options ksocket_options_tʵ
+ * @param recv_size , 0ΪϵͳԶ, -1Ϊܵջͬ(Ĭ)
+ * @param send_size д, 0ΪϵͳԶ, -1Ϊܵջͬ(Ĭ)
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_buffer_size(ksocket_options_t* options, int recv_size, int send_size);
+
+/**
+ * TCP_DEFER_ACCEPT, ֻԼЧ
+ *
+ * ӽյһݰ֪ͨ, ֻӲݵĿͻռõԴ
+ * @param options ksocket_options_tʵ
+ * @param seconds ȴʱ䣨룩, 0Ϊر(Ĭ)
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_defer_accept(ksocket_options_t* options, int seconds);
+
+/**
+ * TCP_QUICKACK
+ *
+ * ѡӼ׽ּ̳, ÿܵĹܵ
+ * @param options ksocket_options_tʵ
+ * @param on ǷACK, Ĭϲ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_quickack(ksocket_options_t* options, int on);
+
+/**
+ * TCP_USER_TIMEOUT
+ * @param options ksocket_options_tʵ
+ * @param ms ѷδȷϵʱ䣨룩, ʱӱر, 0ΪʹϵͳĬֵ(Ĭ)
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_socket_options_set_user_timeout(ksocket_options_t* options, uint32_t ms);
+
+#endif /* SOCKET_OPTIONS_API_H */
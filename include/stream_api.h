@@ -107,6 +107,42 @@ FuncExport int knet_stream_pop_until(kstream_t* stream, const char* end, void* b
  */
 FuncExport int knet_stream_push(kstream_t* stream, const void* buffer, int size);
 
+/**
+ * ڷɢд
+ *
+ * ڹ̵ܵ߳ʱʹһϵͳ÷ݿ, ҪȺϲʱ
+ * @param stream kstream_tʵ
+ * @param iov ݿ
+ * @param count ݿ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_stream_pushv(kstream_t* stream, const kiovec_t* iov, int count);
+
+/**
+ * 㿽д, Ȩƽ
+ *
+ * ݲᱻ, ޷͵Ĳڷɺfree_cbͷ, ۳ɹfree_cbᱻֻһ.
+ * ̵߳ʱfree_cbڹܵ߳ڱ
+ * @param stream kstream_tʵ
+ * @param buffer 
+ * @param size С
+ * @param free_cb ͷŻص
+ * @param ctx ͷŻص
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_stream_push_owned(kstream_t* stream, void* buffer, int size, knet_write_free_cb_t free_cb, void* ctx);
+
+/**
+ * 㿽дkbuffer_t, ɺһλü
+ * @param stream kstream_tʵ
+ * @param buffer kbuffer_tʵ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_stream_push_buffer(kstream_t* stream, kbuffer_t* buffer);
+
 /**
  * дݣɱַ
  *
@@ -128,6 +164,16 @@ FuncExport int knet_stream_push_varg(kstream_t* stream, const char* format, ...)
  */
 FuncExport int knet_stream_copy(kstream_t* stream, void* buffer, int size);
 
+/**
+ * ȡڿɶݵʼַ, Ҳ, ԭؽЭ
+ * ܵջ(knet_channel_ref_set_recv_mirror)ɷȫɶ,
+ * ݿԽĩβʱֻܷĩβ֮ǰĲ. ַһζȡǰЧ
+ * @param stream kstream_tʵ
+ * @param size ʵֽ
+ * @return ɶʼַ
+ */
+FuncExport const char* knet_stream_peek(kstream_t* stream, int* size);
+
 /**
  * 滻
  * @param stream kstream_tʵ
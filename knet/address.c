@@ -29,49 +29,157 @@
  * ַ
  */
 struct _address_t {
-    char ip[128]; /* IP */
-    int  port;   /* ˿ */
+    char                    ip[128];   /* IP */
+    int                     port;      /* ˿ */
+    int                     init;      /* Ƿͨknet_address_initʼ */
+    int                     formatted; /* ipǷѾsa */
+    struct sockaddr_storage sa;        /* Ƶַ, ss_familyΪ0ʱЧ */
 };
 
 kaddress_t* knet_address_create() {
     kaddress_t* address = knet_create(kaddress_t);
     verify(address);
-    memset(address, 0, sizeof(kaddress_t));
-    /* Ĭϵַ */
-    strcpy(address->ip, "0.0.0.0");
+    knet_address_init(address, 0);
+    address->init = 0;
     return address;
 }
 
 kaddress_t* knet_address_create6() {
     kaddress_t* address = knet_create(kaddress_t);
+    verify(address);
+    knet_address_init(address, 1);
+    address->init = 0;
+    return address;
+}
+
+uint32_t knet_address_get_object_size() {
+    return sizeof(kaddress_t);
+}
+
+kaddress_t* knet_address_init(kaddress_t* address, int ipv6) {
     verify(address);
     memset(address, 0, sizeof(kaddress_t));
     /* Ĭϵַ */
-    strcpy(address->ip, ":::");
+    if (ipv6) {
+        strcpy(address->ip, ":::");
+    } else {
+        strcpy(address->ip, "0.0.0.0");
+    }
+    address->formatted = 1;
+    address->init      = 1;
     return address;
 }
 
 void knet_address_destroy(kaddress_t* address) {
     verify(address);
-    if (address) {
+    if (address && !address->init) {
         knet_free(address);
     }
 }
 
 void knet_address_set(kaddress_t* address, const char* ip, int port) {
+    struct sockaddr_in*  sa4 = (struct sockaddr_in*)&address->sa;
+    struct sockaddr_in6* sa6 = (struct sockaddr_in6*)&address->sa;
     verify(address);
     /* IP, ˿ */
     if (ip) {
         strcpy(address->ip, ip);
+        /* ͬʱƵַ, ޷ʱƵַЧ */
+        memset(&address->sa, 0, sizeof(address->sa));
+        if (strchr(ip, ':')) {
+            if (1 == inet_pton(AF_INET6, ip, &sa6->sin6_addr)) {
+                sa6->sin6_family = AF_INET6;
+            }
+        } else {
+            if (1 == inet_pton(AF_INET, ip, &sa4->sin_addr)) {
+                sa4->sin_family = AF_INET;
+            }
+        }
+    }
+    address->formatted = 1;
+    address->port      = port;
+    if (sa6->sin6_family == AF_INET6) {
+        sa6->sin6_port = htons((uint16_t)port);
+    } else if (sa4->sin_family == AF_INET) {
+        sa4->sin_port = htons((uint16_t)port);
+    }
+}
+
+void knet_address_set_sockaddr(kaddress_t* address, const struct sockaddr* sa) {
+    verify(address);
+    verify(sa);
+    memset(&address->sa, 0, sizeof(address->sa));
+    if (sa->sa_family == AF_INET6) {
+        memcpy(&address->sa, sa, sizeof(struct sockaddr_in6));
+        address->port = ntohs(((const struct sockaddr_in6*)sa)->sin6_port);
+    } else if (sa->sa_family == AF_INET) {
+        memcpy(&address->sa, sa, sizeof(struct sockaddr_in));
+        address->port = ntohs(((const struct sockaddr_in*)sa)->sin_port);
+    } else {
+        address->port = 0;
     }
-    address->port = port;
+    /* IPַڵһȡʱ */
+    address->formatted = 0;
 }
 
 const char* address_get_ip(kaddress_t* address) {
     verify(address);
+    if (!address->formatted) {
+        if (address->sa.ss_family == AF_INET6) {
+            inet_ntop(AF_INET6, (void*)&((struct sockaddr_in6*)&address->sa)->sin6_addr,
+                address->ip, sizeof(address->ip));
+        } else if (address->sa.ss_family == AF_INET) {
+            inet_ntop(AF_INET, (void*)&((struct sockaddr_in*)&address->sa)->sin_addr,
+                address->ip, sizeof(address->ip));
+        }
+        address->formatted = 1;
+    }
     return address->ip;
 }
 
+int address_get_family(kaddress_t* address) {
+    verify(address);
+    return address->sa.ss_family;
+}
+
+const void* address_get_ip_bytes(kaddress_t* address, int* length) {
+    verify(address);
+    if (address->sa.ss_family == AF_INET6) {
+        if (length) {
+            *length = 16;
+        }
+        return &((struct sockaddr_in6*)&address->sa)->sin6_addr;
+    } else if (address->sa.ss_family == AF_INET) {
+        if (length) {
+            *length = 4;
+        }
+        return &((struct sockaddr_in*)&address->sa)->sin_addr;
+    }
+    if (length) {
+        *length = 0;
+    }
+    return 0;
+}
+
+const struct sockaddr* address_get_sockaddr(kaddress_t* address, int* length) {
+    verify(address);
+    if (address->sa.ss_family == AF_INET6) {
+        if (length) {
+            *length = sizeof(struct sockaddr_in6);
+        }
+    } else if (address->sa.ss_family == AF_INET) {
+        if (length) {
+            *length = sizeof(struct sockaddr_in);
+        }
+    } else {
+        if (length) {
+            *length = 0;
+        }
+        return 0;
+    }
+    return (const struct sockaddr*)&address->sa;
+}
+
 int address_get_port(kaddress_t* address) {
     verify(address);
     return address->port;
@@ -82,5 +190,5 @@ int address_equal(kaddress_t* address, const char* ip, int port) {
     verify(ip);
     verify(port);
     /* ȫͬ */
-    return (strcmp(address->ip, ip) || !(address->port == port));
+    return (strcmp(address_get_ip(address), ip) || !(address->port == port));
 }
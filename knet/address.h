@@ -40,6 +40,20 @@ kaddress_t* knet_address_create();
  */
 kaddress_t* knet_address_create6();
 
+/**
+ * ȡkaddress_t, ڽַǶ뵽ڴ
+ * @return kaddress_t
+ */
+uint32_t knet_address_get_object_size();
+
+/**
+ * ڵṩڴϳʼkaddress_tʵ, knet_address_destroyͷڴ
+ * @param address Ϊknet_address_get_object_size()ڴ
+ * @param ipv6 ǷIPV6
+ * @return kaddress_tʵ
+ */
+kaddress_t* knet_address_init(kaddress_t* address, int ipv6);
+
 /**
  * һkaddress_tʵ
  * @param address kaddress_tʵ
@@ -54,4 +68,11 @@ void knet_address_destroy(kaddress_t* address);
  */
 void knet_address_set(kaddress_t* address, const char* ip, int port);
 
+/**
+ * öƵַ, IPַڵһεaddress_get_ipʱ
+ * @param address kaddress_tʵ
+ * @param sa ַ, AF_INETAF_INET6
+ */
+void knet_address_set_sockaddr(kaddress_t* address, const struct sockaddr* sa);
+
 #endif /* ADDRESS_H */
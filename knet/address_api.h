@@ -42,12 +42,41 @@
 
 /**
  * ȡIP
+ *
+ * ׽ȡõĵַڵһεʱIPַ
  * @param address kaddress_tʵ
  * @retval Чָ IPַ
  * @retval 0 ܵδ
  */
 FuncExport const char* address_get_ip(kaddress_t* address);
 
+/**
+ * ȡõַ
+ * @param address kaddress_tʵ
+ * @retval AF_INET IPV4ַ
+ * @retval AF_INET6 IPV6ַ
+ * @retval 0 ַЧ
+ */
+FuncExport int address_get_family(kaddress_t* address);
+
+/**
+ * ȡöIP, ֽ, ҪIPַ
+ * @param address kaddress_tʵ
+ * @param length IP, IPV4Ϊ4, IPV6Ϊ16, Ϊ0
+ * @retval Чָ IP
+ * @retval 0 ַЧ
+ */
+FuncExport const void* address_get_ip_bytes(kaddress_t* address, int* length);
+
+/**
+ * ȡöƵַ
+ * @param address kaddress_tʵ
+ * @param length صַ, Ϊ0
+ * @retval Чָ struct sockaddr_instruct sockaddr_in6
+ * @retval 0 ַЧ
+ */
+FuncExport const struct sockaddr* address_get_sockaddr(kaddress_t* address, int* length);
+
 /**
  * ȡport
  * @param address kaddress_tʵ
@@ -24,6 +24,7 @@
 
 #include "buffer.h"
 #include "logger.h"
+#include "misc.h"
 
 /**
  * ͻ
@@ -33,6 +34,7 @@ struct _buffer_t {
     char*    ptr; /* ʼַ */
     uint32_t len; /*  */
     uint32_t pos; /* ǰλ */
+    atomic_counter_t ref; /* ü */
 };
 
 kbuffer_t* knet_buffer_create(uint32_t size) {
@@ -51,9 +53,31 @@ kbuffer_t* knet_buffer_create(uint32_t size) {
     sb->m   = sb->ptr;
     sb->pos = 0;
     sb->len = size;
+    sb->ref = 1;
     return sb;
 }
 
+int knet_buffer_incref(kbuffer_t* sb) {
+    verify(sb);
+    return atomic_counter_inc(&sb->ref);
+}
+
+void knet_buffer_free_cb(void* ptr, int size, void* ctx) {
+    (void)ptr;
+    (void)size;
+    knet_buffer_decref((kbuffer_t*)ctx);
+}
+
+int knet_buffer_decref(kbuffer_t* sb) {
+    int ref = 0;
+    verify(sb);
+    ref = atomic_counter_dec(&sb->ref);
+    if (!ref) {
+        knet_buffer_destroy(sb);
+    }
+    return ref;
+}
+
 void knet_buffer_destroy(kbuffer_t* sb) {
     verify(sb);
     if (!sb) {
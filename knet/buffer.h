@@ -26,44 +26,14 @@
 #define BUFFER_H
 
 #include "config.h"
+#include "buffer_api.h"
 
 /**
- * һ̶ȵĻ
- * @param size ȣֽڣ
- * @return kbuffer_tʵ
- */
-kbuffer_t* knet_buffer_create(uint32_t size);
-
-/**
- * ٻ
+ * ٻ, ü
  * @param sb kbuffer_tʵ
  */
 void knet_buffer_destroy(kbuffer_t* sb);
 
-/**
- * д
- * @param sb kbuffer_tʵ
- * @param temp ָֽ
- * @param size ֽ鳤
- * @retval 0 дʧ
- * @retval >0 ʵдֽ
- */
-uint32_t knet_buffer_put(kbuffer_t* sb, const char* temp, uint32_t size);
-
-/**
- * ȡûݳ
- * @param sb kbuffer_tʵ
- * @return ݳ
- */
-uint32_t knet_buffer_get_length(kbuffer_t* sb);
-
-/**
- * ȡû󳤶
- * @param sb kbuffer_tʵ
- * @return 󳤶
- */
-uint32_t knet_buffer_get_max_size(kbuffer_t* sb);
-
 /**
  * ԻǷ㹻ռ
  * @param sb kbuffer_tʵ
@@ -73,13 +43,6 @@ uint32_t knet_buffer_get_max_size(kbuffer_t* sb);
  */
 int knet_buffer_enough(kbuffer_t* sb, uint32_t size);
 
-/**
- * ȡûʼַ
- * @param sb kbuffer_tʵ
- * @return ݳ
- */
-char* knet_buffer_get_ptr(kbuffer_t* sb);
-
 /**
  * ʼַ
  * @param sb kbuffer_tʵ
@@ -88,9 +51,11 @@ char* knet_buffer_get_ptr(kbuffer_t* sb);
 void knet_buffer_adjust(kbuffer_t* sb, uint32_t gap);
 
 /**
- * ջ
- * @param sb kbuffer_tʵ
+ * 㿽ͷŻص, ctxΪkbuffer_tʵ, ü
+ * @param ptr ָ
+ * @param size ݳ
+ * @param ctx kbuffer_tʵ
  */
-void knet_buffer_clear(kbuffer_t* sb);
+void knet_buffer_free_cb(void* ptr, int size, void* ctx);
 
 #endif /* BUFFER_H */
@@ -24,21 +24,50 @@
 
 #include "channel.h"
 #include "ringbuffer.h"
+#include "send_queue.h"
 #include "loop.h"
+#include "loop_profile.h"
 #include "misc.h"
+#include "socket_options.h"
 #include "logger.h"
 
 /**
  * ܵ
  */
 struct _channel_t {
-    kringbuffer_t* send_ringbuffer;   /* ͻλ, ͨsocketʧܵݻ, ȴ´η*/
-    kringbuffer_t* recv_ringbuffer;   /* λ, ͨsocketȡݻ */
+    ksend_queue_t* send_queue;      /* Ͷ, ͨsocketʧܵݻ, ȴ´η */
+    kringbuffer_t* recv_ringbuffer; /* λ, ͨsocketȡݻ */
     socket_t      socket_fd;         /* ׽ */
     uint64_t      uuid;             /* ܵUUID */
     int          ipv6;             /* ǷIPV6 */
+    kloop_profile_t* profile;       /* kloop_tͳ, ¼ϵͳô */
+    uint32_t      recv_limit;       /* ɶֽﵽֵֹͣȡ, 0Ϊ */
+    uint32_t      recv_max;         /* 󳤶, ﵽ, 0Ϊ */
+    uint32_t      recv_capacity;    /* ѼͳƵĶ */
+    kringbuffer_t* recv_scratch;    /* kloop_tĹջ */
+    int           recv_shared;      /* Ƿģʽ */
+    int           recv_in_scratch;  /* νյǷڹջ */
+    int           init;             /* Ƿͨknet_channel_initʼ */
 };
 
+/**
+ * Ƕָ볤ȵ
+ */
+#define knet_channel_align(size) \
+    (((size) + sizeof(void*) * 2 - 1) & ~(sizeof(void*) * 2 - 1))
+
+/**
+ * ¼ݵϵͳô
+ */
+#define knet_channel_count_send_calls(channel, count) \
+    if ((channel)->profile) { knet_loop_profile_add_send_call_count((channel)->profile, (count)); }
+
+/**
+ * ¼ݵϵͳô
+ */
+#define knet_channel_count_recv_calls(channel, count) \
+    if ((channel)->profile) { knet_loop_profile_add_recv_call_count((channel)->profile, (count)); }
+
 kchannel_t* knet_channel_create(uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6) {
     socket_t socket_fd = 0;
     /* socket */
@@ -56,45 +85,65 @@ kchannel_t* knet_channel_create(uint32_t max_send_list_len, uint32_t recv_ring_l
 }
 
 kchannel_t* knet_channel_create_exist_socket_fd(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6) {
-    kchannel_t* channel = knet_create(kchannel_t);
+    kchannel_t* channel = (kchannel_t*)knet_malloc(knet_channel_get_object_size());
+    verify(channel);
+    knet_channel_init(channel, socket_fd, max_send_list_len, recv_ring_len, ipv6);
+    knet_channel_setup_socket(channel, recv_ring_len, 0);
+    channel->init = 0;
+    return channel;
+}
+
+uint32_t knet_channel_get_object_size() {
+    return (uint32_t)(knet_channel_align(sizeof(kchannel_t)) +
+        knet_channel_align(send_queue_get_object_size()) + ringbuffer_get_object_size());
+}
+
+kchannel_t* knet_channel_init(kchannel_t* channel, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6) {
+    char* ptr = (char*)channel;
     verify(channel);
     (void)max_send_list_len;
     memset(channel, 0, sizeof(kchannel_t));
+    channel->init = 1;
     channel->uuid = uuid_create(); /* ܵUUID */
-    channel->send_ringbuffer = ringbuffer_create(recv_ring_len); /* д */
-    verify(channel->send_ringbuffer);
-    channel->recv_ringbuffer = ringbuffer_create(recv_ring_len); /*  */
+    /* ͶкͶ֮ܵ */
+    ptr += knet_channel_align(sizeof(kchannel_t));
+    channel->send_queue = send_queue_init((ksend_queue_t*)ptr); /* Ͷ */
+    verify(channel->send_queue);
+    ptr += knet_channel_align(send_queue_get_object_size());
+    channel->recv_ringbuffer = ringbuffer_init((kringbuffer_t*)ptr, recv_ring_len); /*  */
     verify(channel->recv_ringbuffer);
     channel->socket_fd      = socket_fd;
     channel->ipv6          = ipv6;
+    return channel;
+}
+
+void knet_channel_setup_socket(kchannel_t* channel, uint32_t recv_ring_len, const ksocket_options_t* options) {
+    verify(channel);
     /* Ϊ */
     socket_set_non_blocking_on(channel->socket_fd);
-    /* رӳٷ */
-    socket_set_nagle_off(channel->socket_fd);
-    /* رTIME_WAIT */
-    socket_set_linger_off(channel->socket_fd);
-    /* رkeep alive */
-    socket_set_keepalive_off(channel->socket_fd);
-    /* /д */
-    socket_set_recv_buffer_size(channel->socket_fd, recv_ring_len);
-    socket_set_send_buffer_size(channel->socket_fd, recv_ring_len);
-    return channel;
+    /* ӳٷ, linger, keep alive, /дȵ */
+    knet_socket_options_apply(options, channel->socket_fd, recv_ring_len);
 }
 
 void knet_channel_destroy(kchannel_t* channel) {
     verify(channel);
-    /* ٷͻ */
-    if (channel->send_ringbuffer) {
-        ringbuffer_destroy(channel->send_ringbuffer);
+    /* ٷͶ, ͷδ͵㿽 */
+    if (channel->send_queue) {
+        send_queue_destroy(channel->send_queue);
     }
     /* ٽջ */
     if (channel->recv_ringbuffer) {
+        if (channel->profile) {
+            knet_loop_profile_sub_recv_buffer_bytes(channel->profile, channel->recv_capacity);
+        }
         ringbuffer_destroy(channel->recv_ringbuffer);
     }
     /* رsocket */
     knet_channel_close(channel);
-    /* ٹܵ */
-    knet_free(channel);
+    /* ٹܵ, ͨknet_channel_initʼĹܵڴɵ߹ */
+    if (!channel->init) {
+        knet_free(channel);
+    }
 }
 
 int knet_channel_connect(kchannel_t* channel, const char* ip, int port) {
@@ -130,79 +179,169 @@ int knet_channel_accept(kchannel_t* channel, const char* ip, int port, int backl
 }
 
 int knet_channel_send_buffer(kchannel_t* channel) {
-    int bytes = 0;
-    int size = 0;
-    char* ptr = 0;
+#if !LOOP_URING
+    int      error = error_ok;
+    uint32_t calls = 0;
+#endif /* !LOOP_URING */
     verify(channel);
-    verify(channel->send_ringbuffer);
-    if (knet_channel_send_buffer_reach_max(channel)) {
-        /* ʼ޷ */
-        return error_send_fail;
-    }
-    for (; (size = ringbuffer_read_lock_size(channel->send_ringbuffer));) {
-        ptr = ringbuffer_read_lock_ptr(channel->send_ringbuffer);
-        bytes = socket_send(channel->socket_fd, ptr, size);
-        if (bytes <= 0) {
-            /* 󣬹ر */
-            ringbuffer_read_commit(channel->send_ringbuffer, 0);
-            return error_send_fail;
-        } else {
-            /* ͳɹ */
-            ringbuffer_read_commit(channel->send_ringbuffer, (uint32_t)bytes);
-        }
-    }
-    return (ringbuffer_empty(channel->send_ringbuffer) ? error_ok : error_send_patial);
+    verify(channel->send_queue);
+#if LOOP_URING
+    /* ѡȡύ, ڷɺŴӶƳ */
+    return (send_queue_empty(channel->send_queue) ? error_ok : error_send_patial);
+#else
+    /* ͨwritevͶڵݿ, һϵͳ÷Ͷݿ, ַʱֹͣ */
+    error = send_queue_send(channel->send_queue, channel->socket_fd, &calls);
+    knet_channel_count_send_calls(channel, calls);
+    return error;
+#endif /* LOOP_URING */
 }
 
 int knet_channel_send(kchannel_t* channel, const char* data, int size) {
-    int        bytes       = 0;
-    /*kbuffer_t* send_buffer = 0;*/
+    int bytes = 0;
     verify(channel);
     verify(data);
     verify(size);
-    verify(channel->send_ringbuffer);
-    /* ʼ޷ */
-    if (knet_channel_send_buffer_reach_max(channel)) {
-        return error_send_fail;
-    }
-    if (ringbuffer_empty(channel->send_ringbuffer)) {
+    verify(channel->send_queue);
+    if (send_queue_empty(channel->send_queue)) {
         /* ֱӷ */
         bytes = socket_send(channel->socket_fd, data, size);
+        knet_channel_count_send_calls(channel, 1);
     }
     if (bytes < 0) {
         return error_send_fail;
     }
-    /* ֱӷʧܣûзϵֽڷ뷢ȴ´η */
+    /* ֱӷʧܣûзϵֽڷ뷢Ͷеȴ´η */
     if (size > bytes) {
-      if ((size - bytes) != (int)ringbuffer_write(channel->send_ringbuffer, data + bytes, size - bytes)) {
-          return error_send_fail;
-      }
-      /* ҪԺ */
-      return error_send_patial;
+        if (error_ok != send_queue_write(channel->send_queue, data + bytes, (uint32_t)(size - bytes))) {
+            return error_send_fail;
+        }
+        /* ҪԺ */
+        return error_send_patial;
     }
     return error_ok;
 }
 
+int knet_channel_sendv(kchannel_t* channel, const kiovec_t* iov, int count) {
+    int i      = 0;
+#if !LOOP_URING
+    int n      = 0;
+    int end    = 0;
+#endif /* !LOOP_URING */
+    int bytes  = 0;
+    int size   = 0;
+    int error  = error_ok;
+    verify(channel);
+    verify(iov);
+    verify(count > 0);
+#if !LOOP_URING
+    if (send_queue_empty(channel->send_queue)) {
+        /* ֱӷ, ÿϵͳSOCKET_IOV_MAXݿ */
+        while (i < count) {
+            n = ((count - i) > SOCKET_IOV_MAX) ? SOCKET_IOV_MAX : (count - i);
+            bytes = socket_sendv(channel->socket_fd, iov + i, n);
+            knet_channel_count_send_calls(channel, 1);
+            if (bytes < 0) {
+                return error_send_fail;
+            }
+            /* Ѿϵݿ, bytesΪδݿѷ͵ĳ */
+            for (end = i + n; (i < end) && (bytes >= iov[i].size); i++) {
+                bytes -= iov[i].size;
+            }
+            if (i < end) {
+                break;
+            }
+        }
+    }
+#endif /* !LOOP_URING */
+    /* ûзϵݷ뷢Ͷеȴ´η */
+    for (; i < count; i++, bytes = 0) {
+        size = iov[i].size - bytes;
+        if (size <= 0) {
+            continue;
+        }
+        if (error_ok != send_queue_write(channel->send_queue, (const char*)iov[i].data + bytes, (uint32_t)size)) {
+            return error_send_fail;
+        }
+        error = error_send_patial;
+    }
+    return error;
+}
+
+int knet_channel_send_owned(kchannel_t* channel, void* data, int size, knet_write_free_cb_t free_cb, void* ctx) {
+    int bytes = 0;
+    int error = error_ok;
+    verify(channel);
+    verify(data);
+    verify(size > 0);
+#if !LOOP_URING
+    if (send_queue_empty(channel->send_queue)) {
+        /* ֱӷ */
+        bytes = socket_send(channel->socket_fd, (const char*)data, size);
+        knet_channel_count_send_calls(channel, 1);
+        if (bytes < 0) {
+            if (free_cb) {
+                free_cb(data, size, ctx);
+            }
+            return error_send_fail;
+        }
+        if (bytes == size) {
+            /* ںѾȫ */
+            if (free_cb) {
+                free_cb(data, size, ctx);
+            }
+            return error_ok;
+        }
+    }
+#endif /* !LOOP_URING */
+    /* ʣݲ, ΪⲿƬȴ´η */
+    error = send_queue_add_slice(channel->send_queue, (char*)data, (uint32_t)size, (uint32_t)bytes, free_cb, ctx);
+    if (error_ok != error) {
+        if (free_cb) {
+            free_cb(data, size, ctx);
+        }
+        return error;
+    }
+    return error_send_patial;
+}
+
 int knet_channel_update_send(kchannel_t* channel) {
     verify(channel);
-    verify(channel->send_ringbuffer);
+    verify(channel->send_queue);
     return knet_channel_send_buffer(channel);
 }
 
 int knet_channel_update_recv(kchannel_t* channel) {
-    int      bytes      = 0; /* socket_recvʵʽյֽ */
+    int      bytes      = 0; /* socket_recvvʵʽյֽ */
     int      recv_bytes = 0; /* յֽ */
-    uint32_t size       = 0; /* ǰдֽ */ 
-    char*    ptr        = 0; /* дʼַ */
+    int      count      = 0; /* д */
+    kiovec_t iov[2];         /* д, ԽĩβʱΪ */
     verify(channel);
     verify(channel->recv_ringbuffer);
-    if (ringbuffer_full(channel->recv_ringbuffer)) {
+    if (channel->recv_shared && channel->recv_scratch &&
+        ringbuffer_empty(channel->recv_ringbuffer) && ringbuffer_empty(channel->recv_scratch)) {
+        /* ûδ, ȡջ */
+        return knet_channel_update_recv_scratch(channel);
+    }
+    if (!channel->recv_limit && ringbuffer_get_max_size(channel->recv_ringbuffer) &&
+        ringbuffer_full(channel->recv_ringbuffer)) {
         /* ر, , ɸС */
         return error_recv_buffer_full;
     }
-    for (; (size = ringbuffer_write_lock_size(channel->recv_ringbuffer));) {
-        ptr   = ringbuffer_write_lock_ptr(channel->recv_ringbuffer);
-        bytes = socket_recv(channel->socket_fd, ptr, size);
+    for (;;) {
+        if (channel->recv_limit && (ringbuffer_available(channel->recv_ringbuffer) >= channel->recv_limit)) {
+            /* ﵽȡ, ʣ׽ֽջ */
+            break;
+        }
+        if (channel->recv_max && ringbuffer_full(channel->recv_ringbuffer) &&
+            (ringbuffer_get_max_size(channel->recv_ringbuffer) >= channel->recv_max)) {
+            /* ﵽ󳤶, ʣ׽ֽջ */
+            break;
+        }
+        /* һϵͳȫдռ, ʱ */
+        count = ringbuffer_write_lock_iov(channel->recv_ringbuffer, iov);
+        knet_channel_account_recv_buffer(channel);
+        bytes = socket_recvv(channel->socket_fd, iov, count);
+        knet_channel_count_recv_calls(channel, 1);
         if (bytes < 0) {
             /* 󣬹ر */
             ringbuffer_write_commit(channel->recv_ringbuffer, 0);
@@ -211,10 +350,13 @@ int knet_channel_update_recv(kchannel_t* channel) {
             /* δյ, ´μ */
             ringbuffer_write_commit(channel->recv_ringbuffer, 0);
             return error_ok;
-        } else {
-            recv_bytes += bytes;
-            /* յ */
-            ringbuffer_write_commit(channel->recv_ringbuffer, (uint32_t)bytes);
+        }
+        recv_bytes += bytes;
+        /* յ */
+        ringbuffer_write_commit(channel->recv_ringbuffer, (uint32_t)bytes);
+        if (bytes < iov[0].size + ((count > 1) ? iov[1].size : 0)) {
+            /* ûдռ, ׽ֽջѿ, ٳ */
+            break;
         }
     }
     if (!recv_bytes) {
@@ -224,6 +366,78 @@ int knet_channel_update_recv(kchannel_t* channel) {
     return error_ok;
 }
 
+int knet_channel_update_recv_scratch(kchannel_t* channel) {
+    int      bytes = 0; /* socket_recvvʵʽյֽ */
+    int      count = 0; /* ջд */
+    kiovec_t iov[2];    /* ջд */
+    verify(channel);
+    count = ringbuffer_write_lock_iov(channel->recv_scratch, iov);
+    bytes = socket_recvv(channel->socket_fd, iov, count);
+    knet_channel_count_recv_calls(channel, 1);
+    if (bytes < 0) {
+        /* 󣬹ر */
+        ringbuffer_write_commit(channel->recv_scratch, 0);
+        return error_recv_fail;
+    }
+    ringbuffer_write_commit(channel->recv_scratch, (uint32_t)bytes);
+    /*
+     * ֻȡһ, ջҪڻص黹, ׽ʣͶݶ¼ȡ
+     */
+    channel->recv_in_scratch = (bytes > 0);
+    return error_ok;
+}
+
+int knet_channel_flush_recv_scratch(kchannel_t* channel) {
+    uint32_t size  = 0;
+    int      error = error_ok;
+    verify(channel);
+    if (channel->recv_in_scratch) {
+        channel->recv_in_scratch = 0;
+        /* صûдݸƵܵԼĶ */
+        for (size = ringbuffer_read_lock_size(channel->recv_scratch);
+            (size);
+            ringbuffer_read_commit(channel->recv_scratch, size), size = ringbuffer_read_lock_size(channel->recv_scratch)) {
+            ringbuffer_write(channel->recv_ringbuffer, ringbuffer_read_lock_ptr(channel->recv_scratch), size);
+        }
+        ringbuffer_read_unlock(channel->recv_scratch);
+        ringbuffer_eat_all(channel->recv_scratch);
+        if (!channel->recv_limit && channel->recv_max &&
+            (ringbuffer_available(channel->recv_ringbuffer) > channel->recv_max)) {
+            error = error_recv_buffer_full;
+        }
+    }
+    if (channel->recv_shared && ringbuffer_empty(channel->recv_ringbuffer) &&
+        ringbuffer_get_max_size(channel->recv_ringbuffer)) {
+        /* ûδ, ͷŶڴ */
+        ringbuffer_shrink(channel->recv_ringbuffer, 0);
+    }
+    knet_channel_account_recv_buffer(channel);
+    return error;
+}
+
+int knet_channel_recv_buffer(kchannel_t* channel, const char* data, int size) {
+    verify(channel);
+    verify(data);
+    verify(size > 0);
+    if (!channel->recv_limit && channel->recv_max &&
+        (ringbuffer_available(channel->recv_ringbuffer) + (uint32_t)size > channel->recv_max)) {
+        /* Ѿ׽ȡ, 󳤶ʱΪ */
+        return error_recv_buffer_full;
+    }
+    if (channel->recv_shared && channel->recv_scratch &&
+        ringbuffer_empty(channel->recv_ringbuffer) && ringbuffer_empty(channel->recv_scratch)) {
+        /* ûδ, 빲ջ */
+        ringbuffer_write(channel->recv_scratch, data, (uint32_t)size);
+        channel->recv_in_scratch = 1;
+        return error_ok;
+    }
+    if (size != (int)ringbuffer_write(channel->recv_ringbuffer, data, (uint32_t)size)) {
+        return error_recv_buffer_full;
+    }
+    knet_channel_account_recv_buffer(channel);
+    return error_ok;
+}
+
 void knet_channel_close(kchannel_t* channel) {
     verify(channel);
     if (0 == channel->socket_fd) {
@@ -240,9 +454,92 @@ socket_t knet_channel_get_socket_fd(kchannel_t* channel) {
 
 kringbuffer_t* knet_channel_get_ringbuffer(kchannel_t* channel) {
     verify(channel);
+    if (channel->recv_in_scratch) {
+        /* صڼֱӶȡջ */
+        return channel->recv_scratch;
+    }
     return channel->recv_ringbuffer;
 }
 
+ksend_queue_t* knet_channel_get_send_queue(kchannel_t* channel) {
+    verify(channel);
+    return channel->send_queue;
+}
+
+void knet_channel_set_send_pool(kchannel_t* channel, ksend_pool_t* pool) {
+    verify(channel);
+    send_queue_set_pool(channel->send_queue, pool);
+}
+
+void knet_channel_set_recv_limit(kchannel_t* channel, uint32_t limit) {
+    verify(channel);
+    channel->recv_limit = limit;
+}
+
+void knet_channel_set_profile(kchannel_t* channel, kloop_profile_t* profile) {
+    verify(channel);
+    /* ռܵǨ */
+    if (channel->profile) {
+        knet_loop_profile_sub_recv_buffer_bytes(channel->profile, channel->recv_capacity);
+    }
+    channel->profile       = profile;
+    channel->recv_capacity = 0;
+    knet_channel_account_recv_buffer(channel);
+}
+
+void knet_channel_set_recv_scratch(kchannel_t* channel, kringbuffer_t* scratch) {
+    verify(channel);
+    channel->recv_scratch = scratch;
+}
+
+void knet_channel_set_recv_shared(kchannel_t* channel, int shared) {
+    verify(channel);
+    channel->recv_shared = shared;
+    if (shared && ringbuffer_empty(channel->recv_ringbuffer)) {
+        /* ڻصûдʱŷ */
+        ringbuffer_shrink(channel->recv_ringbuffer, 0);
+        knet_channel_account_recv_buffer(channel);
+    }
+}
+
+int knet_channel_is_recv_shared(kchannel_t* channel) {
+    verify(channel);
+    return channel->recv_shared;
+}
+
+void knet_channel_set_recv_buffer_max(kchannel_t* channel, uint32_t max_size) {
+    verify(channel);
+    channel->recv_max = max_size;
+}
+
+int knet_channel_shrink_recv_buffer(kchannel_t* channel, uint32_t size) {
+    int error = error_ok;
+    verify(channel);
+    error = ringbuffer_shrink(channel->recv_ringbuffer, size);
+    knet_channel_account_recv_buffer(channel);
+    return error;
+}
+
+void knet_channel_account_recv_buffer(kchannel_t* channel) {
+    uint32_t capacity = 0;
+    verify(channel);
+    capacity = ringbuffer_get_max_size(channel->recv_ringbuffer);
+    if (!channel->profile || (capacity == channel->recv_capacity)) {
+        return;
+    }
+    if (capacity > channel->recv_capacity) {
+        knet_loop_profile_add_recv_buffer_bytes(channel->profile, capacity - channel->recv_capacity);
+    } else {
+        knet_loop_profile_sub_recv_buffer_bytes(channel->profile, channel->recv_capacity - capacity);
+    }
+    channel->recv_capacity = capacity;
+}
+
+uint64_t knet_channel_get_send_pending_bytes(kchannel_t* channel) {
+    verify(channel);
+    return send_queue_get_pending_bytes(channel->send_queue);
+}
+
 uint32_t knet_channel_get_max_send_list_len(kchannel_t* channel) {
   (void)channel;
   return 0;
@@ -258,11 +555,6 @@ uint64_t knet_channel_get_uuid(kchannel_t* channel) {
     return channel->uuid;
 }
 
-int knet_channel_send_buffer_reach_max(kchannel_t* channel) {
-    verify(channel);
-    return ringbuffer_full(channel->send_ringbuffer);
-}
-
 int knet_channel_is_ipv6(kchannel_t* channel) {
     verify(channel);
     return channel->ipv6;
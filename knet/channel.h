@@ -46,6 +46,31 @@ kchannel_t* knet_channel_create(uint32_t max_send_list_len, uint32_t recv_ring_l
  */
 kchannel_t* knet_channel_create_exist_socket_fd(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6);
 
+/**
+ * ȡkchannel_t, ǶķͶкͶ()
+ * @return kchannel_t
+ */
+uint32_t knet_channel_get_object_size();
+
+/**
+ * ڵṩڴϳʼkchannel_tʵ, knet_channel_destroyͷڴ, ׽ѡ
+ * @param channel Ϊknet_channel_get_object_size()ڴ
+ * @param socket_fd ѽ׽
+ * @param max_send_list_len 󳤶
+ * @param recv_ring_len ܻ󳤶
+ * @param ipv6 ǷIPV6
+ * @return kchannel_tʵ
+ */
+kchannel_t* knet_channel_init(kchannel_t* channel, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6);
+
+/**
+ * ׽ΪӦ׽ѡ
+ * @param channel kchannel_tʵ
+ * @param recv_ring_len ܻ󳤶
+ * @param options ׽ѡ, Ϊ0ʱʹĬ
+ */
+void knet_channel_setup_socket(kchannel_t* channel, uint32_t recv_ring_len, const ksocket_options_t* options);
+
 /**
  * kchannel_tʵ
  * @param channel kchannel_tʵ
@@ -91,6 +116,33 @@ void knet_channel_close(kchannel_t* channel);
  */
 int knet_channel_send(kchannel_t* channel, const char* data, int size);
 
+/**
+ * ɢ
+ * ʹһϵͳ÷ȫݿ, ֻδ͵ĲֱƵͶ
+ * @param channel kchannel_tʵ
+ * @param iov ݿ
+ * @param count ݿ
+ * @retval error_ok ɹ
+ * @retval error_send_patial ݵȴ
+ * @retval  ʧ
+ */
+int knet_channel_sendv(kchannel_t* channel, const kiovec_t* iov, int count);
+
+/**
+ * 㿽, Ȩƽܵ
+ * ޷͵ݲᱻ, ΪⲿƬڷͶβȴ, ں˽ȫݻܵʱfree_cb.
+ * ۳ɹfree_cbᱻֻһ
+ * @param channel kchannel_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @param free_cb ͷŻص
+ * @param ctx ͷŻص
+ * @retval error_ok ɹ
+ * @retval error_send_patial ݵȴ
+ * @retval  ʧ
+ */
+int knet_channel_send_owned(kchannel_t* channel, void* data, int size, knet_write_free_cb_t free_cb, void* ctx);
+
 /**
  * 
  * ŵĩβȴʵʱ.
@@ -117,6 +169,16 @@ int knet_channel_update_send(kchannel_t* channel);
  */
 int knet_channel_update_recv(kchannel_t* channel);
 
+/**
+ * ѡȡѾȡд
+ * @param channel kchannel_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int knet_channel_recv_buffer(kchannel_t* channel, const char* data, int size);
+
 /**
  * ȡ׽
  * @param channel kchannel_tʵ
@@ -131,6 +193,106 @@ socket_t knet_channel_get_socket_fd(kchannel_t* channel);
  */
 kringbuffer_t* knet_channel_get_ringbuffer(kchannel_t* channel);
 
+/**
+ * ȡ÷Ͷ
+ * @param channel kchannel_tʵ
+ * @return ksend_queue_tʵ
+ */
+ksend_queue_t* knet_channel_get_send_queue(kchannel_t* channel);
+
+/**
+ * ÷Ͷʹõݿ
+ * @param channel kchannel_tʵ
+ * @param pool ksend_pool_tʵ, ܵkloop_tݿ
+ */
+void knet_channel_set_send_pool(kchannel_t* channel, ksend_pool_t* pool);
+
+/**
+ * ü¼ϵͳôͳ
+ * @param channel kchannel_tʵ
+ * @param profile kloop_profile_tʵ, ܵkloop_tͳ
+ */
+void knet_channel_set_profile(kchannel_t* channel, kloop_profile_t* profile);
+
+/**
+ * öȡ, ɶֽﵽ޺knet_channel_update_recvٶȡ, ҲΪ
+ * @param channel kchannel_tʵ
+ * @param limit ȡ, 0Ϊ
+ */
+void knet_channel_set_recv_limit(kchannel_t* channel, uint32_t limit);
+
+/**
+ * ýջ󳤶, дҳȴﵽ޺knet_channel_update_recv,
+ * ʣ׽ֽջ
+ * @param channel kchannel_tʵ
+ * @param max_size 󳤶, 0Ϊ
+ */
+void knet_channel_set_recv_buffer_max(kchannel_t* channel, uint32_t max_size);
+
+/**
+ * ջ
+ * @param channel kchannel_tʵ
+ * @param size ³, Сڿɶݳ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int knet_channel_shrink_recv_buffer(kchannel_t* channel, uint32_t size);
+
+/**
+ * ùջ
+ * @param channel kchannel_tʵ
+ * @param scratch kringbuffer_tʵ, ܵkloop_tĹջ
+ */
+void knet_channel_set_recv_scratch(kchannel_t* channel, kringbuffer_t* scratch);
+
+/**
+ * ùģʽ
+ *
+ * Ϊʱݶȡջ, صֱӶȡջ,
+ * صknet_channel_flush_recv_scratchûдݸƵ.
+ * Ϊʱͷڴ
+ * @param channel kchannel_tʵ
+ * @param shared 0, 0ر
+ */
+void knet_channel_set_recv_shared(kchannel_t* channel, int shared);
+
+/**
+ * Ƿģʽ
+ * @param channel kchannel_tʵ
+ * @retval 0 ûп
+ * @retval 0 ѿ
+ */
+int knet_channel_is_recv_shared(kchannel_t* channel);
+
+/**
+ * ȡջ, ÿֻһϵͳ
+ * @param channel kchannel_tʵ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int knet_channel_update_recv_scratch(kchannel_t* channel);
+
+/**
+ * ջص, 黹ջ
+ * @param channel kchannel_tʵ
+ * @retval error_ok ɹ
+ * @retval error_recv_buffer_full ûдݳ󳤶
+ */
+int knet_channel_flush_recv_scratch(kchannel_t* channel);
+
+/**
+ * ջȵı仯ͳ
+ * @param channel kchannel_tʵ
+ */
+void knet_channel_account_recv_buffer(kchannel_t* channel);
+
+/**
+ * ȡõȴ͵ֽ
+ * @param channel kchannel_tʵ
+ * @return ȴ͵ֽ
+ */
+uint64_t knet_channel_get_send_pending_bytes(kchannel_t* channel);
+
 /**
  * ȡ÷󳤶
  * @param channel kchannel_tʵ
@@ -152,14 +314,6 @@ uint32_t knet_channel_get_max_recv_buffer_len(kchannel_t* channel);
  */
 uint64_t knet_channel_get_uuid(kchannel_t* channel);
 
-/**
- * ڻǷﵽ
- * @param channel kchannel_tʵ
- * @retval 0 
- * @retval  
- */
-int knet_channel_send_buffer_reach_max(kchannel_t* channel);
-
 /**
  * ǷIPV6
  * @param channel kchannel_tʵ
@@ -34,6 +34,8 @@
 #include "loop_profile.h"
 #include "logger.h"
 #include "timer.h"
+#include "list.h"
+#include "socket_options.h"
 
 /**
  * 管道信息
@@ -47,6 +49,8 @@ typedef struct _channel_ref_info_t {
     kloop_t*                      loop;                 /* 管道所关联的kloop_t */
     kaddress_t*                   peer_address;         /* 对端地址 */
     kaddress_t*                   local_address;        /* 本地地址 */
+    kaddress_t*                   peer_address_slot;    /* 内存块内为对端地址预留的空间 */
+    kaddress_t*                   local_address_slot;   /* 内存块内为本地地址预留的空间 */
     knet_channel_event_e          event;                /* 管道投递事件 */
     volatile knet_channel_state_e state;                /* 管道状态 */
     atomic_counter_t              ref_count;            /* 引用计数 */
@@ -63,10 +67,25 @@ typedef struct _channel_ref_info_t {
     /* 扩展数据成员 */
     /*
      * 调用ktimer_stop将关闭定时器, 定时器将在定时器循环内被销毁, 管道将不清理定时器
+     * 读空闲超时不使用定时器, 管道按最后活跃时间排列在loop的链表内
      */
-    ktimer_t*    recv_timeout_timer;    /* 读空闲超时定时器 */
+    kdlist_node_t* idle_node;           /* 读空闲超时链表节点, 在管道内存块内 */
+    kdlist_t*    idle_list;             /* 所在的loop读空闲超时链表, 0为未开启读空闲超时 */
+    time_t       idle_ts;               /* 读空闲计时起点（秒）, 读到数据或触发超时事件时更新 */
     ktimer_t*    connect_timeout_timer; /* 连接超时定时器 */
     volatile int close_cb_called;       /* 关闭事件是否已经触发过 */
+    uint32_t     recv_high;             /* 接收流量控制高水位, 0为关闭流量控制 */
+    uint32_t     recv_low;              /* 接收流量控制低水位 */
+    int          recv_throttle;         /* 是否已经暂停读取 */
+    uint32_t     send_high;             /* 发送高水位, 0为关闭 */
+    uint32_t     send_low;              /* 发送低水位 */
+    int          send_above;            /* 是否已经达到发送高水位 */
+    uint32_t     recv_init_size;        /* 接收缓冲区初始长度, 0为未设置自适应长度 */
+    uint32_t     recv_max_size;         /* 接收缓冲区最大长度 */
+    int          recv_idle;             /* 接收缓冲区空闲收缩时间(秒) */
+    ktimer_t*    recv_idle_timer;       /* 接收缓冲区空闲定时器 */
+    int          accept_budget;         /* 每次读事件最多接受的连接数, 0为CHANNEL_ACCEPT_BUDGET */
+    const ksocket_options_t* socket_options; /* 套接字选项配置, 由用户管理 */
 } channel_ref_info_t;
 
 /**
@@ -79,6 +98,21 @@ struct _channel_ref_t {
     channel_ref_info_t* ref_info;  /* 管道信息 */
 };
 
+/**
+ * 管道内存块池, 管道可能在非loop线程内建立或销毁, 访问时需要加锁
+ */
+struct _channel_pool_t {
+    klock_t* lock;       /* 锁 */
+    void*    free_list;  /* 空闲内存块链表, 内存块头部保存下一个空闲内存块 */
+    uint32_t free_count; /* 空闲内存块数量 */
+};
+
+/**
+ * 内存块内对象按指针长度的两倍对齐
+ */
+#define knet_channel_ref_align(size) \
+    (((size) + sizeof(void*) * 2 - 1) & ~(sizeof(void*) * 2 - 1))
+
 /**
  * 管道定时器回调
  * @param timer 管道定时器
@@ -86,19 +120,120 @@ struct _channel_ref_t {
  */
 void timer_cb(ktimer_t* timer, void* data);
 
-kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, kchannel_t* channel) {
-    kchannel_ref_t* channel_ref = knet_create(kchannel_ref_t);
-    verify(channel_ref);
+kchannel_pool_t* knet_channel_pool_create() {
+    kchannel_pool_t* pool = knet_create(kchannel_pool_t);
+    verify(pool);
+    memset(pool, 0, sizeof(kchannel_pool_t));
+    pool->lock = lock_create();
+    verify(pool->lock);
+    return pool;
+}
+
+void knet_channel_pool_destroy(kchannel_pool_t* pool) {
+    void* block = 0;
+    verify(pool);
+    while (pool->free_list) {
+        block = pool->free_list;
+        pool->free_list = *(void**)block;
+        knet_free(block);
+    }
+    lock_destroy(pool->lock);
+    knet_free(pool);
+}
+
+uint32_t knet_channel_pool_get_free_count(kchannel_pool_t* pool) {
+    verify(pool);
+    return pool->free_count;
+}
+
+void* knet_channel_pool_alloc(kchannel_pool_t* pool) {
+    void* block = 0;
+    verify(pool);
+    lock_lock(pool->lock);
+    if (pool->free_list) {
+        block = pool->free_list;
+        pool->free_list = *(void**)block;
+        pool->free_count--;
+    }
+    lock_unlock(pool->lock);
+    if (!block) {
+        block = knet_malloc(knet_channel_ref_get_block_size());
+    }
+    return block;
+}
+
+void knet_channel_pool_free(kchannel_pool_t* pool, void* block) {
+    verify(pool);
+    verify(block);
+    lock_lock(pool->lock);
+    if (pool->free_count < CHANNEL_POOL_MAX) {
+        /* 回收到内存块池 */
+        *(void**)block = pool->free_list;
+        pool->free_list = block;
+        pool->free_count++;
+        block = 0;
+    }
+    lock_unlock(pool->lock);
+    if (block) {
+        knet_free(block);
+    }
+}
+
+uint32_t knet_channel_ref_get_block_size() {
+    return (uint32_t)(knet_channel_ref_align(sizeof(kchannel_ref_t)) +
+        knet_channel_ref_align(sizeof(channel_ref_info_t)) +
+        knet_channel_ref_align(dlist_node_get_object_size()) * 2 +
+        knet_channel_ref_align(stream_get_object_size()) +
+        knet_channel_ref_align(knet_address_get_object_size()) * 2 +
+        knet_channel_get_object_size());
+}
+
+kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6,
+    const ksocket_options_t* options, int inherit) {
+    kchannel_ref_t* channel_ref = 0;
+    kchannel_t*     channel     = 0;
+    kdlist_node_t*  loop_node   = 0;
+    char*           ptr         = 0;
+    verify(loop);
+    /* 管道引用, 管道信息, 链表节点(两个), 数据流, 地址, 管道在同一个内存块内 */
+    ptr = (char*)knet_channel_pool_alloc(knet_loop_get_channel_pool(loop));
+    verify(ptr);
+    channel_ref = (kchannel_ref_t*)ptr;
     memset(channel_ref, 0, sizeof(kchannel_ref_t));
-    channel_ref->ref_info = knet_create(channel_ref_info_t);
-    verify(channel_ref->ref_info);
+    ptr += knet_channel_ref_align(sizeof(kchannel_ref_t));
+    channel_ref->ref_info = (channel_ref_info_t*)ptr;
     memset(channel_ref->ref_info, 0, sizeof(channel_ref_info_t));
-    channel_ref->ref_info->stream = stream_create(channel_ref);
+    ptr += knet_channel_ref_align(sizeof(channel_ref_info_t));
+    loop_node = dlist_node_init((kdlist_node_t*)ptr);
+    dlist_node_set_data(loop_node, channel_ref);
+    channel_ref->ref_info->loop_node = loop_node;
+    ptr += knet_channel_ref_align(dlist_node_get_object_size());
+    channel_ref->ref_info->idle_node = dlist_node_set_data(dlist_node_init((kdlist_node_t*)ptr), channel_ref);
+    ptr += knet_channel_ref_align(dlist_node_get_object_size());
+    channel_ref->ref_info->stream = stream_init((kstream_t*)ptr, channel_ref);
     verify(channel_ref->ref_info->stream);
+    ptr += knet_channel_ref_align(stream_get_object_size());
+    /* 地址在第一次使用时初始化 */
+    channel_ref->ref_info->peer_address_slot = (kaddress_t*)ptr;
+    ptr += knet_channel_ref_align(knet_address_get_object_size());
+    channel_ref->ref_info->local_address_slot = (kaddress_t*)ptr;
+    ptr += knet_channel_ref_align(knet_address_get_object_size());
+    channel = knet_channel_init((kchannel_t*)ptr, socket_fd, max_send_list_len, recv_ring_len, ipv6);
+    verify(channel);
+    if (inherit) {
+        knet_socket_options_apply_accepted(options, socket_fd);
+    } else {
+        knet_channel_setup_socket(channel, recv_ring_len, options);
+    }
+    channel_ref->ref_info->socket_options = options;
     channel_ref->ref_info->channel      = channel;
     channel_ref->ref_info->ref_count    = 0;
     channel_ref->ref_info->loop         = loop;
     channel_ref->ref_info->last_recv_ts = time(0);
+    /* 发送队列使用loop的数据块池, 系统调用次数计入loop的统计 */
+    knet_channel_set_send_pool(channel, knet_loop_get_send_pool(loop));
+    knet_channel_set_profile(channel, knet_loop_get_profile(loop));
+    knet_channel_set_recv_scratch(channel, knet_loop_get_recv_scratch(loop));
     channel_ref->ref_info->state        = channel_state_init;
     /* 记录统计数据 */
     knet_loop_profile_increase_active_channel_count(knet_loop_get_profile(loop));
@@ -107,44 +242,42 @@ kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, kchannel_t* channel) {
 
 int knet_channel_ref_destroy(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
-    if (channel_ref->ref_info) {        
-        if (channel_ref->ref_info->state == channel_state_init) {
-            /* 未被加入到链表内 */
-            knet_channel_close(channel_ref->ref_info->channel);
-        }
-        /* 检测引用计数 */
-        if (!atomic_counter_zero(&channel_ref->ref_info->ref_count)) {
-            return error_ref_nonzero;
-        }
-        /* 销毁对端地址 */
-        if (channel_ref->ref_info->peer_address) {
-            knet_address_destroy(channel_ref->ref_info->peer_address);
-        }
-        /* 销毁本地地址 */
-        if (channel_ref->ref_info->local_address) {
-            knet_address_destroy(channel_ref->ref_info->local_address);
-        }
-        /* 通知选取器删除管道相关资源 */
-        if ((channel_ref->ref_info->state != channel_state_init) && /* 已经被加入到loop管道链表 */
-            channel_ref->ref_info->loop) {
-            knet_impl_remove_channel_ref(channel_ref->ref_info->loop, channel_ref);
-        }
-        /* 销毁管道 */
-        if (channel_ref->ref_info->channel) {
-            knet_channel_destroy(channel_ref->ref_info->channel);
-        }
-        /* 销毁数据流 */
-        if (channel_ref->ref_info->stream) {
-            stream_destroy(channel_ref->ref_info->stream);
-        }
-        /* 销毁定时器 */
-        knet_channel_ref_stop_connect_timeout_timer(channel_ref);
-        knet_channel_ref_stop_recv_timeout_timer(channel_ref);
-        /* 销毁管道信息 */
-        knet_free(channel_ref->ref_info);
+    verify(channel_ref->ref_info);
+    if (channel_ref->ref_info->state == channel_state_init) {
+        /* 未被加入到链表内 */
+        knet_channel_close(channel_ref->ref_info->channel);
     }
-    /* 销毁管道引用 */
-    knet_free(channel_ref);
+    /* 检测引用计数 */
+    if (!atomic_counter_zero(&channel_ref->ref_info->ref_count)) {
+        return error_ref_nonzero;
+    }
+    /* 销毁对端地址 */
+    if (channel_ref->ref_info->peer_address) {
+        knet_address_destroy(channel_ref->ref_info->peer_address);
+    }
+    /* 销毁本地地址 */
+    if (channel_ref->ref_info->local_address) {
+        knet_address_destroy(channel_ref->ref_info->local_address);
+    }
+    /* 通知选取器删除管道相关资源 */
+    if ((channel_ref->ref_info->state != channel_state_init) && /* 已经被加入到loop管道链表 */
+        channel_ref->ref_info->loop) {
+        knet_impl_remove_channel_ref(channel_ref->ref_info->loop, channel_ref);
+    }
+    /* 销毁管道 */
+    if (channel_ref->ref_info->channel) {
+        knet_channel_destroy(channel_ref->ref_info->channel);
+    }
+    /* 销毁数据流 */
+    if (channel_ref->ref_info->stream) {
+        stream_destroy(channel_ref->ref_info->stream);
+    }
+    /* 销毁定时器 */
+    knet_channel_ref_stop_connect_timeout_timer(channel_ref);
+    knet_channel_ref_stop_recv_timeout(channel_ref);
+    knet_channel_ref_stop_recv_idle_timer(channel_ref);
+    /* 管道信息等与管道引用在同一个内存块内, 回收到loop的内存块池 */
+    knet_channel_pool_free(knet_loop_get_channel_pool(channel_ref->ref_info->loop), channel_ref);
     return error_ok;
 }
 
@@ -166,11 +299,8 @@ int knet_channel_ref_connect(kchannel_ref_t* channel_ref, const char* ip, int po
     }
     if (!channel_ref->ref_info->peer_address) {
         /* 建立对端地址对象 */
-        if (knet_channel_is_ipv6(channel_ref->ref_info->channel)) {
-            channel_ref->ref_info->peer_address = knet_address_create6();
-        } else {
-            channel_ref->ref_info->peer_address = knet_address_create();
-        }
+        channel_ref->ref_info->peer_address = knet_address_init(channel_ref->ref_info->peer_address_slot,
+            knet_channel_is_ipv6(channel_ref->ref_info->channel));
     }
     /* 设置对端地址 */
     knet_address_set(channel_ref->ref_info->peer_address, ip, port);
@@ -193,6 +323,9 @@ int knet_channel_ref_connect(kchannel_ref_t* channel_ref, const char* ip, int po
             knet_loop_get_profile(channel_ref->ref_info->loop));
         /* 设置目标loop */
         channel_ref->ref_info->loop = loop;
+        knet_channel_set_send_pool(channel_ref->ref_info->channel, knet_loop_get_send_pool(loop));
+        knet_channel_set_profile(channel_ref->ref_info->channel, knet_loop_get_profile(loop));
+        knet_channel_set_recv_scratch(channel_ref->ref_info->channel, knet_loop_get_recv_scratch(loop));
         /* 增加目标loop的active管道数量 */
         knet_loop_profile_increase_active_channel_count(knet_loop_get_profile(loop));
         /* 添加到其他loop */
@@ -228,6 +361,9 @@ int knet_channel_ref_reconnect(kchannel_ref_t* channel_ref, int timeout) {
     loop                = knet_channel_ref_get_loop(channel_ref);
     max_send_list_len   = knet_channel_get_max_send_list_len(channel_ref->ref_info->channel);
     max_recv_buffer_len = knet_channel_get_max_recv_buffer_len(channel_ref->ref_info->channel);
+    if (!max_recv_buffer_len) {
+        max_recv_buffer_len = 16 * 1024; /* 共享接收模式下接收缓冲区已经释放, 默认16K */
+    }
     cb                  = knet_channel_ref_get_cb(channel_ref);
     user_data           = knet_channel_ref_get_user_data(channel_ref);
     ptr                 = knet_channel_ref_get_ptr(channel_ref);
@@ -238,11 +374,18 @@ int knet_channel_ref_reconnect(kchannel_ref_t* channel_ref, int timeout) {
     port = address_get_port(peer_address);
     /* 建立新管道 */
     if (knet_channel_is_ipv6(channel_ref->ref_info->channel)) {
-        new_channel = knet_loop_create_channel6(loop, max_send_list_len, max_recv_buffer_len);
+        new_channel = knet_loop_create_channel6_with_options(loop, max_send_list_len, max_recv_buffer_len,
+            channel_ref->ref_info->socket_options);
     } else {
-        new_channel = knet_loop_create_channel(loop, max_send_list_len, max_recv_buffer_len);
+        new_channel = knet_loop_create_channel_with_options(loop, max_send_list_len, max_recv_buffer_len,
+            channel_ref->ref_info->socket_options);
     }
     verify(new_channel);
+    /* 保留接收缓冲区模式 */
+    if (ringbuffer_is_mirror(knet_channel_ref_get_ringbuffer(channel_ref))) {
+        knet_channel_ref_set_recv_mirror(new_channel);
+    }
+    knet_channel_ref_set_recv_shared(new_channel, knet_channel_is_recv_shared(channel_ref->ref_info->channel));
     if (timeout > 0) {
         /* 设置新的超时时间戳 */
         connect_timeout = timeout;
@@ -260,6 +403,16 @@ int knet_channel_ref_reconnect(kchannel_ref_t* channel_ref, int timeout) {
     knet_channel_ref_set_ptr(new_channel, ptr);
     /* 设置自动重连标志 */
     knet_channel_ref_set_auto_reconnect(new_channel, auto_reconnect);
+    /* 保留接收流量控制和发送水位 */
+    knet_channel_ref_set_recv_watermark(new_channel, channel_ref->ref_info->recv_high,
+        channel_ref->ref_info->recv_low);
+    knet_channel_ref_set_send_watermark(new_channel, channel_ref->ref_info->send_high,
+        channel_ref->ref_info->send_low);
+    /* 保留接收缓冲区自适应长度 */
+    if (channel_ref->ref_info->recv_init_size) {
+        knet_channel_ref_set_recv_buffer_adaptive(new_channel, channel_ref->ref_info->recv_init_size,
+            channel_ref->ref_info->recv_max_size, channel_ref->ref_info->recv_idle);
+    }
     /* 销毁连接超时定时器 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
     /* 启动新的连接器 */
@@ -304,6 +457,9 @@ int knet_channel_ref_accept(kchannel_ref_t* channel_ref, const char* ip, int por
         /* 已经处于监听状态 */
         return error_accept_in_progress;
     }
+    /* 只对监听套接字有效的选项需要在listen()之前设置 */
+    knet_socket_options_apply_listener(channel_ref->ref_info->socket_options,
+        knet_channel_get_socket_fd(channel_ref->ref_info->channel));
     /* 监听 */
     error = knet_channel_accept(channel_ref->ref_info->channel, ip, port, backlog);
     if (error == error_ok) {
@@ -359,8 +515,10 @@ void knet_channel_ref_update_close_in_loop(kloop_t* loop, kchannel_ref_t* channe
     knet_channel_ref_clear_event(channel_ref, channel_event_recv | channel_event_send);
     /* 关闭管道引用 */
     knet_loop_close_channel_ref(channel_ref->ref_info->loop, channel_ref);
-    /* 销毁接收超时定时器 */
-    knet_channel_ref_stop_recv_timeout_timer(channel_ref);
+    /* 停止读空闲超时检测 */
+    knet_channel_ref_stop_recv_timeout(channel_ref);
+    /* 销毁接收缓冲区空闲定时器 */
+    knet_channel_ref_stop_recv_idle_timer(channel_ref);
     /* 销毁连接超时定时器 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
 }
@@ -412,19 +570,25 @@ int knet_channel_ref_check_close(kchannel_ref_t* channel_ref) {
 }
 
 void knet_channel_ref_update_send_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer) {
+    verify(send_buffer);
+    knet_channel_ref_update_send_data_in_loop(loop, channel_ref, knet_buffer_get_ptr(send_buffer),
+        knet_buffer_get_length(send_buffer));
+}
+
+void knet_channel_ref_update_send_data_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, const char* data, int size) {
     int error = 0;
     verify(loop);
     verify(channel_ref);
-    verify(send_buffer);
+    verify(data);
     /* 记录统计数据 */
-    knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), knet_buffer_get_length(send_buffer));
+    knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), size);
     /* 处理发送 */
-    error = knet_channel_send(channel_ref->ref_info->channel, knet_buffer_get_ptr(send_buffer),
-        knet_buffer_get_length(send_buffer));
+    error = knet_channel_send(channel_ref->ref_info->channel, data, size);
     switch (error) {
     case error_send_patial: /* 部分发送成功 */
         /* 继续投递写事件 */
         knet_channel_ref_set_event(channel_ref, channel_event_send);
+        knet_channel_ref_check_send_watermark(channel_ref);
         break;
     case error_send_fail: /* 发送失败 */
         knet_channel_ref_close_check_reconnect(channel_ref);
@@ -434,6 +598,124 @@ void knet_channel_ref_update_send_in_loop(kloop_t* loop, kchannel_ref_t* channel
     }
 }
 
+void knet_channel_ref_update_send_owned_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, void* data, int size,
+    knet_write_free_cb_t free_cb, void* ctx) {
+    int error = 0;
+    verify(loop);
+    verify(channel_ref);
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        /* 跨线程事件到达前管道已关闭 */
+        free_cb(data, size, ctx);
+        return;
+    }
+    /* 记录统计数据 */
+    knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), size);
+    /* 处理发送 */
+    error = knet_channel_send_owned(channel_ref->ref_info->channel, data, size, free_cb, ctx);
+    switch (error) {
+    case error_send_patial: /* 部分发送成功 */
+        /* 继续投递写事件 */
+        knet_channel_ref_set_event(channel_ref, channel_event_send);
+        knet_channel_ref_check_send_watermark(channel_ref);
+        break;
+    case error_send_fail: /* 发送失败 */
+        knet_channel_ref_close_check_reconnect(channel_ref);
+        break;
+    default:
+        break;
+    }
+}
+
+int knet_channel_ref_write_owned(kchannel_ref_t* channel_ref, void* data, int size, knet_write_free_cb_t free_cb, void* ctx) {
+    kloop_t* loop  = 0;
+    int      error = error_ok;
+    verify(channel_ref);
+    verify(data);
+    verify(size);
+    verify(free_cb);
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        free_cb(data, size, ctx);
+        return error_not_connected;
+    }
+    loop = channel_ref->ref_info->loop;
+    if (knet_loop_get_thread_id(loop) != thread_get_self_id()) {
+        /* 转到loop所在线程发送, 数据不复制 */
+        knet_loop_notify_send_owned(loop, channel_ref, data, size, free_cb, ctx);
+    } else {
+        knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), size);
+        /* 当前线程发送 */
+        error = knet_channel_send_owned(channel_ref->ref_info->channel, data, size, free_cb, ctx);
+        switch (error) {
+        case error_send_patial:
+            knet_channel_ref_set_event(channel_ref, channel_event_send);
+            knet_channel_ref_check_send_watermark(channel_ref);
+            /* 对于调用者不是错误 */
+            error = error_ok;
+            break;
+        case error_send_fail: /* 发送失败 */
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            break;
+        default:
+            break;
+        }
+    }
+    return error;
+}
+
+int knet_channel_ref_writev(kchannel_ref_t* channel_ref, const kiovec_t* iov, int count) {
+    kloop_t*   loop        = 0;
+    kbuffer_t* send_buffer = 0;
+    int        error       = error_ok;
+    int        size        = 0;
+    int        i           = 0;
+    verify(channel_ref);
+    verify(iov);
+    verify(count > 0);
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return error_not_connected;
+    }
+    for (i = 0; i < count; i++) {
+        size += iov[i].size;
+    }
+    if (!size) {
+        return error_ok;
+    }
+    loop = channel_ref->ref_info->loop;
+    if (knet_loop_get_thread_id(loop) != thread_get_self_id()) {
+        /* 转到loop所在线程发送, 所有数据块打包到一个缓冲区 */
+        send_buffer = knet_buffer_create(size);
+        verify(send_buffer);
+        if (!send_buffer) {
+            return error_no_memory;
+        }
+        for (i = 0; i < count; i++) {
+            if (iov[i].size > 0) {
+                knet_buffer_put(send_buffer, (const char*)iov[i].data, iov[i].size);
+            }
+        }
+        /* 通知目标线程 */
+        knet_loop_notify_send(loop, channel_ref, send_buffer);
+    } else {
+        knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), size);
+        /* 当前线程发送 */
+        error = knet_channel_sendv(channel_ref->ref_info->channel, iov, count);
+        switch (error) {
+        case error_send_patial:
+            knet_channel_ref_set_event(channel_ref, channel_event_send);
+            knet_channel_ref_check_send_watermark(channel_ref);
+            /* 对于调用者不是错误 */
+            error = error_ok;
+            break;
+        case error_send_fail: /* 发送失败 */
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            break;
+        default:
+            break;
+        }
+    }
+    return error;
+}
+
 int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int size) {
     kloop_t*   loop        = 0;
     kbuffer_t* send_buffer = 0;
@@ -464,6 +746,7 @@ int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int si
         switch (error) {
         case error_send_patial:
             knet_channel_ref_set_event(channel_ref, channel_event_send);
+            knet_channel_ref_check_send_watermark(channel_ref);
             /* 对于调用者不是错误 */
             error = error_ok;
             break;
@@ -534,11 +817,10 @@ int knet_channel_ref_check_event(kchannel_ref_t* channel_ref, knet_channel_event
     return (channel_ref->ref_info->event & event);
 }
 
-kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd, int event, int ipv6) {
+kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd, int event, int ipv6, const struct sockaddr* sa) {
     kchannel_t*     acceptor_channel    = 0; /* 监听管道 */
     uint32_t        max_send_list_len   = 0; /* 最大发送链表长度 */
     uint32_t        max_ringbuffer_size = 0; /* 最大接受缓冲区长度 */
-    kchannel_t*     client_channel      = 0; /* 客户端管道 */
     kchannel_ref_t* client_ref          = 0; /* 客户端管道引用 */
     verify(channel_ref);
     verify(channel_ref->ref_info);
@@ -553,12 +835,30 @@ kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_r
     if (!max_ringbuffer_size) {
         max_ringbuffer_size = 16 * 1024; /* 默认16K */
     }
-    /* 建立客户端管道 */
-    client_channel = knet_channel_create_exist_socket_fd(client_fd, max_send_list_len, max_ringbuffer_size, ipv6);
-    verify(client_channel);
-    /* 建立管道引用 */
-    client_ref = knet_channel_ref_create(loop, client_channel);
+    /* 建立客户端管道引用, 接受时已经取得对端地址的套接字继承了监听套接字的选项 */
+    client_ref = knet_channel_ref_create(loop, client_fd, max_send_list_len, max_ringbuffer_size, ipv6,
+        channel_ref->ref_info->socket_options, sa != 0);
     verify(client_ref);
+    if (sa) {
+        /* 不需要再调用getpeername */
+        client_ref->ref_info->peer_address = knet_address_init(client_ref->ref_info->peer_address_slot, ipv6);
+        knet_address_set_sockaddr(client_ref->ref_info->peer_address, sa);
+    }
+    /* 继承监听器的接收缓冲区模式 */
+    if (ringbuffer_is_mirror(knet_channel_get_ringbuffer(acceptor_channel))) {
+        knet_channel_ref_set_recv_mirror(client_ref);
+    }
+    knet_channel_ref_set_recv_shared(client_ref, knet_channel_is_recv_shared(acceptor_channel));
+    /* 继承监听器的接收流量控制和发送水位 */
+    knet_channel_ref_set_recv_watermark(client_ref, channel_ref->ref_info->recv_high,
+        channel_ref->ref_info->recv_low);
+    knet_channel_ref_set_send_watermark(client_ref, channel_ref->ref_info->send_high,
+        channel_ref->ref_info->send_low);
+    /* 继承监听器的接收缓冲区自适应长度 */
+    if (channel_ref->ref_info->recv_init_size) {
+        knet_channel_ref_set_recv_buffer_adaptive(client_ref, channel_ref->ref_info->recv_init_size,
+            channel_ref->ref_info->recv_max_size, channel_ref->ref_info->recv_idle);
+    }
     if (event) {
         /* 添加到当前线程loop */
         knet_loop_add_channel_ref(channel_ref->ref_info->loop, client_ref);
@@ -570,55 +870,74 @@ kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_r
 }
 
 void knet_channel_ref_update_accept(kchannel_ref_t* channel_ref) {
-    kchannel_ref_t* client_ref = 0;
-    kloop_t*        loop       = 0;
-    socket_t        client_fd  = 0;
-    int             ipv6 = knet_channel_is_ipv6(channel_ref->ref_info->channel);
+    socket_t                client_fd = 0;
+    int                     budget    = 0;
+    int                     count     = 0;
+    socket_len_t            len       = 0;
+    struct sockaddr_storage sa;
     verify(channel_ref);
-    /* 查看选取器是否有自定义实现 */
+    /* 查看选取器是否有自定义实现, 每个完成事件对应一个连接 */
     client_fd = knet_impl_channel_accept(channel_ref);
-    if (!client_fd) {
-        /* 默认实现 */
-        if (knet_channel_is_ipv6(channel_ref->ref_info->channel)) {
-            client_fd = socket_accept6(knet_channel_get_socket_fd(channel_ref->ref_info->channel));
-        } else {
-            client_fd = socket_accept(knet_channel_get_socket_fd(channel_ref->ref_info->channel));
+    if (client_fd > 0) {
+        knet_channel_ref_accept_client(channel_ref, client_fd, 0);
+    } else if (!client_fd) {
+        /* 默认实现, 边沿触发下一次读事件内接受所有等待的连接, 超过上限的留到下一次循环 */
+        budget = channel_ref->ref_info->accept_budget ? channel_ref->ref_info->accept_budget : CHANNEL_ACCEPT_BUDGET;
+        for (count = 0; (count < budget) && knet_channel_ref_check_state(channel_ref, channel_state_accept); count++) {
+            len = sizeof(sa);
+            client_fd = socket_accept_nonblock(knet_channel_get_socket_fd(channel_ref->ref_info->channel),
+                (struct sockaddr*)&sa, &len);
+            if (client_fd <= 0) {
+                break;
+            }
+            knet_channel_ref_accept_client(channel_ref, client_fd, (struct sockaddr*)&sa);
         }
-    }
-    if (client_fd <= 0) {
+        if (!count) {
+            return;
+        }
+    } else {
         return;
     }
-    knet_channel_ref_set_state(channel_ref, channel_state_accept);
-    knet_channel_ref_set_event(channel_ref, channel_event_recv);
-    if (client_fd) {
-        loop = knet_channel_ref_choose_loop(channel_ref);
-        if (loop) {
-            client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, loop, client_fd, 0, ipv6);
-            verify(client_ref);
-            knet_channel_ref_set_user_data(client_ref, channel_ref->ref_info->user_data);
-            knet_channel_ref_set_ptr(client_ref, channel_ref->ref_info->user_ptr);
-            /* 设置回调 */
-            knet_channel_ref_set_cb(client_ref, channel_ref->ref_info->cb);
-            /* 设置读空闲超时 */
-            knet_channel_ref_set_timeout(client_ref, (int)channel_ref->ref_info->timeout);
-            /* 添加到其他loop */
-            knet_loop_notify_accept(loop, client_ref);
-        } else {
-            client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, channel_ref->ref_info->loop, client_fd, 1, ipv6);
-            verify(client_ref);
-            knet_channel_ref_set_user_data(client_ref, channel_ref->ref_info->user_data);
-            knet_channel_ref_set_ptr(client_ref, channel_ref->ref_info->user_ptr);
-            /* 设置回调 */
-            knet_channel_ref_set_cb(client_ref, channel_ref->ref_info->cb);
-            /* 设置读空闲超时 */
-            knet_channel_ref_set_timeout(client_ref, (int)channel_ref->ref_info->timeout);
-            /* 调用回调 */
-            if (channel_ref->ref_info->cb) {
-                channel_ref->ref_info->cb(client_ref, channel_cb_event_accept);
-            }
-            /* 建立接收超时定时器 */
-            knet_channel_ref_start_recv_timeout_timer(client_ref);
+    /* 重新投递读事件, 达到上限时还有等待的连接会再次触发, 回调内可能已经关闭了监听管道 */
+    if (knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+        knet_channel_ref_set_event(channel_ref, channel_event_recv);
+    }
+}
+
+void knet_channel_ref_accept_client(kchannel_ref_t* channel_ref, socket_t client_fd, const struct sockaddr* sa) {
+    kchannel_ref_t* client_ref = 0;
+    kloop_t*        loop       = 0;
+    int             ipv6 = knet_channel_is_ipv6(channel_ref->ref_info->channel);
+    verify(channel_ref);
+    verify(client_fd > 0);
+    loop = knet_channel_ref_choose_loop(channel_ref);
+    if (loop) {
+        client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, loop, client_fd, 0, ipv6, sa);
+        verify(client_ref);
+        knet_channel_ref_set_user_data(client_ref, channel_ref->ref_info->user_data);
+        knet_channel_ref_set_ptr(client_ref, channel_ref->ref_info->user_ptr);
+        /* 设置回调 */
+        knet_channel_ref_set_cb(client_ref, channel_ref->ref_info->cb);
+        /* 设置读空闲超时 */
+        knet_channel_ref_set_timeout(client_ref, (int)channel_ref->ref_info->timeout);
+        /* 添加到其他loop */
+        knet_loop_notify_accept(loop, client_ref);
+    } else {
+        client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, channel_ref->ref_info->loop, client_fd, 1, ipv6, sa);
+        verify(client_ref);
+        knet_channel_ref_set_user_data(client_ref, channel_ref->ref_info->user_data);
+        knet_channel_ref_set_ptr(client_ref, channel_ref->ref_info->user_ptr);
+        /* 设置回调 */
+        knet_channel_ref_set_cb(client_ref, channel_ref->ref_info->cb);
+        /* 设置读空闲超时 */
+        knet_channel_ref_set_timeout(client_ref, (int)channel_ref->ref_info->timeout);
+        /* 调用回调 */
+        if (channel_ref->ref_info->cb) {
+            channel_ref->ref_info->cb(client_ref, channel_cb_event_accept);
         }
+        /* 开启读空闲超时检测 */
+        knet_channel_ref_start_recv_timeout(client_ref);
+        knet_channel_ref_start_recv_idle_timer(client_ref);
     }
 }
 
@@ -641,34 +960,118 @@ int knet_channel_ref_start_connect_timeout_timer(kchannel_ref_t* channel_ref) {
     return error;
 }
 
-int knet_channel_ref_start_recv_timeout_timer(kchannel_ref_t* channel_ref) {
+int knet_channel_ref_start_recv_timeout(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    knet_channel_ref_stop_recv_timeout(channel_ref);
+    if (!channel_ref->ref_info->timeout) {
+        return error_ok;
+    }
+    /* 相同超时的管道在同一个链表内, 新加入的管道最后到期 */
+    channel_ref->ref_info->idle_list = knet_loop_get_idle_list(channel_ref->ref_info->loop,
+        channel_ref->ref_info->timeout);
+    if (!channel_ref->ref_info->idle_list) {
+        return error_no_memory;
+    }
+    channel_ref->ref_info->idle_ts = time(0);
+    dlist_add_tail(channel_ref->ref_info->idle_list, channel_ref->ref_info->idle_node);
+    return error_ok;
+}
+
+void knet_channel_ref_stop_recv_timeout(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    if (channel_ref->ref_info->idle_list) {
+        dlist_remove(channel_ref->ref_info->idle_list, channel_ref->ref_info->idle_node);
+        channel_ref->ref_info->idle_list = 0;
+    }
+}
+
+void knet_channel_ref_update_recv_timeout(kchannel_ref_t* channel_ref, time_t ts) {
+    kdlist_t* list = 0;
+    verify(channel_ref);
+    list = channel_ref->ref_info->idle_list;
+    if (!list) {
+        return;
+    }
+    channel_ref->ref_info->idle_ts = ts;
+    if (dlist_get_back(list) != channel_ref->ref_info->idle_node) {
+        /* 移到链表尾部, 链表保持按计时起点排序 */
+        dlist_remove(list, channel_ref->ref_info->idle_node);
+        dlist_add_tail(list, channel_ref->ref_info->idle_node);
+    }
+}
+
+int knet_channel_ref_check_recv_timeout(kdlist_t* list, time_t timeout, time_t ts) {
+    kdlist_node_t*  node        = 0;
+    kchannel_ref_t* channel_ref = 0;
+    int             count       = 0;
+    verify(list);
+    /* 只处理头部已经超时的管道, 其后的管道计时起点更晚 */
+    while ((node = dlist_get_front(list))) {
+        channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
+        if (ts - channel_ref->ref_info->idle_ts <= timeout) {
+            break;
+        }
+        /* 重新计时, 持续空闲时每隔timeout秒触发一次 */
+        knet_channel_ref_update_recv_timeout(channel_ref, ts);
+        count += 1;
+        if (channel_ref->ref_info->cb) {
+            /* 读超时，心跳; 回调内可以关闭管道 */
+            channel_ref->ref_info->cb(channel_ref, channel_cb_event_timeout);
+        }
+    }
+    return count;
+}
+
+time_t knet_channel_ref_get_recv_timeout_ts(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->idle_ts;
+}
+
+int knet_channel_ref_start_recv_idle_timer(kchannel_ref_t* channel_ref) {
     int       error      = error_ok;
-    ktimer_t* recv_timer = 0;
+    ktimer_t* idle_timer = 0;
     verify(channel_ref);
     /* 销毁 */
-    knet_channel_ref_stop_recv_timeout_timer(channel_ref);
+    knet_channel_ref_stop_recv_idle_timer(channel_ref);
     /* 建立新的 */
-    if (channel_ref->ref_info->timeout) {
-        /* 建立定时器 */
-        recv_timer = ktimer_create(knet_loop_get_timer_loop(channel_ref->ref_info->loop));
-        verify(recv_timer);
-        /* 启动定时器 */
-        error = ktimer_start(recv_timer, knet_channel_ref_get_timer_cb(channel_ref),
-            channel_ref, channel_ref->ref_info->timeout * 1000);
+    if (channel_ref->ref_info->recv_idle) {
+        idle_timer = ktimer_create(knet_loop_get_timer_loop(channel_ref->ref_info->loop));
+        verify(idle_timer);
+        /* 收缩不需要准时, 所有管道的检查对齐到秒 */
+        ktimer_set_slack(idle_timer, 1000);
+        error = ktimer_start(idle_timer, knet_channel_ref_get_timer_cb(channel_ref),
+            channel_ref, channel_ref->ref_info->recv_idle * 1000);
         if (error == error_ok) {
-            channel_ref->ref_info->recv_timeout_timer = recv_timer;
+            channel_ref->ref_info->recv_idle_timer = idle_timer;
         }
     }
     return error;
 }
 
-void knet_channel_ref_stop_recv_timeout_timer(kchannel_ref_t* channel_ref) {
+void knet_channel_ref_stop_recv_idle_timer(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
-    if (channel_ref->ref_info->recv_timeout_timer) {
+    if (channel_ref->ref_info->recv_idle_timer) {
         /* 停止定时器 */
-        ktimer_stop(channel_ref->ref_info->recv_timeout_timer);
+        ktimer_stop(channel_ref->ref_info->recv_idle_timer);
         /* 置零 */
-        channel_ref->ref_info->recv_timeout_timer = 0;
+        channel_ref->ref_info->recv_idle_timer = 0;
+    }
+}
+
+void knet_channel_ref_check_recv_idle(kchannel_ref_t* channel_ref, time_t gap) {
+    kringbuffer_t* rb = 0;
+    verify(channel_ref);
+    if (gap < channel_ref->ref_info->recv_idle) {
+        return;
+    }
+    rb = knet_channel_ref_get_ringbuffer(channel_ref);
+    /* 还有未处理的数据时不收缩, 避免复制 */
+    if (ringbuffer_available(rb) || (ringbuffer_get_max_size(rb) <= channel_ref->ref_info->recv_init_size)) {
+        return;
+    }
+    if (error_ok == knet_channel_shrink_recv_buffer(channel_ref->ref_info->channel,
+        channel_ref->ref_info->recv_init_size)) {
+        knet_loop_profile_increase_recv_buffer_shrink_count(knet_loop_get_profile(channel_ref->ref_info->loop));
     }
 }
 
@@ -685,8 +1088,9 @@ void knet_channel_ref_update_accept_in_loop(kloop_t* loop, kchannel_ref_t* chann
         /* 调用回调 */
         channel_ref->ref_info->cb(channel_ref, channel_cb_event_accept);
     }
-    /* 建立接收超时定时器 */
-    knet_channel_ref_start_recv_timeout_timer(channel_ref);
+    /* 开启读空闲超时检测 */
+    knet_channel_ref_start_recv_timeout(channel_ref);
+    knet_channel_ref_start_recv_idle_timer(channel_ref);
 }
 
 void knet_channel_ref_stop_connect_timeout_timer(kchannel_ref_t* channel_ref) {
@@ -706,8 +1110,9 @@ void knet_channel_ref_update_connect(kchannel_ref_t* channel_ref) {
     knet_channel_ref_set_state(channel_ref, channel_state_active);
     /* 销毁连接超时定时器 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
-    /* 启动接收超时定时器 */
-    knet_channel_ref_start_recv_timeout_timer(channel_ref);
+    /* 开启读空闲超时检测 */
+    knet_channel_ref_start_recv_timeout(channel_ref);
+    knet_channel_ref_start_recv_idle_timer(channel_ref);
     if (channel_ref->ref_info->cb) {
         /* 调用回调 */
         log_error("channel connectd, channel[%llu]", knet_channel_ref_get_uuid(channel_ref));
@@ -719,7 +1124,6 @@ void timer_cb(ktimer_t* timer, void* data) {
     time_t          now           = time(0); /* 当前时间(秒) */
     kchannel_ref_t* channel_ref   = (kchannel_ref_t*)data; /* 当前管道 */
     time_t          gap           = now - channel_ref->ref_info->last_recv_ts; /* 上次接收距离当前时间(秒) */
-    ktimer_t*       recv_timer    = knet_channel_ref_get_recv_timeout_timer(channel_ref); /* 接收定时器 */
     ktimer_t*       connect_timer = knet_channel_ref_get_connect_timeout_timer(channel_ref); /* 连接定时器 */
     if (connect_timer == timer) { /* 连接超时定时器 */
         if (socket_check_send_ready(knet_channel_ref_get_socket_fd(channel_ref))) {
@@ -738,15 +1142,8 @@ void timer_cb(ktimer_t* timer, void* data) {
         if (knet_channel_ref_check_auto_reconnect(channel_ref)) {
             knet_channel_ref_reconnect(channel_ref, 0);
         }
-    } else if (recv_timer == timer) { /* 接收超时定时器 */
-        if (!knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
-            if (gap > channel_ref->ref_info->timeout) {
-                /* 读超时，心跳 */
-                if (knet_channel_ref_get_cb(channel_ref)) {
-                    knet_channel_ref_get_cb(channel_ref)(channel_ref, channel_cb_event_timeout);
-                }
-            }
-        }
+    } else if (channel_ref->ref_info->recv_idle_timer == timer) { /* 接收缓冲区空闲定时器 */
+        knet_channel_ref_check_recv_idle(channel_ref, gap);
     }
 }
 
@@ -793,8 +1190,15 @@ void knet_channel_ref_update_recv(kchannel_ref_t* channel_ref) {
             /* 调用回调 */
             channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv);
         }
-        /* 重新投递读事件 */
-        knet_channel_ref_set_event(channel_ref, channel_event_recv);
+        /* 归还共享接收缓冲区 */
+        if (error_ok != knet_channel_flush_recv_scratch(channel_ref->ref_info->channel)) {
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            return;
+        }
+        if (!knet_channel_ref_check_recv_throttle_in_loop(channel_ref)) {
+            /* 重新投递读事件 */
+            knet_channel_ref_set_event(channel_ref, channel_event_recv);
+        }
     }
 }
 
@@ -813,6 +1217,8 @@ void knet_channel_ref_update_send(kchannel_ref_t* channel_ref) {
         default:
             break;
     }
+    /* 发送队列减少, 检查是否降到低水位 */
+    knet_channel_ref_check_send_watermark(channel_ref);
     if (error == error_ok) {
         if (channel_ref->ref_info->cb) {
             /* 调用回调 */
@@ -823,6 +1229,39 @@ void knet_channel_ref_update_send(kchannel_ref_t* channel_ref) {
     }
 }
 
+void knet_channel_ref_update_recv_buffer(kchannel_ref_t* channel_ref, const char* data, int size, time_t ts) {
+    verify(channel_ref);
+    verify(data);
+    if (knet_channel_ref_check_state(channel_ref, channel_state_close) ||
+        (!knet_channel_ref_check_event(channel_ref, channel_event_recv) && !channel_ref->ref_info->recv_throttle)) {
+        return;
+    }
+    /* 最后一次读取到数据的时间戳（秒） */
+    channel_ref->ref_info->last_recv_ts = ts;
+    knet_channel_ref_update_recv_timeout(channel_ref, ts);
+    if (error_ok != knet_channel_recv_buffer(channel_ref->ref_info->channel, data, size)) {
+        /* 接收缓冲区满 */
+        knet_channel_ref_close_check_reconnect(channel_ref);
+        return;
+    }
+    /* 记录统计数据 */
+    knet_loop_profile_add_recv_bytes(knet_loop_get_profile(channel_ref->ref_info->loop), size);
+    if (channel_ref->ref_info->recv_throttle) {
+        /* 暂停读取前已经提交的接收请求, 数据保留在读缓冲区内 */
+        return;
+    }
+    if (channel_ref->ref_info->cb) {
+        /* 调用回调 */
+        channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv);
+    }
+    /* 归还共享接收缓冲区 */
+    if (error_ok != knet_channel_flush_recv_scratch(channel_ref->ref_info->channel)) {
+        knet_channel_ref_close_check_reconnect(channel_ref);
+        return;
+    }
+    knet_channel_ref_check_recv_throttle_in_loop(channel_ref);
+}
+
 void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e, time_t ts) {
     verify(channel_ref);
     if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
@@ -836,6 +1275,7 @@ void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e
         } else {
             /* 最后一次读取到数据的时间戳（秒） */
             channel_ref->ref_info->last_recv_ts = ts;
+            knet_channel_ref_update_recv_timeout(channel_ref, ts);
             /* 读 */
             knet_channel_ref_update_recv(channel_ref);
         }
@@ -856,6 +1296,11 @@ kringbuffer_t* knet_channel_ref_get_ringbuffer(kchannel_ref_t* channel_ref) {
     return knet_channel_get_ringbuffer(channel_ref->ref_info->channel);
 }
 
+ksend_queue_t* knet_channel_ref_get_send_queue(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return knet_channel_get_send_queue(channel_ref->ref_info->channel);
+}
+
 kloop_t* knet_channel_ref_choose_loop(kchannel_ref_t* channel_ref) {
     kloop_t*          loop         = 0;
     kloop_t*          current_loop = 0;
@@ -899,6 +1344,9 @@ void* knet_channel_ref_get_data(kchannel_ref_t* channel_ref) {
 void knet_channel_ref_set_loop(kchannel_ref_t* channel_ref, kloop_t* loop) {
     verify(channel_ref);
     channel_ref->ref_info->loop = loop;
+    knet_channel_set_send_pool(channel_ref->ref_info->channel, knet_loop_get_send_pool(loop));
+    knet_channel_set_profile(channel_ref->ref_info->channel, knet_loop_get_profile(loop));
+    knet_channel_set_recv_scratch(channel_ref->ref_info->channel, knet_loop_get_recv_scratch(loop));
 }
 
 int knet_channel_ref_check_balance(kchannel_ref_t* channel_ref) {
@@ -949,7 +1397,7 @@ kaddress_t* knet_channel_ref_get_peer_address(kchannel_ref_t* channel_ref) {
         return channel_ref->ref_info->peer_address;
     }
     /* 第一次建立 */
-    channel_ref->ref_info->peer_address = knet_address_create();
+    channel_ref->ref_info->peer_address = knet_address_init(channel_ref->ref_info->peer_address_slot, 0);
     if (knet_channel_is_ipv6(channel_ref->ref_info->channel)) {
         socket_getpeername6(channel_ref, channel_ref->ref_info->peer_address);
     } else {
@@ -964,7 +1412,7 @@ kaddress_t* knet_channel_ref_get_local_address(kchannel_ref_t* channel_ref) {
         return channel_ref->ref_info->local_address;
     }
     /* 第一次建立 */
-    channel_ref->ref_info->local_address = knet_address_create();
+    channel_ref->ref_info->local_address = knet_address_init(channel_ref->ref_info->local_address_slot, 0);
     if (channel_ref->ref_info->state != channel_state_init) {
         if (knet_channel_is_ipv6(channel_ref->ref_info->channel)) {
             socket_getsockname6(channel_ref, channel_ref->ref_info->local_address);
@@ -1020,6 +1468,147 @@ int knet_channel_ref_set_reuseport(kchannel_ref_t* channel_ref) {
     return socket_set_reuseport_on(knet_channel_ref_get_socket_fd(channel_ref));
 }
 
+int knet_channel_ref_set_recv_mirror(kchannel_ref_t* channel_ref) {
+    int error = error_ok;
+    verify(channel_ref);
+    error = ringbuffer_set_mirror(knet_channel_ref_get_ringbuffer(channel_ref));
+    /* 镜像映射模式下长度对齐到页长度 */
+    knet_channel_account_recv_buffer(channel_ref->ref_info->channel);
+    return error;
+}
+
+int knet_channel_ref_set_recv_shared(kchannel_ref_t* channel_ref, int shared) {
+    verify(channel_ref);
+    knet_channel_set_recv_shared(channel_ref->ref_info->channel, shared);
+    return error_ok;
+}
+
+int knet_channel_ref_set_accept_budget(kchannel_ref_t* channel_ref, int budget) {
+    verify(channel_ref);
+    if (budget < 0) {
+        return error_invalid_parameters;
+    }
+    channel_ref->ref_info->accept_budget = budget;
+    return error_ok;
+}
+
+int knet_channel_ref_set_recv_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low) {
+    verify(channel_ref);
+    if (high && (low >= high)) {
+        return error_invalid_parameters;
+    }
+    channel_ref->ref_info->recv_high = high;
+    channel_ref->ref_info->recv_low  = high ? low : 0;
+    /* 可读字节数达到高水位后不再读取, 读缓冲区不会无限扩容 */
+    knet_channel_set_recv_limit(channel_ref->ref_info->channel, high);
+    if (!high && channel_ref->ref_info->recv_throttle) {
+        /* 关闭流量控制时恢复读取 */
+        knet_channel_ref_recv_resume(channel_ref);
+    }
+    return error_ok;
+}
+
+int knet_channel_ref_check_recv_throttle(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->recv_throttle;
+}
+
+int knet_channel_ref_check_recv_throttle_in_loop(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    if (channel_ref->ref_info->recv_throttle) {
+        return 1;
+    }
+    if (!channel_ref->ref_info->recv_high ||
+        !knet_channel_ref_check_state(channel_ref, channel_state_active) ||
+        ((uint32_t)knet_stream_available(channel_ref->ref_info->stream) < channel_ref->ref_info->recv_high)) {
+        return 0;
+    }
+    /* 停止读取, 对端由TCP窗口限速 */
+    channel_ref->ref_info->recv_throttle = 1;
+    knet_channel_ref_clear_event(channel_ref, channel_event_recv);
+    if (channel_ref->ref_info->cb) {
+        channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv_throttle);
+    }
+    return 1;
+}
+
+void knet_channel_ref_check_recv_resume(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    if (!channel_ref->ref_info->recv_throttle ||
+        ((uint32_t)knet_stream_available(channel_ref->ref_info->stream) > channel_ref->ref_info->recv_low)) {
+        return;
+    }
+    knet_channel_ref_recv_resume(channel_ref);
+}
+
+void knet_channel_ref_recv_resume(kchannel_ref_t* channel_ref) {
+    channel_ref->ref_info->recv_throttle = 0;
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return;
+    }
+    /* 重新投递读事件, 套接字接收缓冲区内剩余的数据会触发读事件 */
+    knet_channel_ref_set_event(channel_ref, channel_event_recv);
+    if (channel_ref->ref_info->cb) {
+        channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv_resume);
+    }
+}
+
+int knet_channel_ref_set_send_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low) {
+    verify(channel_ref);
+    if (high && (low >= high)) {
+        return error_invalid_parameters;
+    }
+    channel_ref->ref_info->send_high  = high;
+    channel_ref->ref_info->send_low   = high ? low : 0;
+    channel_ref->ref_info->send_above = 0;
+    return error_ok;
+}
+
+int knet_channel_ref_set_recv_buffer_adaptive(kchannel_ref_t* channel_ref, uint32_t init_size,
+    uint32_t max_size, int idle) {
+    verify(channel_ref);
+    if (!init_size || (max_size && (init_size > max_size)) || (idle < 0)) {
+        return error_invalid_parameters;
+    }
+    channel_ref->ref_info->recv_init_size = init_size;
+    channel_ref->ref_info->recv_max_size  = max_size;
+    channel_ref->ref_info->recv_idle      = idle;
+    knet_channel_set_recv_buffer_max(channel_ref->ref_info->channel, max_size);
+    /* 从初始长度开始按需增长 */
+    knet_channel_shrink_recv_buffer(channel_ref->ref_info->channel, init_size);
+    if (knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        /* 已经建立连接, 重新启动空闲定时器 */
+        knet_channel_ref_start_recv_idle_timer(channel_ref);
+    }
+    return error_ok;
+}
+
+uint64_t knet_channel_ref_get_send_pending_bytes(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return knet_channel_get_send_pending_bytes(channel_ref->ref_info->channel);
+}
+
+void knet_channel_ref_check_send_watermark(kchannel_ref_t* channel_ref) {
+    uint64_t pending = 0;
+    verify(channel_ref);
+    if (!channel_ref->ref_info->send_high ||
+        !knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return;
+    }
+    pending = knet_channel_get_send_pending_bytes(channel_ref->ref_info->channel);
+    if (!channel_ref->ref_info->send_above && (pending >= channel_ref->ref_info->send_high)) {
+        channel_ref->ref_info->send_above = 1;
+        if (channel_ref->ref_info->cb) {
+            channel_ref->ref_info->cb(channel_ref, channel_cb_event_send_high);
+        }
+    } else if (channel_ref->ref_info->send_above && (pending <= channel_ref->ref_info->send_low)) {
+        channel_ref->ref_info->send_above = 0;
+        if (channel_ref->ref_info->cb) {
+            channel_ref->ref_info->cb(channel_ref, channel_cb_event_send_drained);
+        }
+    }
+}
+
 int knet_channel_ref_check_ref_zero(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
     return atomic_counter_zero(&channel_ref->ref_info->ref_count);
@@ -1060,16 +1649,6 @@ void* knet_channel_ref_get_ptr(kchannel_ref_t* channel_ref) {
     return channel_ref->ref_info->user_ptr;
 }
 
-void knet_channel_ref_set_recv_timeout_timer(kchannel_ref_t* channel_ref, ktimer_t* timer) {
-    verify(channel_ref);
-    channel_ref->ref_info->recv_timeout_timer = timer;
-}
-
-ktimer_t* knet_channel_ref_get_recv_timeout_timer(kchannel_ref_t* channel_ref) {
-    verify(channel_ref);
-    return channel_ref->ref_info->recv_timeout_timer;
-}
-
 void knet_channel_ref_set_connect_timeout_timer(kchannel_ref_t* channel_ref, ktimer_t* timer) {
     verify(channel_ref);
     channel_ref->ref_info->connect_timeout_timer = timer;
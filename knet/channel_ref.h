@@ -28,13 +28,62 @@
 #include "config.h"
 #include "channel_ref_api.h"
 
+#define CHANNEL_POOL_MAX      4096 /* ڴ໺Ŀйܵڴ */
+#define CHANNEL_ACCEPT_BUDGET 64   /* ܵÿζ¼Ĭܵ */
+
+/**
+ * ܵڴ
+ * @return kchannel_pool_tʵ
+ */
+kchannel_pool_t* knet_channel_pool_create();
+
 /**
- * ܵ
+ * ٹܵڴ
+ * @param pool kchannel_pool_tʵ
+ */
+void knet_channel_pool_destroy(kchannel_pool_t* pool);
+
+/**
+ * ȡڴڿڴ
+ * @param pool kchannel_pool_tʵ
+ * @return ڴ
+ */
+uint32_t knet_channel_pool_get_free_count(kchannel_pool_t* pool);
+
+/**
+ * ڴطܵڴ, Ϊʱ½
+ * @param pool kchannel_pool_tʵ
+ * @return Ϊknet_channel_ref_get_block_size()ڴ
+ */
+void* knet_channel_pool_alloc(kchannel_pool_t* pool);
+
+/**
+ * ܵڴյڴ, ʱͷ
+ * @param pool kchannel_pool_tʵ
+ * @param block ڴ
+ */
+void knet_channel_pool_free(kchannel_pool_t* pool, void* block);
+
+/**
+ * ȡùܵڴ鳤
+ * ڴΰܵ, ܵϢ, ڵ, , Զ˺ͱصַ, ܵ(ͶкͶ)
+ * @return ܵڴ鳤
+ */
+uint32_t knet_channel_ref_get_block_size();
+
+/**
+ * ܵ, ܵ丽loopڴһη
  * @param loop kloop_tʵ
- * @param channel kchannel_tʵ
+ * @param socket_fd ѽ׽
+ * @param max_send_list_len 󳤶
+ * @param recv_ring_len ܻ󳤶
+ * @param ipv6 ǷIPV6
+ * @param options ׽ѡ, Ϊ0ʱʹĬ
+ * @param inherit 0ʱ׽ѾǷĲ̳˼׽ֵѡ, ֻòᱻ̳еѡ
  * @return kchannel_ref_tʵ
  */
-kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, kchannel_t* channel);
+kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len, int ipv6,
+    const ksocket_options_t* options, int inherit);
 
 /**
  * ٹܵ
@@ -62,6 +111,30 @@ void knet_channel_ref_close_check_reconnect(kchannel_ref_t* channel_ref);
  */
 int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int size);
 
+/**
+ * ɢд
+ * ̵߳ʱݿ鱻ϲΪһ̷߳¼
+ * @param channel_ref kchannel_ref_tʵ
+ * @param iov ݿ
+ * @param count ݿ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int knet_channel_ref_writev(kchannel_ref_t* channel_ref, const kiovec_t* iov, int count);
+
+/**
+ * 㿽д, Ȩƽܵ
+ * ۳ɹfree_cbᱻֻһ, ̵߳ʱڹܵ߳ڵ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param data дָ
+ * @param size ݳ
+ * @param free_cb ͷŻص
+ * @param ctx ͷŻص
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int knet_channel_ref_write_owned(kchannel_ref_t* channel_ref, void* data, int size, knet_write_free_cb_t free_cb, void* ctx);
+
 /**
  * Ϊͨaccept()ص׽ִܵ
  * @param channel_ref kchannel_ref_tʵ
@@ -69,9 +142,10 @@ int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int si
  * @param client_fd ͨaccept()õ׽
  * @param event ǷͶ¼ùܵ״̬
  * @param ipv6 ǷIPV6
+ * @param sa ͨsocket_accept_nonblockõĶԶ˵ַ, Ϊ0ʱ׽Ҫѡ, Զ˵ַͨgetpeernameȡ
  * @return kchannel_ref_tʵ
  */
-kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd, int event, int ipv6);
+kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd, int event, int ipv6, const struct sockaddr* sa);
 
 /**
  * ȡùܵkloop_tʵ
@@ -141,6 +215,29 @@ void knet_channel_ref_update_close_in_loop(kloop_t* loop, kchannel_ref_t* channe
  */
 void knet_channel_ref_update_send_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer);
 
+/**
+ * kloop_tе߳ڷ
+ * ͨ߳ʹ
+ * @param loop kloop_tʵ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param data ָ
+ * @param size ݳ
+ */
+void knet_channel_ref_update_send_data_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, const char* data, int size);
+
+/**
+ * kloop_tе߳㿽
+ * ͨ߳㿽ʹ
+ * @param loop kloop_tʵ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @param free_cb ͷŻص
+ * @param ctx ͷŻص
+ */
+void knet_channel_ref_update_send_owned_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, void* data, int size,
+    knet_write_free_cb_t free_cb, void* ctx);
+
 /**
  * ùܵԶ־
  * @param channel_ref kchannel_ref_tʵ
@@ -227,6 +324,14 @@ void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e
  */
 void knet_channel_ref_update_accept(kchannel_ref_t* channel_ref);
 
+/**
+ * Ϊܵܵӽܵ, 뵽ؾѡkloop_tǰkloop_t
+ * @param channel_ref ܵ
+ * @param client_fd ͻ׽
+ * @param sa Զ˵ַ, Ϊ0
+ */
+void knet_channel_ref_accept_client(kchannel_ref_t* channel_ref, socket_t client_fd, const struct sockaddr* sa);
+
 /**
  * ܵ¼-
  * @param channel_ref kchannel_ref_tʵ
@@ -245,6 +350,16 @@ void knet_channel_ref_update_recv(kchannel_ref_t* channel_ref);
  */
 void knet_channel_ref_update_send(kchannel_ref_t* channel_ref);
 
+/**
+ * ܵ¼-ѡȡѾȡ
+ * ֪ͨѡȡ, ݽд
+ * @param channel_ref kchannel_ref_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @param ts ǰʱ룩
+ */
+void knet_channel_ref_update_recv_buffer(kchannel_ref_t* channel_ref, const char* data, int size, time_t ts);
+
 /**
  * ȡܵгʱ
  * @param channel_ref kchannel_ref_tʵ
@@ -266,6 +381,39 @@ int knet_channel_ref_get_connect_timeout(kchannel_ref_t* channel_ref);
  */
 kringbuffer_t* knet_channel_ref_get_ringbuffer(kchannel_ref_t* channel_ref);
 
+/**
+ * ¼ϺǷﵽոˮλ, ﵽʱͣȡ֪ͨص
+ * @param channel_ref kchannel_ref_tʵ
+ * @retval 0 δͣȡ
+ * @retval 0 ͣȡ
+ */
+int knet_channel_ref_check_recv_throttle_in_loop(kchannel_ref_t* channel_ref);
+
+/**
+ * ݱȡߺǷ񽵵յˮλ, ʱָȡ֪ͨص
+ * @param channel_ref kchannel_ref_tʵ
+ */
+void knet_channel_ref_check_recv_resume(kchannel_ref_t* channel_ref);
+
+/**
+ * ָȡ֪ͨص
+ * @param channel_ref kchannel_ref_tʵ
+ */
+void knet_channel_ref_recv_resume(kchannel_ref_t* channel_ref);
+
+/**
+ * Ͷб仯鷢ˮλ, Խˮλˮλʱ֪ͨص
+ * @param channel_ref kchannel_ref_tʵ
+ */
+void knet_channel_ref_check_send_watermark(kchannel_ref_t* channel_ref);
+
+/**
+ * ȡùܵͶ
+ * @param channel_ref kchannel_ref_tʵ
+ * @return ksend_queue_tʵ
+ */
+ksend_queue_t* knet_channel_ref_get_send_queue(kchannel_ref_t* channel_ref);
+
 /**
  * ȡùܵ¼ص
  * @param channel_ref kchannel_ref_tʵ
@@ -338,20 +486,6 @@ void knet_channel_ref_set_user_data(kchannel_ref_t* channel_ref, void* data);
  */
 void* knet_channel_ref_get_user_data(kchannel_ref_t* channel_ref);
 
-/**
- * ýճʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @param timer ʱ
- */
-void knet_channel_ref_set_recv_timeout_timer(kchannel_ref_t* channel_ref, ktimer_t* timer);
-
-/**
- * ȡճʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @return ʱ
- */
-ktimer_t* knet_channel_ref_get_recv_timeout_timer(kchannel_ref_t* channel_ref);
-
 /**
  * ӳʱʱ
  * @param channel_ref kchannel_ref_tʵ
@@ -388,18 +522,63 @@ int knet_channel_ref_check_close_cb_called(kchannel_ref_t* channel_ref);
 void knet_channel_ref_set_close_cb_called(kchannel_ref_t* channel_ref);
 
 /**
- * ճʱʱ
+ * гʱ, δöгʱʱ
+ * ܵloopͬʱβ, ʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int knet_channel_ref_start_recv_timeout(kchannel_ref_t* channel_ref);
+
+/**
+ * ֹͣгʱ, loopƳ
+ * @param channel_ref kchannel_ref_tʵ
+ */
+void knet_channel_ref_stop_recv_timeout(kchannel_ref_t* channel_ref);
+
+/**
+ * , ¿ʼмʱƵβ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param ts ǰʱ룩
+ */
+void knet_channel_ref_update_recv_timeout(kchannel_ref_t* channel_ref, time_t ts);
+
+/**
+ * гʱ, ͷѾʱĹܵchannel_cb_event_timeout
+ * @param list гʱ
+ * @param timeout ڹܵĶгʱ룩
+ * @param ts ǰʱ룩
+ * @return ʱĹܵ
+ */
+int knet_channel_ref_check_recv_timeout(kdlist_t* list, time_t timeout, time_t ts);
+
+/**
+ * ȡмʱ
+ * @param channel_ref kchannel_ref_tʵ
+ * @return ʱ㣨룩
+ */
+time_t knet_channel_ref_get_recv_timeout_ts(kchannel_ref_t* channel_ref);
+
+/**
+ * ջжʱ, δÿʱ
  * @param channel_ref kchannel_ref_tʵ
  * @retval error_ok ɹ
  * @retval  ʧ
  */
-int knet_channel_ref_start_recv_timeout_timer(kchannel_ref_t* channel_ref);
+int knet_channel_ref_start_recv_idle_timer(kchannel_ref_t* channel_ref);
+
+/**
+ * ٽջжʱ
+ * @param channel_ref kchannel_ref_tʵ
+ */
+void knet_channel_ref_stop_recv_idle_timer(kchannel_ref_t* channel_ref);
 
 /**
- * ٽճʱʱ
+ * ջΪҿʱﵽֵʱʼ
  * @param channel_ref kchannel_ref_tʵ
+ * @param gap ϴνյݵʱ()
  */
-void knet_channel_ref_stop_recv_timeout_timer(kchannel_ref_t* channel_ref);
+void knet_channel_ref_check_recv_idle(kchannel_ref_t* channel_ref, time_t gap);
 
 /**
  * ӳʱʱ
@@ -205,6 +205,8 @@ FuncExport void knet_channel_ref_set_cb(kchannel_ref_t* channel_ref, knet_channe
  * 设置管道空闲超时
  *
  * 管道空闲超时依赖读操作作为判断，在timeout间隔内未有可读数据既触发超时
+ * 在连接建立或被接受时生效, 持续空闲时每隔timeout秒触发一次. 管道按最后活跃时间排列在
+ * kloop_t的链表内, 不为每个管道建立定时器
  * @param channel_ref kchannel_ref_t实例
  * @param timeout 超时（秒）
  */
@@ -284,6 +286,102 @@ FuncExport int knet_channel_ref_is_ipv6(kchannel_ref_t* channel_ref);
  */
 FuncExport int knet_channel_ref_set_reuseport(kchannel_ref_t* channel_ref);
 
+/**
+ * 接收缓冲区切换为镜像映射模式
+ *
+ * 缓冲区内任意可读或可写区域都是连续的, 每次接收只需要一次系统调用,
+ * knet_stream_peek可以访问全部可读数据. 监听器开启后, 接受的管道也会开启, 重连时保留
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval error_ringbuffer_mirror_fail 当前平台不支持或建立映射失败, 保持普通模式
+ */
+FuncExport int knet_channel_ref_set_recv_mirror(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置共享接收模式
+ *
+ * 接收缓冲区为空时数据读取到所在loop的共享接收缓冲区, 接收回调直接读取共享接收缓冲区,
+ * 回调结束后没有处理完的数据才复制到管道自己的接收缓冲区. 管道自己的接收缓冲区为空时释放内存,
+ * 适用于大量空闲连接并且回调内能处理完整消息的场景. 回调结束后共享接收缓冲区被其他管道使用,
+ * 不能在回调外保留knet_stream_peek返回的指针. 监听器开启后, 接受的管道也会开启, 重连时保留
+ * @param channel_ref kchannel_ref_t实例
+ * @param shared 非0开启, 0关闭
+ * @retval error_ok 成功
+ */
+FuncExport int knet_channel_ref_set_recv_shared(kchannel_ref_t* channel_ref, int shared);
+
+/**
+ * 设置监听管道每次读事件最多接受的连接数
+ *
+ * 监听管道在一次读事件内循环接受等待的连接直到没有新连接或达到上限,
+ * 达到上限时剩余的连接在下一次循环内接受, 避免大量连接请求时其他管道得不到处理
+ * @param channel_ref kchannel_ref_t实例
+ * @param budget 最多接受的连接数, 0为默认值(64)
+ * @retval error_ok 成功
+ * @retval error_invalid_parameters 参数错误
+ */
+FuncExport int knet_channel_ref_set_accept_budget(kchannel_ref_t* channel_ref, int budget);
+
+/**
+ * 设置接收流量控制水位
+ *
+ * 读事件处理完毕后可读字节数达到高水位时暂停读取, 以channel_cb_event_recv_throttle通知回调,
+ * 对端由TCP窗口限速而不是关闭连接. 通过管道流取走数据, 可读字节数降到低水位及以下时恢复读取,
+ * 以channel_cb_event_recv_resume通知回调. 监听器设置后, 接受的管道使用相同的水位, 重连时保留
+ * @param channel_ref kchannel_ref_t实例
+ * @param high 高水位(字节), 0为关闭流量控制, 关闭时管道恢复读取
+ * @param low 低水位(字节), 必须小于高水位
+ * @retval error_ok 成功
+ * @retval error_invalid_parameters 低水位不小于高水位
+ */
+FuncExport int knet_channel_ref_set_recv_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low);
+
+/**
+ * 检查是否因为达到接收高水位而暂停读取
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 没有暂停
+ * @retval 非0 已暂停
+ */
+FuncExport int knet_channel_ref_check_recv_throttle(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置发送水位
+ *
+ * 等待发送的字节数达到高水位时以channel_cb_event_send_high通知回调, 之后降到低水位及以下时
+ * 以channel_cb_event_send_drained通知回调, 生产者可以据此暂停和恢复写入. 在loop线程内写入时,
+ * 回调在写入函数返回前调用. 监听器设置后, 接受的管道使用相同的水位, 重连时保留
+ * @param channel_ref kchannel_ref_t实例
+ * @param high 高水位(字节), 0为关闭
+ * @param low 低水位(字节), 必须小于高水位
+ * @retval error_ok 成功
+ * @retval error_invalid_parameters 低水位不小于高水位
+ */
+FuncExport int knet_channel_ref_set_send_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low);
+
+/**
+ * 取得等待发送的字节数
+ * 在loop线程内调用, 其他线程写入但还未到达loop线程的数据不计入
+ * @param channel_ref kchannel_ref_t实例
+ * @return 等待发送的字节数
+ */
+FuncExport uint64_t knet_channel_ref_get_send_pending_bytes(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置接收缓冲区自适应长度
+ *
+ * 接收缓冲区立即收缩到初始长度(不小于已有数据), 之后按需增长, 长度达到最大长度后不再扩容,
+ * 写满时的处理与固定长度相同. 接收缓冲区为空且超过idle秒没有收到数据时收缩回初始长度.
+ * 需要在loop线程内或者管道加入loop之前调用. 监听器设置后, 接受的管道使用相同的设置, 重连时保留
+ * @param channel_ref kchannel_ref_t实例
+ * @param init_size 初始长度(字节)
+ * @param max_size 最大长度(字节), 0为不限制
+ * @param idle 空闲收缩时间(秒), 0为不收缩
+ * @retval error_ok 成功
+ * @retval error_invalid_parameters 初始长度为0或者大于最大长度
+ */
+FuncExport int knet_channel_ref_set_recv_buffer_adaptive(kchannel_ref_t* channel_ref, uint32_t init_size,
+    uint32_t max_size, int idle);
+
 /** @} */
 
 #endif /* CHANNEL_REF_API_H */
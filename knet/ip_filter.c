@@ -25,14 +25,27 @@
 #include <ctype.h>
 #include "ip_filter_api.h"
 #include "trie_api.h"
+#include "hash.h"
 #include "address.h"
 #include "channel_ref.h"
 #include "logger.h"
 
+#define IP_FILTER_IPV4_BUCKETS 4096 /* IPV4ַϣͰ */
+
 struct _ip_filter_t {
     ktrie_t* trie; /* IP trie */
+    khash_t* ipv4; /* IPV4ַ, ֽĶIPΪ, ܵʱҪIPַ */
 };
 
+/**
+ * IPV4ַתΪϣ
+ * @param ip IP
+ * @param key ֽĶIP
+ * @retval 0 IPV4ַ
+ * @retval 1 ɹ
+ */
+int _ip_filter_ipv4_key(const char* ip, uint32_t* key);
+
 /**
  * ȥַʼͽĿհ
  * @param ip IP
@@ -46,6 +59,15 @@ char* _trim(char* ip, int size);
  */
 int _ip_filter_for_each_func(const char* ip, void* param);
 
+int _ip_filter_ipv4_key(const char* ip, uint32_t* key) {
+    struct in_addr addr;
+    if (1 != inet_pton(AF_INET, ip, &addr)) {
+        return 0;
+    }
+    *key = ntohl(addr.s_addr);
+    return 1;
+}
+
 int _ip_filter_for_each_func(const char* ip, void* param) {
     FILE* fp = (FILE*)param;
     verify(ip);
@@ -87,12 +109,15 @@ kip_filter_t* knet_ip_filter_create() {
     memset(filter, 0, sizeof(kip_filter_t));
     filter->trie = trie_create();
     verify(filter->trie);
+    filter->ipv4 = hash_create(IP_FILTER_IPV4_BUCKETS, 0);
+    verify(filter->ipv4);
     return filter;
 }
 
 void knet_ip_filter_destroy(kip_filter_t* ip_filter) {
     verify(ip_filter);
     trie_destroy(ip_filter->trie, 0);
+    hash_destroy(ip_filter->ipv4);
     knet_free(ip_filter);
 }
 
@@ -111,7 +136,7 @@ int knet_ip_filter_load_file(kip_filter_t* ip_filter, const char* path) {
     while (fgets(ip, sizeof(ip), fp)) {
         ptr = _trim(ip, sizeof(ip));
         if (ptr[0]) {
-            error = trie_insert(ip_filter->trie, ip, 0);
+            error = knet_ip_filter_add(ip_filter, ip);
             if (error_ok != error) {
                 goto error_return;
             }
@@ -128,15 +153,28 @@ error_return:
 }
 
 int knet_ip_filter_add(kip_filter_t* ip_filter, const char* ip) {
+    int      error = error_ok;
+    uint32_t key   = 0;
     verify(ip_filter);
     verify(ip);
-    return trie_insert(ip_filter->trie, ip, 0);
+    error = trie_insert(ip_filter->trie, ip, 0);
+    if ((error == error_ok) && _ip_filter_ipv4_key(ip, &key)) {
+        /* ֵֻڱǴ */
+        error = hash_add(ip_filter->ipv4, key, ip_filter);
+    }
+    return error;
 }
 
 int knet_ip_filter_remove(kip_filter_t* ip_filter, const char* ip) {
+    int      error = error_ok;
+    uint32_t key   = 0;
     verify(ip_filter);
     verify(ip);
-    return trie_remove(ip_filter->trie, ip, 0);
+    error = trie_remove(ip_filter->trie, ip, 0);
+    if ((error == error_ok) && _ip_filter_ipv4_key(ip, &key)) {
+        hash_delete(ip_filter->ipv4, key);
+    }
+    return error;
 }
 
 int knet_ip_filter_save(kip_filter_t* ip_filter, const char* path) {
@@ -160,8 +198,14 @@ int knet_ip_filter_check(kip_filter_t* ip_filter, const char* ip) {
 }
 
 int knet_ip_filter_check_address(kip_filter_t* ip_filter, kaddress_t* address) {
+    const struct in_addr* addr = 0;
     verify(ip_filter);
     verify(address);
+    if (address_get_family(address) == AF_INET) {
+        /* ʹöƵַ */
+        addr = (const struct in_addr*)address_get_ip_bytes(address, 0);
+        return (hash_get(ip_filter->ipv4, ntohl(addr->s_addr)) ? 1 : 0);
+    }
     return knet_ip_filter_check(ip_filter, address_get_ip(address));
 }
 
@@ -53,6 +53,10 @@ kdlist_node_t* dlist_node_create() {
     return node;
 }
 
+uint32_t dlist_node_get_object_size() {
+    return sizeof(kdlist_node_t);
+}
+
 kdlist_node_t* dlist_node_init(kdlist_node_t* node) {
     verify(node);
     node->next = 0;
@@ -223,3 +227,74 @@ kdlist_node_t* dlist_get_back(kdlist_t* dlist) {
     }
     return dlist->head->prev;
 }
+
+/* ߵ߶(Vyukov), head, tail */
+struct _kmpsc_queue_t {
+    kmpsc_node_t* volatile head;                   /* Ӷ */
+    char                   pad[64 - sizeof(void*)]; /* α */
+    kmpsc_node_t*          tail;                   /* ߳Ӷ */
+    kmpsc_node_t           stub;                   /* ڱڵ */
+};
+
+kmpsc_queue_t* mpsc_queue_create() {
+    kmpsc_queue_t* queue = knet_create(kmpsc_queue_t);
+    verify(queue);
+    memset(queue, 0, sizeof(kmpsc_queue_t));
+    queue->head = &queue->stub;
+    queue->tail = &queue->stub;
+    return queue;
+}
+
+void mpsc_queue_destroy(kmpsc_queue_t* queue) {
+    verify(queue);
+    knet_free(queue);
+}
+
+void mpsc_queue_push(kmpsc_queue_t* queue, kmpsc_node_t* node) {
+    kmpsc_node_t* prev = 0;
+    verify(queue);
+    verify(node);
+    node->next = 0;
+    /* ռλú, ǰ߿ڵ */
+    prev = (kmpsc_node_t*)atomic_ptr_exchange((void* volatile*)&queue->head, node);
+    atomic_ptr_store((void* volatile*)&prev->next, node);
+}
+
+kmpsc_node_t* mpsc_queue_pop(kmpsc_queue_t* queue) {
+    kmpsc_node_t* tail = 0;
+    kmpsc_node_t* next = 0;
+    verify(queue);
+    tail = queue->tail;
+    next = (kmpsc_node_t*)atomic_ptr_load((void* volatile*)&tail->next);
+    if (tail == &queue->stub) {
+        if (!next) {
+            return 0;
+        }
+        /* ڱ */
+        queue->tail = next;
+        tail        = next;
+        next        = (kmpsc_node_t*)atomic_ptr_load((void* volatile*)&next->next);
+    }
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    if (tail != (kmpsc_node_t*)atomic_ptr_load((void* volatile*)&queue->head)) {
+        /* , ֪ͨһδ */
+        return 0;
+    }
+    /* һڵ, ·ڱȡ */
+    mpsc_queue_push(queue, &queue->stub);
+    next = (kmpsc_node_t*)atomic_ptr_load((void* volatile*)&tail->next);
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    return 0;
+}
+
+int mpsc_queue_empty(kmpsc_queue_t* queue) {
+    verify(queue);
+    /* нڵӺtailͣӵĽڵ(ڱ) */
+    return (queue->tail == (kmpsc_node_t*)atomic_ptr_load((void* volatile*)&queue->head));
+}
@@ -46,6 +46,12 @@ kdlist_node_t* dlist_node_init(kdlist_node_t* node);
  */
 void dlist_node_destroy(kdlist_node_t* node);
 
+/**
+ * ȡڵ㳤, ڽڵǶ뵽ڴ, ֮ͨdlist_node_initʼ
+ * @return ڵ㳤
+ */
+uint32_t dlist_node_get_object_size();
+
 /**
  * ýڵԶ
  * @param node kdlist_node_tʵ
@@ -176,4 +182,44 @@ kdlist_node_t* dlist_get_back(kdlist_t* dlist);
 #define dlist_for_each_break() \
     break
 
+/* ߵ߶нڵ, Ƕ뵽ûṹ */
+struct _kmpsc_node_t {
+    struct _kmpsc_node_t* volatile next; /* һڵ */
+};
+
+/**
+ * ߵ߶
+ * @return kmpsc_queue_tʵ
+ */
+kmpsc_queue_t* mpsc_queue_create();
+
+/**
+ * ٶ, ڵɵ
+ * @param queue kmpsc_queue_tʵ
+ */
+void mpsc_queue_destroy(kmpsc_queue_t* queue);
+
+/**
+ * ڵ, κ߳̾ɵ, 
+ * @param queue kmpsc_queue_tʵ
+ * @param node kmpsc_node_tʵ
+ */
+void mpsc_queue_push(kmpsc_queue_t* queue, kmpsc_node_t* node);
+
+/**
+ * ڵ, ֻΨһ̵߳
+ * @param queue kmpsc_queue_tʵ
+ * @retval kmpsc_node_tʵ
+ * @retval 0 Ϊջ
+ */
+kmpsc_node_t* mpsc_queue_pop(kmpsc_queue_t* queue);
+
+/**
+ * ǷΪ, ֻΨһ̵߳
+ * @param queue kmpsc_queue_tʵ
+ * @retval 0 ǿ()
+ * @retval  
+ */
+int mpsc_queue_empty(kmpsc_queue_t* queue);
+
 #endif /* LIST_H */
@@ -33,6 +33,12 @@
 #include "stream.h"
 #include "logger.h"
 #include "timer.h"
+#include "buffer.h"
+#include "write_batch.h"
+#include "send_queue.h"
+#include "ringbuffer.h"
+
+#define LOOP_RECV_SCRATCH_SIZE (1024 * 64) /* ջ */
 
 /**
  * ѭ
@@ -40,18 +46,28 @@
 struct _loop_t {
     kdlist_t*                  active_channel_list; /* Ծܵ */
     kdlist_t*                  close_channel_list;  /* ѹرչܵ */
-    kdlist_t*                  event_list;          /* ߳¼ */
-    klock_t*                   lock;                /* -߳¼ */
+    kmpsc_queue_t*             event_queue;         /* ߳¼ */
+    atomic_counter_t           notify_armed;        /* Ϊ1ʱһ߳¼Ҫѡȡ */
+#if LOOP_EPOLL
+    int                        notify_fd;           /* ¼֪ͨeventfd */
+#else
     kchannel_ref_t*            notify_channel;      /* ¼֪ͨдܵ */
     kchannel_ref_t*            read_channel;        /* ¼֪ͨܵ */
+#endif /* LOOP_EPOLL */
     kloop_balancer_t*          balancer;            /* ؾ */
     void*                      impl;                /* ¼ѡȡʵ */
     volatile int               running;             /* ¼ѭб־ */
     thread_id_t                thread_id;           /* ¼ѡȡǰ߳ID */
     knet_loop_balance_option_e balance_options;     /* ؾ */
     kloop_profile_t*           profile;             /* ͳ */
+    ksend_pool_t*              send_pool;           /* ܵͶݿ */
+    kchannel_pool_t*           channel_pool;        /* ܵڴ */
+    kringbuffer_t*             recv_scratch;        /* ջ, ģʽĹܵȶȡ */
     void*                      data;                /* ûָ */
     ktimer_loop_t*             timer_loop;          /* ʱѭ */
+    kdlist_t*                  idle_lists;          /* гʱ, ÿͬĳʱһ */
+    int                        max_wait;            /* ѡȡȴʱ䣨룩, С㲻 */
+    int                        hrtimer;             /* Ƿ߾ȶʱ */
 };
 
 /**
@@ -63,22 +79,40 @@ typedef enum _loop_event_e {
     loop_event_send,          /* ¼ */
     loop_event_close,         /* ر¼ */
     loop_event_accept_async,  /* 첽 */
+    loop_event_send_owned,    /* 㿽¼ */
+    loop_event_send_batch,    /* ¼ */
 } loop_event_e;
 
+#define LOOP_EVENT_BATCH 4096 /* ÿλദĿ߳¼ */
+
+/**
+ * гʱ, ڵĹܵмʱ
+ */
+typedef struct _loop_idle_list_t {
+    time_t    timeout; /* гʱ룩 */
+    kdlist_t* list;    /* ܵ, ڵڹܵڴ */
+} loop_idle_list_t;
+
 /**
  * ߳¼
  */
 typedef struct _loop_event_t {
+    kmpsc_node_t    node;        /* нڵ, ǵһԱ */
     kchannel_ref_t* channel_ref; /* ¼عܵ */
     kbuffer_t*      send_buffer; /* ͻָ */
     loop_event_e    event;       /* ¼ */
+    void*                data;    /* 㿽ָ */
+    int                  size;    /* 㿽ݳ */
+    knet_write_free_cb_t free_cb; /* 㿽ͷŻص, ȨƽܵΪ0 */
+    void*                ctx;     /* 㿽ͷŻص */
 } loop_event_t;
 
 loop_event_t* loop_event_create(kchannel_ref_t* channel_ref, kbuffer_t* send_buffer, loop_event_e e) {
     loop_event_t* ev = 0;
-    verify(channel_ref); /* send_bufferΪ0 */
+    /* ¼channel_refΪ0, send_bufferΪ0 */
     ev = knet_create(loop_event_t);
     verify(ev);
+    memset(ev, 0, sizeof(loop_event_t));
     ev->channel_ref = channel_ref;
     ev->send_buffer = send_buffer;
     ev->event       = e;
@@ -87,6 +121,14 @@ loop_event_t* loop_event_create(kchannel_ref_t* channel_ref, kbuffer_t* send_buf
 
 void loop_event_destroy(loop_event_t* loop_event) {
     verify(loop_event);
+    if (loop_event->send_buffer) {
+        /* Ѿдܵͻ򱻶 */
+        knet_buffer_destroy(loop_event->send_buffer);
+    }
+    if (loop_event->free_cb) {
+        /* ¼δ, ͷ㿽 */
+        loop_event->free_cb(loop_event->data, loop_event->size, loop_event->ctx);
+    }
     knet_free(loop_event);
 }
 
@@ -106,29 +148,54 @@ loop_event_e loop_event_get_event(loop_event_t* loop_event) {
 }
 
 kloop_t* knet_loop_create() {
+#if !LOOP_EPOLL
     socket_t pair[2] = {0}; /* ߳¼д */
+#endif /* !LOOP_EPOLL */
     kloop_t* loop    = knet_create(kloop_t);
     verify(loop);
     memset(loop, 0, sizeof(kloop_t));
+#if LOOP_EPOLL
+    /* ߳¼֪ͨ, ѡȡʱע */
+    loop->notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->notify_fd < 0) {
+        knet_free(loop);
+        log_fatal("knet_loop_create() failed, reason: eventfd()");
+        return 0;
+    }
+#endif /* LOOP_EPOLL */
     /* ѡȡʵ */
     if (knet_impl_create(loop)) {
+#if LOOP_EPOLL
+        close(loop->notify_fd);
+#endif /* LOOP_EPOLL */
         knet_free(loop);
         log_fatal("knet_loop_create() failed, reason: knet_impl_create()");
         return 0;
     }
+#if !LOOP_EPOLL
     /* ߳¼д */
     if (socket_pair(pair)) {
         knet_free(loop);
         log_fatal("knet_loop_create() failed, reason: socket_pair()");
         return 0;
     }
+#endif /* !LOOP_EPOLL */
     loop->profile             = knet_loop_profile_create(loop);       /* ͳ */
+    loop->send_pool           = send_pool_create();                   /* Ͷݿ */
+    loop->channel_pool        = knet_channel_pool_create();           /* ܵڴ */
     loop->active_channel_list = dlist_create();                       /* Ծܵ */
     loop->close_channel_list  = dlist_create();                       /* ӳٹرչܵ */
-    loop->event_list          = dlist_create();                       /* ߳¼ */
-    loop->lock                = lock_create();                        /*  - ߳¼ */
-    loop->timer_loop          = ktimer_loop_create(0);                /* ʱѭ */
+    loop->event_queue         = mpsc_queue_create();                  /* ߳¼ */
+    loop->idle_lists          = dlist_create();                       /* гʱ */
+    /* ʱѭ, ÿܵжʱ, ʹ÷ֲʱ */
+    loop->timer_loop          = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
     loop->balance_options     = loop_balancer_in | loop_balancer_out; /* ؾ */
+    loop->max_wait            = -1;                                   /* Ƶȴʱ */
+    loop->notify_armed        = 1;                                    /* һ߳¼ѡȡ */
+    /* ջ, ջռ */
+    loop->recv_scratch = ringbuffer_create(LOOP_RECV_SCRATCH_SIZE);
+    knet_loop_profile_add_recv_buffer_bytes(loop->profile, LOOP_RECV_SCRATCH_SIZE);
+#if !LOOP_EPOLL
     loop->notify_channel      = knet_loop_create_channel_exist_socket_fd(loop, pair[0], 0, 1024); /* ߳¼֪ͨдܵ */
     verify(loop->notify_channel);
     loop->read_channel = knet_loop_create_channel_exist_socket_fd(loop, pair[1], 0, 1024 * 16); /* ߳¼֪ͨܵ */
@@ -142,14 +209,16 @@ kloop_t* knet_loop_create() {
     knet_channel_ref_set_event(loop->read_channel, channel_event_recv);
     /* ö¼ص */
     knet_channel_ref_set_cb(loop->read_channel, knet_loop_queue_cb);
+#endif /* !LOOP_EPOLL */
     return loop;
 }
 
 void knet_loop_destroy(kloop_t* loop) {
     kdlist_node_t*  node        = 0;
     kdlist_node_t*  temp        = 0;
-    kchannel_ref_t* channel_ref = 0;
-    loop_event_t*   event       = 0;
+    kchannel_ref_t*   channel_ref = 0;
+    loop_event_t*     event       = 0;
+    loop_idle_list_t* idle_list   = 0;
     verify(loop);
     /* رлԾܵ */
     dlist_for_each_safe(loop->active_channel_list, node, temp) {
@@ -163,23 +232,38 @@ void knet_loop_destroy(kloop_t* loop) {
         while (!knet_channel_ref_check_ref_zero(channel_ref)) {
             knet_channel_ref_decref(channel_ref);
         }
+        /* ڵڹܵڴ, Ƴ */
+        dlist_remove(loop->close_channel_list, node);
         knet_channel_ref_destroy(channel_ref);
     }
     /* ѡȡʵ */
     knet_impl_destroy(loop);
+#if LOOP_EPOLL
+    close(loop->notify_fd);
+#endif /* LOOP_EPOLL */
     dlist_destroy(loop->close_channel_list); /* ٹر */
     dlist_destroy(loop->active_channel_list); /* ٻԾ */
+    /* йܵѾƳгʱ */
+    dlist_for_each_safe(loop->idle_lists, node, temp) {
+        idle_list = (loop_idle_list_t*)dlist_node_get_data(node);
+        dlist_destroy(idle_list->list);
+        knet_free(idle_list);
+    }
+    dlist_destroy(loop->idle_lists);
     /* δ߳¼ */
-    dlist_for_each_safe(loop->event_list, node, temp) {
-        event = (loop_event_t*)dlist_node_get_data(node);
-        knet_free(event);
+    while ((event = (loop_event_t*)mpsc_queue_pop(loop->event_queue))) {
+        loop_event_destroy(event);
     }
+    /* йܵ, ٷͶݿ */
+    send_pool_destroy(loop->send_pool);
+    /* ٹܵڴ */
+    knet_channel_pool_destroy(loop->channel_pool);
+    /* ٹջ */
+    ringbuffer_destroy(loop->recv_scratch);
     /* ͳ */
     knet_loop_profile_destroy(loop->profile);
-    /* ¼ */
-    dlist_destroy(loop->event_list);
-    /* ¼ */
-    lock_destroy(loop->lock);
+    /* ¼ */
+    mpsc_queue_destroy(loop->event_queue);
     /* ٶʱѭ, йܵʱ */
     ktimer_loop_destroy(loop->timer_loop);
     /* ѭ */
@@ -189,12 +273,14 @@ void knet_loop_destroy(kloop_t* loop) {
 void loop_add_event(kloop_t* loop, loop_event_t* loop_event) {
     verify(loop);
     verify(loop_event);
-    lock_lock(loop->lock); /*  */
     log_verb("invoke loop_add_event(), event[type:%d]", loop_event->event);
-    /* ¼ӵβ */
-    dlist_add_tail_node(loop->event_list, loop_event);
-    lock_unlock(loop->lock); /*  */
-    knet_loop_notify(loop); /* ֪ͨĿ */
+    /* ¼, ߲ᱻloop߳ */
+    mpsc_queue_push(loop->event_queue, &loop_event->node);
+    /* ֻloopвñ־, һӵ߸, ¼ϲ */
+    if (1 == atomic_counter_cas(&loop->notify_armed, 1, 0)) {
+        knet_loop_profile_increase_notify_count(loop->profile);
+        knet_loop_notify(loop); /* ֪ͨĿ */
+    }
 }
 
 void knet_loop_notify_accept(kloop_t* loop, kchannel_ref_t* channel_ref) {
@@ -226,6 +312,29 @@ void knet_loop_notify_send(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t
     loop_add_event(loop, loop_event_create(channel_ref, send_buffer, loop_event_send));
 }
 
+void knet_loop_notify_send_batch(kloop_t* loop, kbuffer_t* send_buffer) {
+    verify(loop);
+    verify(send_buffer);
+    /* send¼ */
+    loop_add_event(loop, loop_event_create(0, send_buffer, loop_event_send_batch));
+}
+
+void knet_loop_notify_send_owned(kloop_t* loop, kchannel_ref_t* channel_ref, void* data, int size,
+    knet_write_free_cb_t free_cb, void* ctx) {
+    loop_event_t* loop_event = 0;
+    verify(loop);
+    verify(channel_ref);
+    verify(data);
+    verify(free_cb);
+    loop_event = loop_event_create(channel_ref, 0, loop_event_send_owned);
+    loop_event->data    = data;
+    loop_event->size    = size;
+    loop_event->free_cb = free_cb;
+    loop_event->ctx     = ctx;
+    /* 㿽send¼ */
+    loop_add_event(loop, loop_event);
+}
+
 void knet_loop_notify_close(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
@@ -233,6 +342,7 @@ void knet_loop_notify_close(kloop_t* loop, kchannel_ref_t* channel_ref) {
     loop_add_event(loop, loop_event_create(channel_ref, 0, loop_event_close));
 }
 
+#if !LOOP_EPOLL
 void knet_loop_queue_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     verify(channel);
     if (e & channel_cb_event_recv) {
@@ -248,27 +358,46 @@ void knet_loop_queue_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     }
 }
 
+#endif /* !LOOP_EPOLL */
+
 void knet_loop_notify(kloop_t* loop) {
+#if LOOP_EPOLL
+    uint64_t count = 1;
+    verify(loop);
+    /* eventfd¼, (EAGAIN)ʱ¼Ѿ */
+    if (write(loop->notify_fd, &count, sizeof(count)) < 0) {
+        log_verb("write() eventfd failed, system error: %d", sys_get_errno());
+    }
+#else
     char c = 1;
     verify(loop);
     /* һֽڴص  */
     socket_send(knet_channel_ref_get_socket_fd(loop->notify_channel), &c, sizeof(c));
+#endif /* LOOP_EPOLL */
 }
 
-void knet_loop_event_process(kloop_t* loop) {
-    /*
-     * loop̵߳Ĵԭ:
-     * 1. κιܵ(kchannel_ref_t)вֻһ߳, ܵ߳ǰ󶨵Ĺϵ
-     * 2. κһ߳ڲܵ, ܵ߳ûа󶨹ϵ, ¼ʽ̴߳
-     */
-    kdlist_node_t* node       = 0;
-    kdlist_node_t* temp       = 0;
-    loop_event_t*  loop_event = 0;
-    verify(loop);
-    lock_lock(loop->lock); /*  */
-    /* ÿζ¼صڴ¼ */
-    dlist_for_each_safe(loop->event_list, node, temp) {
-        loop_event = (loop_event_t*)dlist_node_get_data(node);
+#if LOOP_EPOLL
+int knet_loop_get_notify_fd(kloop_t* loop) {
+    verify(loop);
+    return loop->notify_fd;
+}
+
+void knet_loop_notify_fd_update(kloop_t* loop) {
+    uint64_t count = 0;
+    verify(loop);
+    /* eventfd, ֻǻźûʵ */
+    if (read(loop->notify_fd, &count, sizeof(count)) < 0) {
+        log_verb("read() eventfd failed, system error: %d", sys_get_errno());
+    }
+    knet_loop_event_process(loop);
+}
+#endif /* LOOP_EPOLL */
+
+void loop_event_process_queue(kloop_t* loop) {
+    int           count      = 0;
+    loop_event_t* loop_event = 0;
+    /* ¼, ڼ䲻κ, δƱܵ */
+    for (; (count < LOOP_EVENT_BATCH) && (loop_event = (loop_event_t*)mpsc_queue_pop(loop->event_queue)); count++) {
         switch(loop_event->event) {
             case loop_event_accept: /*  */
                 knet_channel_ref_update_accept_in_loop(loop, loop_event->channel_ref);
@@ -282,6 +411,14 @@ void knet_loop_event_process(kloop_t* loop) {
             case loop_event_send: /* ǰloopsend */
                 knet_channel_ref_update_send_in_loop(loop, loop_event->channel_ref, loop_event->send_buffer);
                 break;
+            case loop_event_send_batch: /* ǰloopsend */
+                knet_write_batch_dispatch(loop, loop_event->send_buffer);
+                break;
+            case loop_event_send_owned: /* ǰloop㿽send, Ȩƽܵ */
+                knet_channel_ref_update_send_owned_in_loop(loop, loop_event->channel_ref, loop_event->data,
+                    loop_event->size, loop_event->free_cb, loop_event->ctx);
+                loop_event->free_cb = 0;
+                break;
             case loop_event_close: /* ǰloopclose */
                 knet_channel_ref_update_close_in_loop(loop, loop_event->channel_ref);
                 break;
@@ -290,30 +427,83 @@ void knet_loop_event_process(kloop_t* loop) {
         }
         /* ¼ */
         loop_event_destroy(loop_event);
-        /* ڵ */
-        dlist_delete(loop->event_list, node);
     }
-    lock_unlock(loop->lock); /*  */
+}
+
+void knet_loop_event_process(kloop_t* loop) {
+    /*
+     * loop̵߳Ĵԭ:
+     * 1. κιܵ(kchannel_ref_t)вֻһ߳, ܵ߳ǰ󶨵Ĺϵ
+     * 2. κһ߳ڲܵ, ܵ߳ûа󶨹ϵ, ¼ʽ̴߳
+     */
+    verify(loop);
+    loop_event_process_queue(loop);
+    /* Ϻûѱ־, ֮ӵĵһ߸ */
+    atomic_counter_cas(&loop->notify_armed, 0, 1);
+    if (mpsc_queue_empty(loop->event_queue)) {
+        return;
+    }
+    /* ¼, ־ûбȡһѭڼ */
+    if (1 == atomic_counter_cas(&loop->notify_armed, 1, 0)) {
+        knet_loop_profile_increase_notify_count(loop->profile);
+        knet_loop_notify(loop);
+    }
 }
 
 kchannel_ref_t* knet_loop_create_channel_exist_socket_fd(kloop_t* loop, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len) {
     verify(loop);
-    return knet_channel_ref_create(loop, knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, recv_ring_len, 0));
+    return knet_channel_ref_create(loop, socket_fd, max_send_list_len, recv_ring_len, 0, 0, 0);
 }
 
 kchannel_ref_t* knet_loop_create_channel_exist_socket_fd6(kloop_t* loop, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len) {
     verify(loop);
-    return knet_channel_ref_create(loop, knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, recv_ring_len, 1));
+    return knet_channel_ref_create(loop, socket_fd, max_send_list_len, recv_ring_len, 1, 0, 0);
 }
 
 kchannel_ref_t* knet_loop_create_channel(kloop_t* loop, uint32_t max_send_list_len, uint32_t recv_ring_len) {
+    socket_t socket_fd = 0;
     verify(loop);
-    return knet_channel_ref_create(loop, knet_channel_create(max_send_list_len, recv_ring_len, 0));
+    socket_fd = socket_create();
+    verify(socket_fd > 0);
+    if (socket_fd <= 0) {
+        return 0;
+    }
+    return knet_channel_ref_create(loop, socket_fd, max_send_list_len, recv_ring_len, 0, 0, 0);
 }
 
 kchannel_ref_t* knet_loop_create_channel6(kloop_t* loop, uint32_t max_send_list_len, uint32_t recv_ring_len) {
+    socket_t socket_fd = 0;
+    verify(loop);
+    socket_fd = socket_create6();
+    verify(socket_fd > 0);
+    if (socket_fd <= 0) {
+        return 0;
+    }
+    return knet_channel_ref_create(loop, socket_fd, max_send_list_len, recv_ring_len, 1, 0, 0);
+}
+
+kchannel_ref_t* knet_loop_create_channel_with_options(kloop_t* loop, uint32_t max_send_list_len,
+    uint32_t recv_ring_len, const ksocket_options_t* options) {
+    socket_t socket_fd = 0;
     verify(loop);
-    return knet_channel_ref_create(loop, knet_channel_create(max_send_list_len, recv_ring_len, 1));
+    socket_fd = socket_create();
+    verify(socket_fd > 0);
+    if (socket_fd <= 0) {
+        return 0;
+    }
+    return knet_channel_ref_create(loop, socket_fd, max_send_list_len, recv_ring_len, 0, options, 0);
+}
+
+kchannel_ref_t* knet_loop_create_channel6_with_options(kloop_t* loop, uint32_t max_send_list_len,
+    uint32_t recv_ring_len, const ksocket_options_t* options) {
+    socket_t socket_fd = 0;
+    verify(loop);
+    socket_fd = socket_create6();
+    verify(socket_fd > 0);
+    if (socket_fd <= 0) {
+        return 0;
+    }
+    return knet_channel_ref_create(loop, socket_fd, max_send_list_len, recv_ring_len, 1, options, 0);
 }
 
 thread_id_t knet_loop_get_thread_id(kloop_t* loop) {
@@ -344,6 +534,10 @@ int knet_loop_run(kloop_t* loop) {
 void knet_loop_exit(kloop_t* loop) {
     verify(loop);
     loop->running = 0;
+    if (loop->thread_id && (loop->thread_id != thread_get_self_id())) {
+        /* ߳˳, ѿڵȴѡȡ */
+        knet_loop_notify(loop);
+    }
 }
 
 kdlist_t* knet_loop_get_active_list(kloop_t* loop) {
@@ -417,10 +611,124 @@ kloop_balancer_t* knet_loop_get_balancer(kloop_t* loop) {
     return loop->balancer;
 }
 
-void knet_loop_check_timeout(kloop_t* loop, time_t ts) {
-    (void)ts;
-    /* ܵʱ, ӳʱͶʱ */
-    ktimer_loop_run_once(loop->timer_loop);
+kdlist_t* knet_loop_get_idle_list(kloop_t* loop, time_t timeout) {
+    kdlist_node_t*    node      = 0;
+    loop_idle_list_t* idle_list = 0;
+    verify(loop);
+    verify(timeout);
+    dlist_for_each(loop->idle_lists, node) {
+        idle_list = (loop_idle_list_t*)dlist_node_get_data(node);
+        if (idle_list->timeout == timeout) {
+            return idle_list->list;
+        }
+    }
+    /* ͬĳʱ, һֱloop */
+    idle_list = knet_create(loop_idle_list_t);
+    verify(idle_list);
+    idle_list->timeout = timeout;
+    idle_list->list    = dlist_create();
+    dlist_add_tail_node(loop->idle_lists, idle_list);
+    return idle_list->list;
+}
+
+int knet_loop_check_timeout(kloop_t* loop, time_t ts) {
+    kdlist_node_t*    node      = 0;
+    loop_idle_list_t* idle_list = 0;
+    int               count     = 0;
+    verify(loop);
+    /* гʱ, ÿֻѾʱĹܵ */
+    dlist_for_each(loop->idle_lists, node) {
+        idle_list = (loop_idle_list_t*)dlist_node_get_data(node);
+        count += knet_channel_ref_check_recv_timeout(idle_list->list, idle_list->timeout, ts);
+    }
+    /* ܵʱʱ, ӳʱ */
+    count += ktimer_loop_run_once(loop->timer_loop);
+    if (count) {
+        knet_loop_profile_increase_timer_wakeup_count(loop->profile);
+    }
+    return count;
+}
+
+/**
+ * ȡһгʱĵȴʱ
+ * @param loop kloop_tʵ
+ * @retval -1 ûпгʱĹܵ
+ * @retval  ȴʱ䣨룩
+ */
+int _loop_get_idle_timeout(kloop_t* loop) {
+    kdlist_node_t*    node      = 0;
+    kdlist_node_t*    front     = 0;
+    loop_idle_list_t* idle_list = 0;
+    uint64_t          now       = 0;
+    uint64_t          wake      = 0;
+    uint64_t          min       = 0;
+    dlist_for_each(loop->idle_lists, node) {
+        idle_list = (loop_idle_list_t*)dlist_node_get_data(node);
+        front     = dlist_get_front(idle_list->list);
+        if (!front) {
+            continue;
+        }
+        /* timeout㳬ʱ, һ뿪ʼʱ */
+        wake = ((uint64_t)knet_channel_ref_get_recv_timeout_ts(
+            (kchannel_ref_t*)dlist_node_get_data(front)) + idle_list->timeout + 1) * 1000;
+        if (!min || (wake < min)) {
+            min = wake;
+        }
+    }
+    if (!min) {
+        return -1;
+    }
+    now = time_get_milliseconds_19700101();
+    if (min <= now) {
+        return 0;
+    }
+    if (min - now > INT_MAX) {
+        return INT_MAX;
+    }
+    return (int)(min - now);
+}
+
+int knet_loop_get_wait_timeout(kloop_t* loop) {
+    int timeout = 0;
+    int idle    = 0;
+    verify(loop);
+    if (!dlist_empty(loop->close_channel_list)) {
+        /* δٵĹܵ, Ҫٴμ */
+        timeout = 1;
+    } else {
+        timeout = ktimer_loop_get_next_timeout(loop->timer_loop);
+        idle    = _loop_get_idle_timeout(loop);
+        if ((idle >= 0) && ((timeout < 0) || (idle < timeout))) {
+            timeout = idle;
+        }
+    }
+    if ((loop->max_wait >= 0) && ((timeout < 0) || (timeout > loop->max_wait))) {
+        timeout = loop->max_wait;
+    }
+    return timeout;
+}
+
+time_t knet_loop_get_wait_timeout_us(kloop_t* loop) {
+    int    ms = knet_loop_get_wait_timeout(loop);
+    time_t us = -1;
+    if (loop->hrtimer) {
+        /* ȴʱѾȡĶʱʱ, ʱʱʹ΢ */
+        us = ktimer_loop_get_next_timeout_us(loop->timer_loop);
+        if ((us >= 0) && ((ms < 0) || (us < (time_t)ms * 1000))) {
+            return us;
+        }
+    }
+    return (ms < 0) ? -1 : (time_t)ms * 1000;
+}
+
+void knet_loop_set_max_wait(kloop_t* loop, int ms) {
+    verify(loop);
+    loop->max_wait = ms;
+}
+
+int knet_loop_get_max_wait(kloop_t* loop) {
+    verify(loop);
+    return loop->max_wait;
 }
 
 void knet_loop_check_close(kloop_t* loop) {
@@ -439,10 +747,11 @@ void knet_loop_check_close(kloop_t* loop) {
             /* ùر¼ص־ */
             knet_channel_ref_set_close_cb_called(channel_ref);
         }
-        /* ٹܵ */
-        if (error_ok == knet_channel_ref_destroy(channel_ref)) {
+        /* ٹܵ, ڵڹܵڴ, üΪʱƳ */
+        if (knet_channel_ref_check_ref_zero(channel_ref)) {
+            dlist_remove(knet_loop_get_close_list(loop), node);
+            knet_channel_ref_destroy(channel_ref);
             knet_loop_profile_decrease_close_channel_count(loop->profile);
-            dlist_delete(knet_loop_get_close_list(loop), node);
         }
     }
 }
@@ -487,6 +796,21 @@ void* knet_loop_get_data(kloop_t* loop) {
     return loop->data;
 }
 
+ksend_pool_t* knet_loop_get_send_pool(kloop_t* loop) {
+    verify(loop);
+    return loop->send_pool;
+}
+
+kchannel_pool_t* knet_loop_get_channel_pool(kloop_t* loop) {
+    verify(loop);
+    return loop->channel_pool;
+}
+
+kringbuffer_t* knet_loop_get_recv_scratch(kloop_t* loop) {
+    verify(loop);
+    return loop->recv_scratch;
+}
+
 kloop_profile_t* knet_loop_get_profile(kloop_t* loop) {
     verify(loop);
     return loop->profile;
@@ -496,3 +820,20 @@ ktimer_loop_t* knet_loop_get_timer_loop(kloop_t* loop) {
     verify(loop);
     return loop->timer_loop;
 }
+
+int knet_loop_enable_hrtimer(kloop_t* loop, time_t tick_us) {
+    int error = error_ok;
+    verify(loop);
+    error = ktimer_loop_set_tick_us(loop->timer_loop, tick_us);
+    if (error != error_ok) {
+        return error;
+    }
+    /* ѡȡһεȴǰעtimerfd */
+    loop->hrtimer = 1;
+    return error_ok;
+}
+
+int knet_loop_check_hrtimer(kloop_t* loop) {
+    verify(loop);
+    return loop->hrtimer;
+}
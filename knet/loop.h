@@ -127,6 +127,26 @@ void knet_loop_notify_connect(kloop_t* loop, kchannel_ref_t* channel_ref);
  */
 void knet_loop_notify_send(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer);
 
+/**
+ * ¼֪ͨ - ߳
+ * @param loop kloop_tʵ
+ * @param send_buffer , kwrite_batch_t
+ */
+void knet_loop_notify_send_batch(kloop_t* loop, kbuffer_t* send_buffer);
+
+/**
+ * ¼֪ͨ - ߳㿽
+ * ¼ǰloopʱfree_cb
+ * @param loop kloop_tʵ
+ * @param channel_ref kchannel_ref_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @param free_cb ͷŻص
+ * @param ctx ͷŻص
+ */
+void knet_loop_notify_send_owned(kloop_t* loop, kchannel_ref_t* channel_ref, void* data, int size,
+    knet_write_free_cb_t free_cb, void* ctx);
+
 /**
  * ¼֪ͨ - رչܵ
  * @param loop kloop_tʵ
@@ -134,15 +154,30 @@ void knet_loop_notify_send(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t
  */
 void knet_loop_notify_close(kloop_t* loop, kchannel_ref_t* channel_ref);
 
+#if LOOP_EPOLL
+/**
+ * ȡÿ߳¼֪ͨ(eventfd), ѡȡע¼
+ * @param loop kloop_tʵ
+ * @return eventfd
+ */
+int knet_loop_get_notify_fd(kloop_t* loop);
+
+/**
+ * ߳¼֪ͨ¼, п߳¼
+ * @param loop kloop_tʵ
+ */
+void knet_loop_notify_fd_update(kloop_t* loop);
+#else
 /**
  * ֪ͨܵص
  * @param channel kchannel_ref_tʵ
  * @param e ܵ¼
  */
 void knet_loop_queue_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e);
+#endif /* LOOP_EPOLL */
 
 /**
- * ¼صknet_loop_queue_cb
+ * ѡȡ߳¼
  * @param loop kloop_tʵ
  */
 void knet_loop_notify(kloop_t* loop);
@@ -154,11 +189,37 @@ void knet_loop_notify(kloop_t* loop);
 void knet_loop_event_process(kloop_t* loop);
 
 /**
- * Ծܵгʱ
+ * ԾܵгʱͶʱ
  * @param loop kloop_tʵ
  * @param ts ǰʱ룩
+ * @return гʱĹܵ͵ڶʱ
+ */
+int knet_loop_check_timeout(kloop_t* loop, time_t ts);
+
+/**
+ * ȡöгʱΪtimeoutĹܵ, 
+ * @param loop kloop_tʵ
+ * @param timeout гʱ룩
+ * @return ܵ
+ */
+kdlist_t* knet_loop_get_idle_list(kloop_t* loop, time_t timeout);
+
+/**
+ * ȡѡȡȴʱ
+ * һʱгʱĵʱ, knet_loop_set_max_wait()
+ * @param loop kloop_tʵ
+ * @retval -1 һֱȴ¼
+ * @retval  ȴʱ䣨룩
+ */
+int knet_loop_get_wait_timeout(kloop_t* loop);
+
+/**
+ * ȡѡȡȴʱ, ߾ȶʱʱȷ΢
+ * @param loop kloop_tʵ
+ * @retval -1 һֱȴ¼
+ * @retval  ȴʱ䣨΢룩
  */
-void knet_loop_check_timeout(kloop_t* loop, time_t ts);
+time_t knet_loop_get_wait_timeout_us(kloop_t* loop);
 
 /**
  * رչܵǷ
@@ -276,10 +337,24 @@ void* knet_loop_get_data(kloop_t* loop);
 void knet_loop_set_data(kloop_t* loop, void* data);
 
 /**
- * ȡʱѭ
+ * ȡܵͶݿ
+ * @param loop kloop_tʵ
+ * @return ksend_pool_tʵ
+ */
+ksend_pool_t* knet_loop_get_send_pool(kloop_t* loop);
+
+/**
+ * ȡܵڴ
+ * @param loop kloop_tʵ
+ * @return kchannel_pool_tʵ
+ */
+kchannel_pool_t* knet_loop_get_channel_pool(kloop_t* loop);
+
+/**
+ * ȡջ, ֻloop߳ʹ
  * @param loop kloop_tʵ
- * @return ktimer_loop_tʵ
+ * @return kringbuffer_tʵ
  */
-ktimer_loop_t* knet_loop_get_timer_loop(kloop_t* loop);
+kringbuffer_t* knet_loop_get_recv_scratch(kloop_t* loop);
 
 #endif /* LOOP_H */
@@ -29,22 +29,39 @@
 #include "channel_ref.h"
 #include "channel.h"
 #include "logger.h"
+#include "loop_profile.h"
+#include "timer.h"
+#include "misc.h"
 
 typedef struct _loop_epoll_t {
-    int                 epoll_fd; /* epoll */
-    struct epoll_event* events;   /* epoll¼ */
+    int                 epoll_fd;     /* epoll */
+    struct epoll_event* events;       /* epoll¼ */
+    int                 timer_fd;     /* ߾ȶʱtimerfd, һεȴǰ */
+    uint64_t            timer_expire; /* timerfdǰĵʱ΢룩, 0Ϊδ */
 } loop_epoll_t;
 
 #define MAXEVENTS 8192 /* epoll_create */
 
 int knet_impl_create(kloop_t* loop) {
+    struct epoll_event event;
     loop_epoll_t* impl = knet_create(loop_epoll_t);
     knet_loop_set_impl(loop, impl);
-    impl->epoll_fd = epoll_create(MAXEVENTS);
+    impl->timer_fd     = -1;
+    impl->timer_expire = 0;
+    impl->epoll_fd     = epoll_create(MAXEVENTS);
     if (impl->epoll_fd < 0) {
         knet_free(impl);
         return 1;
     }
+    /* ע߳¼֪ͨ, data.ptrΪ0ֹܵ */
+    memset(&event, 0, sizeof(event));
+    event.data.ptr = 0;
+    event.events   = EPOLLIN | EPOLLET;
+    if (epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, knet_loop_get_notify_fd(loop), &event)) {
+        close(impl->epoll_fd);
+        knet_free(impl);
+        return 1;
+    }
     impl->events = knet_create_type(struct epoll_event, sizeof(struct epoll_event) * MAXEVENTS);
     assert(impl->events);
     return error_ok;
@@ -52,15 +69,72 @@ int knet_impl_create(kloop_t* loop) {
 
 void knet_impl_destroy(kloop_t* loop) {
     loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
+    if (impl->timer_fd >= 0) {
+        close(impl->timer_fd);
+    }
     close(impl->epoll_fd);
     knet_free(impl->events);
     knet_free(impl);
 }
 
+int _timer_fd_update(kloop_t* loop) {
+    struct epoll_event event;
+    struct itimerspec  spec;
+    uint64_t           expire = 0;
+    loop_epoll_t*      impl   = (loop_epoll_t*)knet_loop_get_impl(loop);
+    if (impl->timer_fd < 0) {
+        impl->timer_fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (impl->timer_fd < 0) {
+            return error_loop_fail;
+        }
+        /* data.ptrָtimer_fd, ܵͿ߳¼֪ͨ */
+        memset(&event, 0, sizeof(event));
+        event.data.ptr = &impl->timer_fd;
+        event.events   = EPOLLIN;
+        if (epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, impl->timer_fd, &event)) {
+            close(impl->timer_fd);
+            impl->timer_fd = -1;
+            return error_loop_fail;
+        }
+    }
+    expire = ktimer_loop_get_next_expire(knet_loop_get_timer_loop(loop));
+    if (expire == impl->timer_expire) {
+        /* ĵʱûб仯, Ҫϵͳ */
+        return error_ok;
+    }
+    /* ʱֺCLOCK_REALTIME197011Ϊ, ʱΪ0ʱֹͣtimerfd */
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec  = (time_t)(expire / 1000000);
+    spec.it_value.tv_nsec = (long)(expire % 1000000) * 1000;
+    if (timerfd_settime(impl->timer_fd, TFD_TIMER_ABSTIME, &spec, 0)) {
+        return error_loop_fail;
+    }
+    impl->timer_expire = expire;
+    return error_ok;
+}
+
+void _timer_fd_read(loop_epoll_t* impl) {
+    uint64_t count = 0;
+    /* 㵽ڴ, һεȴǰ */
+    if (read(impl->timer_fd, &count, sizeof(count)) < 0) {
+        log_verb("read() timerfd failed, system error: %d", sys_get_errno());
+    }
+    impl->timer_expire = 0;
+}
+
 int _select(kloop_t* loop, int* count) {
     loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
-    *count = epoll_wait(impl->epoll_fd, impl->events, MAXEVENTS, 1);
+    if (knet_loop_check_hrtimer(loop) && (_timer_fd_update(loop) != error_ok)) {
+        return error_loop_fail;
+    }
+    /* ȴʱĶʱʱ, ûжʱʱ޵ȴֱ¼֪ͨ,
+       ߾ȶʱʱtimerfdڵʱ份, ȴʱȡtimerfd */
+    *count = epoll_wait(impl->epoll_fd, impl->events, MAXEVENTS, knet_loop_get_wait_timeout(loop));
     if (*count < 0) {
+        if (errno == EINTR) { /* źж */
+            *count = 0;
+            return error_ok;
+        }
         return error_loop_fail;
     }
     return error_ok;
@@ -70,18 +144,26 @@ int knet_impl_run_once(kloop_t* loop) {
     int count = 0;
     int i = 0;
     kchannel_ref_t* channel_ref = 0;
+    int timeout_count = 0;
     struct epoll_event event;
-    time_t ts = time(0);
+    time_t ts = 0;
     struct epoll_event* events = 0;
     loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
     int error = _select(loop, &count);
     if (error != error_ok) {
         return error;
     }
+    ts = time(0); /* ܵȴ˽ϳʱ, Ѻȡʱ */
     events = impl->events;
     for (; i < count; i++) {
         channel_ref = (kchannel_ref_t*)events[i].data.ptr;
-        if ((events[i].events & EPOLLERR) || (events[i].events & EPOLLHUP)) {
+        if (!channel_ref) {
+            /* ߳¼֪ͨ */
+            knet_loop_notify_fd_update(loop);
+        } else if (events[i].data.ptr == &impl->timer_fd) {
+            /* ߾ȶʱ, ڱλѵ */
+            _timer_fd_read(impl);
+        } else if ((events[i].events & EPOLLERR) || (events[i].events & EPOLLHUP)) {
            /* ManPage: In kernel versions before 2.6.9, the EPOLL_CTL_DEL operation required a non-NULL pointer
               in event, even though this argument is ignored. Since Linux 2.6.9, event can be specified
               as NULL when using EPOLL_CTL_DEL. Applications that need to be portable to kernels before
@@ -95,7 +177,11 @@ int knet_impl_run_once(kloop_t* loop) {
         } else {
         }
     }
-    knet_loop_check_timeout(loop, ts);
+    timeout_count = knet_loop_check_timeout(loop, ts);
+    knet_loop_profile_increase_wakeup_count(knet_loop_get_profile(loop));
+    if (!count && !timeout_count) {
+        knet_loop_profile_increase_empty_wakeup_count(knet_loop_get_profile(loop));
+    }
     knet_loop_check_close(loop);
     return error_ok;
 }
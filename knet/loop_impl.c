@@ -28,6 +28,8 @@
     #include "loop_select.c" /* select */
 #elif LOOP_IOCP
     #include "loop_iocp.c" /* IOCP */
+#elif LOOP_URING
+    #include "loop_uring.c" /* io_uring */
 #elif LOOP_EPOLL
     #include "loop_epoll.c" /* EPOLL */
 #endif
@@ -27,6 +27,8 @@
 #include "list.h"
 #include "stream.h"
 #include "logger.h"
+#include "misc.h"
+#include "send_queue.h"
 
 struct _loop_profile_t {
     kloop_t*  loop;                /* ¼ѭ */
@@ -40,6 +42,14 @@ struct _loop_profile_t {
     uint64_t last_recv_bytes;     /* ϴεknet_loop_profile_get_recv_bandwidthʱĽֽ */
     time_t   last_send_tick;      /* ϴεknet_loop_profile_get_sent_bandwidthʱʱ룩 */
     time_t   last_recv_tick;      /* ϴεknet_loop_profile_get_recv_bandwidthʱʱ룩 */
+    uint64_t wakeup;              /* ѡȡѴ */
+    uint64_t empty_wakeup;        /* ѡȡջѴ, û¼Ҳûжʱ */
+    uint64_t timer_wakeup;        /* жʱڻܵгʱĻѴ */
+    atomic_counter_t notify;      /* ߳¼ѡȡ, ̵߳ */
+    uint64_t recv_calls;          /* ݵϵͳô */
+    uint64_t send_calls;          /* ݵϵͳô */
+    uint64_t recv_buffer_bytes;   /* йܵջռõֽ */
+    uint64_t recv_buffer_shrink;  /* ջ */
 };
 
 kloop_profile_t* knet_loop_profile_create(kloop_t* loop) {
@@ -123,6 +133,96 @@ uint64_t knet_loop_profile_get_recv_bytes(kloop_profile_t* profile) {
     return profile->recv_bytes;
 }
 
+uint64_t knet_loop_profile_increase_wakeup_count(kloop_profile_t* profile) {
+    verify(profile);
+    return ++profile->wakeup;
+}
+
+uint64_t knet_loop_profile_get_wakeup_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->wakeup;
+}
+
+uint64_t knet_loop_profile_increase_empty_wakeup_count(kloop_profile_t* profile) {
+    verify(profile);
+    return ++profile->empty_wakeup;
+}
+
+uint64_t knet_loop_profile_get_empty_wakeup_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->empty_wakeup;
+}
+
+uint64_t knet_loop_profile_increase_timer_wakeup_count(kloop_profile_t* profile) {
+    verify(profile);
+    return ++profile->timer_wakeup;
+}
+
+uint64_t knet_loop_profile_get_timer_wakeup_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->timer_wakeup;
+}
+
+uint64_t knet_loop_profile_increase_notify_count(kloop_profile_t* profile) {
+    verify(profile);
+    return (uint32_t)atomic_counter_inc(&profile->notify);
+}
+
+uint64_t knet_loop_profile_get_notify_count(kloop_profile_t* profile) {
+    verify(profile);
+    return (uint32_t)profile->notify;
+}
+
+uint64_t knet_loop_profile_add_recv_call_count(kloop_profile_t* profile, uint64_t count) {
+    verify(profile);
+    return (profile->recv_calls += count);
+}
+
+uint64_t knet_loop_profile_get_recv_call_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->recv_calls;
+}
+
+uint64_t knet_loop_profile_add_send_call_count(kloop_profile_t* profile, uint64_t count) {
+    verify(profile);
+    return (profile->send_calls += count);
+}
+
+uint64_t knet_loop_profile_get_send_call_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->send_calls;
+}
+
+uint64_t knet_loop_profile_add_recv_buffer_bytes(kloop_profile_t* profile, uint64_t bytes) {
+    verify(profile);
+    return (profile->recv_buffer_bytes += bytes);
+}
+
+uint64_t knet_loop_profile_sub_recv_buffer_bytes(kloop_profile_t* profile, uint64_t bytes) {
+    verify(profile);
+    if (profile->recv_buffer_bytes < bytes) {
+        profile->recv_buffer_bytes = 0;
+    } else {
+        profile->recv_buffer_bytes -= bytes;
+    }
+    return profile->recv_buffer_bytes;
+}
+
+uint64_t knet_loop_profile_get_recv_buffer_bytes(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->recv_buffer_bytes;
+}
+
+uint64_t knet_loop_profile_increase_recv_buffer_shrink_count(kloop_profile_t* profile) {
+    verify(profile);
+    return ++profile->recv_buffer_shrink;
+}
+
+uint64_t knet_loop_profile_get_recv_buffer_shrink_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->recv_buffer_shrink;
+}
+
 uint32_t knet_loop_profile_get_sent_bandwidth(kloop_profile_t* profile) {
     time_t   tick      = time(0);
     uint64_t bandwidth = 0;
@@ -161,6 +261,11 @@ uint32_t knet_loop_profile_get_recv_bandwidth(kloop_profile_t* profile) {
     return (uint32_t)bandwidth;
 }
 
+uint64_t knet_loop_profile_get_send_pending_bytes(kloop_profile_t* profile) {
+    verify(profile);
+    return send_pool_get_pending_bytes(knet_loop_get_send_pool(profile->loop));
+}
+
 int knet_loop_profile_dump_file(kloop_profile_t* profile, FILE* fp) {
     int len = 0;
     verify(profile);
@@ -173,14 +278,32 @@ int knet_loop_profile_dump_file(kloop_profile_t* profile, FILE* fp) {
         "Received bytes:      %lld\n"
         "Sent bytes:          %lld\n"
         "Received bandwidth:  %ld(B/s)\n"
-        "Sent bandwidth:      %ld(B/s)\n",
+        "Sent bandwidth:      %ld(B/s)\n"
+        "Wakeup:              %lld\n"
+        "Empty wakeup:        %lld\n"
+        "Timer wakeup:        %lld\n"
+        "Notify:              %lld\n"
+        "Send pending:        %lld(B)\n"
+        "Recv calls:          %lld\n"
+        "Send calls:          %lld\n"
+        "Recv buffer:         %lld(B)\n"
+        "Recv buffer shrink:  %lld\n",
         (long)knet_loop_profile_get_established_channel_count(profile),
         (long)knet_loop_profile_get_active_channel_count(profile),
         (long)knet_loop_profile_get_close_channel_count(profile),
         (long long)knet_loop_profile_get_recv_bytes(profile),
         (long long)knet_loop_profile_get_sent_bytes(profile),
         (long)knet_loop_profile_get_recv_bandwidth(profile),
-        (long)knet_loop_profile_get_sent_bandwidth(profile));
+        (long)knet_loop_profile_get_sent_bandwidth(profile),
+        (long long)knet_loop_profile_get_wakeup_count(profile),
+        (long long)knet_loop_profile_get_empty_wakeup_count(profile),
+        (long long)knet_loop_profile_get_timer_wakeup_count(profile),
+        (long long)knet_loop_profile_get_notify_count(profile),
+        (long long)knet_loop_profile_get_send_pending_bytes(profile),
+        (long long)knet_loop_profile_get_recv_call_count(profile),
+        (long long)knet_loop_profile_get_send_call_count(profile),
+        (long long)knet_loop_profile_get_recv_buffer_bytes(profile),
+        (long long)knet_loop_profile_get_recv_buffer_shrink_count(profile));
     if (len <= 0) {
         return error_fail;
     }
@@ -198,14 +321,32 @@ int knet_loop_profile_dump_stream(kloop_profile_t* profile, kstream_t* stream) {
         "Received bytes:      %lld\n"
         "Sent bytes:          %lld\n"
         "Received bandwidth:  %ld(B/s)\n"
-        "Sent bandwidth:      %ld(B/s)\n",
+        "Sent bandwidth:      %ld(B/s)\n"
+        "Wakeup:              %lld\n"
+        "Empty wakeup:        %lld\n"
+        "Timer wakeup:        %lld\n"
+        "Notify:              %lld\n"
+        "Send pending:        %lld(B)\n"
+        "Recv calls:          %lld\n"
+        "Send calls:          %lld\n"
+        "Recv buffer:         %lld(B)\n"
+        "Recv buffer shrink:  %lld\n",
         (long)knet_loop_profile_get_established_channel_count(profile),
         (long)knet_loop_profile_get_active_channel_count(profile),
         (long)knet_loop_profile_get_close_channel_count(profile),
         (long long)knet_loop_profile_get_recv_bytes(profile),
         (long long)knet_loop_profile_get_sent_bytes(profile),
         (long)knet_loop_profile_get_recv_bandwidth(profile),
-        (long)knet_loop_profile_get_sent_bandwidth(profile));
+        (long)knet_loop_profile_get_sent_bandwidth(profile),
+        (long long)knet_loop_profile_get_wakeup_count(profile),
+        (long long)knet_loop_profile_get_empty_wakeup_count(profile),
+        (long long)knet_loop_profile_get_timer_wakeup_count(profile),
+        (long long)knet_loop_profile_get_notify_count(profile),
+        (long long)knet_loop_profile_get_send_pending_bytes(profile),
+        (long long)knet_loop_profile_get_recv_call_count(profile),
+        (long long)knet_loop_profile_get_send_call_count(profile),
+        (long long)knet_loop_profile_get_recv_buffer_bytes(profile),
+        (long long)knet_loop_profile_get_recv_buffer_shrink_count(profile));
 }
 
 int knet_loop_profile_dump_stdout(kloop_profile_t* profile) {
@@ -219,14 +360,32 @@ int knet_loop_profile_dump_stdout(kloop_profile_t* profile) {
         "Received bytes:      %lld\n"
         "Sent bytes:          %lld\n"
         "Received bandwidth:  %ld(B/s)\n"
-        "Sent bandwidth:      %ld(B/s)\n",
+        "Sent bandwidth:      %ld(B/s)\n"
+        "Wakeup:              %lld\n"
+        "Empty wakeup:        %lld\n"
+        "Timer wakeup:        %lld\n"
+        "Notify:              %lld\n"
+        "Send pending:        %lld(B)\n"
+        "Recv calls:          %lld\n"
+        "Send calls:          %lld\n"
+        "Recv buffer:         %lld(B)\n"
+        "Recv buffer shrink:  %lld\n",
         (long)knet_loop_profile_get_established_channel_count(profile),
         (long)knet_loop_profile_get_active_channel_count(profile),
         (long)knet_loop_profile_get_close_channel_count(profile),
         (long long)knet_loop_profile_get_recv_bytes(profile),
         (long long)knet_loop_profile_get_sent_bytes(profile),
         (long)knet_loop_profile_get_recv_bandwidth(profile),
-        (long)knet_loop_profile_get_sent_bandwidth(profile));
+        (long)knet_loop_profile_get_sent_bandwidth(profile),
+        (long long)knet_loop_profile_get_wakeup_count(profile),
+        (long long)knet_loop_profile_get_empty_wakeup_count(profile),
+        (long long)knet_loop_profile_get_timer_wakeup_count(profile),
+        (long long)knet_loop_profile_get_notify_count(profile),
+        (long long)knet_loop_profile_get_send_pending_bytes(profile),
+        (long long)knet_loop_profile_get_recv_call_count(profile),
+        (long long)knet_loop_profile_get_send_call_count(profile),
+        (long long)knet_loop_profile_get_recv_buffer_bytes(profile),
+        (long long)knet_loop_profile_get_recv_buffer_shrink_count(profile));
     if (len <= 0) {
         return error_fail;
     }
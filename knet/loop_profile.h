@@ -99,4 +99,71 @@ uint64_t knet_loop_profile_add_send_bytes(kloop_profile_t* profile, uint64_t sen
  */
 uint64_t knet_loop_profile_add_recv_bytes(kloop_profile_t* profile, uint64_t recv_bytes);
 
+/**
+ * ѡȡѴ
+ * @param profile kloop_profile_tʵ
+ * @return ѡȡѴ
+ */
+uint64_t knet_loop_profile_increase_wakeup_count(kloop_profile_t* profile);
+
+/**
+ * ѡȡջѴ
+ * @param profile kloop_profile_tʵ
+ * @return ѡȡջѴ
+ */
+uint64_t knet_loop_profile_increase_empty_wakeup_count(kloop_profile_t* profile);
+
+/**
+ * жʱڵĻѴ
+ * @param profile kloop_profile_tʵ
+ * @return жʱڵĻѴ
+ */
+uint64_t knet_loop_profile_increase_timer_wakeup_count(kloop_profile_t* profile);
+
+/**
+ * ӿ߳¼Ѵ, ̰߳ȫ
+ * @param profile kloop_profile_tʵ
+ * @return ߳¼Ѵ
+ */
+uint64_t knet_loop_profile_increase_notify_count(kloop_profile_t* profile);
+
+/**
+ * ӽݵϵͳô
+ * @param profile kloop_profile_tʵ
+ * @param count 
+ * @return ǰݵϵͳô
+ */
+uint64_t knet_loop_profile_add_recv_call_count(kloop_profile_t* profile, uint64_t count);
+
+/**
+ * ӷݵϵͳô
+ * @param profile kloop_profile_tʵ
+ * @param count 
+ * @return ǰݵϵͳô
+ */
+uint64_t knet_loop_profile_add_send_call_count(kloop_profile_t* profile, uint64_t count);
+
+/**
+ * ӽջռõֽ
+ * @param profile kloop_profile_tʵ
+ * @param bytes ֽ
+ * @return ǰջռõֽ
+ */
+uint64_t knet_loop_profile_add_recv_buffer_bytes(kloop_profile_t* profile, uint64_t bytes);
+
+/**
+ * ٽջռõֽ
+ * @param profile kloop_profile_tʵ
+ * @param bytes ֽ
+ * @return ǰջռõֽ
+ */
+uint64_t knet_loop_profile_sub_recv_buffer_bytes(kloop_profile_t* profile, uint64_t bytes);
+
+/**
+ * ӽջ
+ * @param profile kloop_profile_tʵ
+ * @return ջ
+ */
+uint64_t knet_loop_profile_increase_recv_buffer_shrink_count(kloop_profile_t* profile);
+
 #endif /* LOOP_PROFILE_H */
@@ -76,6 +76,76 @@ extern uint32_t knet_loop_profile_get_sent_bandwidth(kloop_profile_t* profile);
  */
 extern uint32_t knet_loop_profile_get_recv_bandwidth(kloop_profile_t* profile);
 
+/**
+ * ȡѡȡѴ
+ * @param profile kloop_profile_tʵ
+ * @return ѡȡѴ
+ */
+extern uint64_t knet_loop_profile_get_wakeup_count(kloop_profile_t* profile);
+
+/**
+ * ȡѡȡջѴ
+ * ѡȡѵû¼Ҳûжʱ
+ * @param profile kloop_profile_tʵ
+ * @return ѡȡջѴ
+ */
+extern uint64_t knet_loop_profile_get_empty_wakeup_count(kloop_profile_t* profile);
+
+/**
+ * ȡжʱ(ܵгʱ)ĻѴ
+ * öʱݲʱĶʱһ, ۲컽Ѵı仯
+ * @param profile kloop_profile_tʵ
+ * @return жʱڵĻѴ
+ */
+extern uint64_t knet_loop_profile_get_timer_wakeup_count(kloop_profile_t* profile);
+
+/**
+ * ȡÿ߳¼ѡȡĴ
+ * ѡȡ߳¼ڼӵ¼ϲ, ٴλ
+ * @param profile kloop_profile_tʵ
+ * @return ߳¼Ѵ
+ */
+extern uint64_t knet_loop_profile_get_notify_count(kloop_profile_t* profile);
+
+/**
+ * ȡйܵȴ͵ֽ
+ * @param profile kloop_profile_tʵ
+ * @return ȴ͵ֽ
+ */
+extern uint64_t knet_loop_profile_get_send_pending_bytes(kloop_profile_t* profile);
+
+/**
+ * ȡýݵϵͳô
+ * knet_loop_profile_get_recv_bytesһԵõÿϵͳýյƽֽ,
+ * io_uringͨύɵĽղ
+ * @param profile kloop_profile_tʵ
+ * @return ݵϵͳô
+ */
+extern uint64_t knet_loop_profile_get_recv_call_count(kloop_profile_t* profile);
+
+/**
+ * ȡ÷ݵϵͳô
+ * io_uringͨύɵķͲ
+ * @param profile kloop_profile_tʵ
+ * @return ݵϵͳô
+ */
+extern uint64_t knet_loop_profile_get_send_call_count(kloop_profile_t* profile);
+
+/**
+ * ȡйܵջռõֽ
+ * ܵջ, ӦȺʱ, knet_channel_ref_set_recv_buffer_adaptive
+ * @param profile kloop_profile_tʵ
+ * @return ջռõֽ
+ */
+extern uint64_t knet_loop_profile_get_recv_buffer_bytes(kloop_profile_t* profile);
+
+/**
+ * ȡýջ
+ * @param profile kloop_profile_tʵ
+ * @return ջ
+ */
+extern uint64_t knet_loop_profile_get_recv_buffer_shrink_count(kloop_profile_t* profile);
+
 /**
  * ͳϢдļ
  * @param profile kloop_profile_tʵ
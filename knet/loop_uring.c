@@ -0,0 +1,745 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef LOOP_URING
+
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <linux/io_uring.h>
+
+#include "loop.h"
+#include "list.h"
+#include "channel_ref.h"
+#include "ringbuffer.h"
+#include "send_queue.h"
+#include "loop_profile.h"
+#include "misc.h"
+#include "logger.h"
+
+#define URING_ENTRIES      4096  /* ύг */
+#define URING_BUFFER_COUNT 256   /* ջ, 2 */
+#define URING_BUFFER_SIZE  4096  /* ջ */
+#define URING_BUFFER_GROUP 0     /* ջID */
+#define URING_SEND_SIZE    65536 /* ύ͵ֽ */
+
+/**
+ * 
+ */
+typedef enum _io_type_e {
+    io_type_accept = 1, /* δaccept */
+    io_type_recv   = 2, /* δrecv */
+    io_type_send   = 4, /* send */
+    io_type_poll   = 8, /* ȴ */
+} io_type_e;
+
+typedef struct _per_sock_t per_sock_t;
+
+/**
+ * per-I/O, ַΪuser_data
+ */
+typedef struct _per_io_t {
+    io_type_e   type;     /* ǰ */
+    int         pending;  /* ύδ */
+    per_sock_t* per_sock; /* per-socket */
+} per_io_t;
+
+/**
+ * per-socket
+ */
+struct _per_sock_t {
+    kchannel_ref_t* channel_ref; /* ǰܵ, ΪʾܵѾ */
+    per_io_t        io_recv;     /* acceptrecv, ͬһʱֻһ */
+    per_io_t        io_send;     /* send, ͬһʱֻһ */
+    per_io_t        io_poll;     /* ȴ */
+    socket_t        accept_fd;   /* ѾܵδĿͻ׽ */
+    char*           send_buffer; /* ڷ͵(ͶͷĿ), ںɷǰܸı */
+    uint32_t        send_max;    /* send_buffer */
+    uint32_t        send_pos;    /* Ѿ͵ֽ */
+    uint32_t        send_len;    /* send_bufferݵֽ */
+    int             send_queued; /* Ƿڵȴ */
+    per_sock_t*     next;        /* ȴ¶ */
+};
+
+/**
+ * io_uringʵ
+ */
+typedef struct _loop_uring_t {
+    int                       ring_fd;       /* io_uring */
+    unsigned int              sq_entries;    /* ύг */
+    void*                     sq_ptr;        /* ύӳַ */
+    size_t                    sq_size;       /* ύӳ䳤 */
+    void*                     cq_ptr;        /* ɶӳַ */
+    size_t                    cq_size;       /* ɶӳ䳤 */
+    struct io_uring_sqe*      sqes;          /* ύԪ */
+    size_t                    sqes_size;     /* ύԪ鳤 */
+    unsigned int*             sq_head;       /* ύͷ, ں޸ */
+    unsigned int*             sq_tail;       /* ύβ */
+    unsigned int*             sq_mask;       /* ύ */
+    unsigned int*             sq_array;      /* ύ */
+    unsigned int              sq_local_tail; /* Ѿ䵫δύύβ */
+    unsigned int*             cq_head;       /* ɶͷ */
+    unsigned int*             cq_tail;       /* ɶβ, ں޸ */
+    unsigned int*             cq_mask;       /* ɶ */
+    struct io_uring_cqe*      cqes;          /* ɶԪ */
+    struct io_uring_buf_ring* buf_ring;      /* ջ */
+    size_t                    buf_ring_size; /* ջӳ䳤 */
+    unsigned short            buf_tail;      /* ջβ */
+    char*                     buffers;       /* ջ */
+    per_sock_t*               send_list;     /* ȴ, ´io_uring_enterǰύ */
+    per_sock_t*               orphan_list;   /* ܵѾٵδper-socket */
+} loop_uring_t;
+
+/**
+ * ȡѭio_uringʵ
+ * @param loop kloop_tʵ
+ * @return loop_uring_tʵ
+ */
+loop_uring_t* get_impl(kloop_t* loop);
+
+/**
+ * ȡùܵper-socket
+ * @param channel_ref ܵ
+ * @return per_sock_tʵ
+ */
+per_sock_t* get_data(kchannel_ref_t* channel_ref);
+
+/**
+ * ύ󲢵ȴ¼
+ * @param impl loop_uring_tʵ
+ * @param wait Ƿȴ¼
+ * @param timeout ȴʱ䣨΢룩, Сһֱȴ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int uring_enter(loop_uring_t* impl, int wait, time_t timeout);
+
+/**
+ * ȡһеύԪ
+ * @param impl loop_uring_tʵ
+ * @param per_io , Ϊʱ¼
+ * @return ύԪ, ύʱ
+ */
+struct io_uring_sqe* uring_get_sqe(loop_uring_t* impl, per_io_t* per_io);
+
+/**
+ * Ͷ(accept, recvpoll)
+ * @param channel_ref kchannel_ref_tʵ
+ * @param per_io 
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int uring_post(kchannel_ref_t* channel_ref, per_io_t* per_io);
+
+/**
+ * ȡѾͶݵ
+ * @param impl loop_uring_tʵ
+ * @param per_io 
+ */
+void uring_cancel(loop_uring_t* impl, per_io_t* per_io);
+
+/**
+ * ܵȴ
+ * @param impl loop_uring_tʵ
+ * @param per_sock per_sock_tʵ
+ */
+void uring_queue_send(loop_uring_t* impl, per_sock_t* per_sock);
+
+/**
+ * ΪȴڵĹܵsend
+ * @param impl loop_uring_tʵ
+ */
+void uring_flush_send(loop_uring_t* impl);
+
+/**
+ * ջ黹ں
+ * @param impl loop_uring_tʵ
+ * @param bid ID
+ */
+void uring_buffer_recycle(loop_uring_t* impl, unsigned short bid);
+
+/**
+ * ¼
+ * @param loop kloop_tʵ
+ * @param cqe ¼
+ * @param ts ǰʱ룩
+ */
+void uring_complete(kloop_t* loop, struct io_uring_cqe* cqe, time_t ts);
+
+loop_uring_t* get_impl(kloop_t* loop) {
+    return (loop_uring_t*)knet_loop_get_impl(loop);
+}
+
+per_sock_t* get_data(kchannel_ref_t* channel_ref) {
+    return (per_sock_t*)knet_channel_ref_get_data(channel_ref);
+}
+
+per_sock_t* socket_data_create(kchannel_ref_t* channel_ref) {
+    per_sock_t* data = knet_create(per_sock_t);
+    verify(data);
+    memset(data, 0, sizeof(per_sock_t));
+    data->channel_ref       = channel_ref;
+    data->io_send.type      = io_type_send;
+    data->io_send.per_sock  = data;
+    data->io_poll.type      = io_type_poll;
+    data->io_poll.per_sock  = data;
+    data->io_recv.per_sock  = data;
+    return data;
+}
+
+void socket_data_destroy(per_sock_t* data) {
+    verify(data);
+    if (data->accept_fd > 0) {
+        socket_close(data->accept_fd);
+    }
+    if (data->send_buffer) {
+        knet_free(data->send_buffer);
+    }
+    knet_free(data);
+}
+
+void uring_buffer_recycle(loop_uring_t* impl, unsigned short bid) {
+    struct io_uring_buf* buf = &impl->buf_ring->bufs[impl->buf_tail & (URING_BUFFER_COUNT - 1)];
+    buf->addr = (uint64_t)(uintptr_t)(impl->buffers + (size_t)bid * URING_BUFFER_SIZE);
+    buf->len  = URING_BUFFER_SIZE;
+    buf->bid  = bid;
+    impl->buf_tail++;
+    /* ں˿µĻβǰ, Ѿд */
+    __atomic_store_n(&impl->buf_ring->tail, impl->buf_tail, __ATOMIC_RELEASE);
+}
+
+int knet_impl_create(kloop_t* loop) {
+    struct io_uring_params  params;
+    struct io_uring_buf_reg reg;
+    unsigned short          i    = 0;
+    loop_uring_t*           impl = knet_create(loop_uring_t);
+    verify(impl);
+    memset(impl, 0, sizeof(loop_uring_t));
+    memset(&params, 0, sizeof(params));
+    knet_loop_set_impl(loop, impl);
+    impl->ring_fd = (int)syscall(__NR_io_uring_setup, URING_ENTRIES, &params);
+    if (impl->ring_fd < 0) {
+        log_error("io_uring_setup() failed, system error: %d", sys_get_errno());
+        knet_free(impl);
+        return error_loop_impl_init_fail;
+    }
+    /* ҪEXT_ARGȴʱNODROP֤¼ʧ */
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP)) {
+        log_error("io_uring features not supported, features: %x", params.features);
+        close(impl->ring_fd);
+        knet_free(impl);
+        return error_loop_impl_init_fail;
+    }
+    impl->sq_entries = params.sq_entries;
+    impl->sq_size    = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    impl->cq_size    = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (impl->cq_size > impl->sq_size) {
+            impl->sq_size = impl->cq_size;
+        }
+        impl->cq_size = impl->sq_size;
+    }
+    impl->sq_ptr = mmap(0, impl->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        impl->ring_fd, IORING_OFF_SQ_RING);
+    if (impl->sq_ptr == MAP_FAILED) {
+        close(impl->ring_fd);
+        knet_free(impl);
+        return error_loop_impl_init_fail;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        impl->cq_ptr = impl->sq_ptr;
+    } else {
+        impl->cq_ptr = mmap(0, impl->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            impl->ring_fd, IORING_OFF_CQ_RING);
+        if (impl->cq_ptr == MAP_FAILED) {
+            munmap(impl->sq_ptr, impl->sq_size);
+            close(impl->ring_fd);
+            knet_free(impl);
+            return error_loop_impl_init_fail;
+        }
+    }
+    impl->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    impl->sqes = (struct io_uring_sqe*)mmap(0, impl->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, impl->ring_fd, IORING_OFF_SQES);
+    impl->sq_head  = (unsigned int*)((char*)impl->sq_ptr + params.sq_off.head);
+    impl->sq_tail  = (unsigned int*)((char*)impl->sq_ptr + params.sq_off.tail);
+    impl->sq_mask  = (unsigned int*)((char*)impl->sq_ptr + params.sq_off.ring_mask);
+    impl->sq_array = (unsigned int*)((char*)impl->sq_ptr + params.sq_off.array);
+    impl->cq_head  = (unsigned int*)((char*)impl->cq_ptr + params.cq_off.head);
+    impl->cq_tail  = (unsigned int*)((char*)impl->cq_ptr + params.cq_off.tail);
+    impl->cq_mask  = (unsigned int*)((char*)impl->cq_ptr + params.cq_off.ring_mask);
+    impl->cqes     = (struct io_uring_cqe*)((char*)impl->cq_ptr + params.cq_off.cqes);
+    impl->sq_local_tail = *impl->sq_tail;
+    /* עջ, multishot recvں˴ӻѡȡ */
+    impl->buf_ring_size = URING_BUFFER_COUNT * sizeof(struct io_uring_buf);
+    impl->buf_ring = (struct io_uring_buf_ring*)mmap(0, impl->buf_ring_size, PROT_READ | PROT_WRITE,
+        MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    impl->buffers = knet_create_raw(URING_BUFFER_COUNT * URING_BUFFER_SIZE);
+    verify(impl->buffers);
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr    = (uint64_t)(uintptr_t)impl->buf_ring;
+    reg.ring_entries = URING_BUFFER_COUNT;
+    reg.bgid         = URING_BUFFER_GROUP;
+    if ((impl->sqes == MAP_FAILED) || (impl->buf_ring == MAP_FAILED) ||
+        (syscall(__NR_io_uring_register, impl->ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)) {
+        log_error("io_uring_register() failed, system error: %d", sys_get_errno());
+        if (impl->buf_ring == MAP_FAILED) {
+            impl->buf_ring = 0;
+        }
+        if (impl->sqes == MAP_FAILED) {
+            impl->sqes = 0;
+        }
+        knet_impl_destroy(loop);
+        return error_loop_impl_init_fail;
+    }
+    for (i = 0; i < URING_BUFFER_COUNT; i++) {
+        uring_buffer_recycle(impl, i);
+    }
+    return error_ok;
+}
+
+void knet_impl_destroy(kloop_t* loop) {
+    per_sock_t*   per_sock = 0;
+    loop_uring_t* impl     = get_impl(loop);
+    verify(impl);
+    /* رں˽ȡδ */
+    close(impl->ring_fd);
+    if (impl->sqes) {
+        munmap(impl->sqes, impl->sqes_size);
+    }
+    if (impl->cq_ptr && (impl->cq_ptr != impl->sq_ptr)) {
+        munmap(impl->cq_ptr, impl->cq_size);
+    }
+    munmap(impl->sq_ptr, impl->sq_size);
+    if (impl->buf_ring) {
+        munmap(impl->buf_ring, impl->buf_ring_size);
+    }
+    if (impl->buffers) {
+        knet_free(impl->buffers);
+    }
+    /* ٹ¶ */
+    while (impl->orphan_list) {
+        per_sock = impl->orphan_list;
+        impl->orphan_list = per_sock->next;
+        socket_data_destroy(per_sock);
+    }
+    knet_free(impl);
+}
+
+int uring_enter(loop_uring_t* impl, int wait, time_t timeout) {
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec      ts;
+    unsigned int                  submit = 0;
+    unsigned int                  flags  = 0;
+    int                           error  = 0;
+    /* ύ */
+    __atomic_store_n(impl->sq_tail, impl->sq_local_tail, __ATOMIC_RELEASE);
+    submit = impl->sq_local_tail - __atomic_load_n(impl->sq_head, __ATOMIC_ACQUIRE);
+    if (!submit && !wait) {
+        return error_ok;
+    }
+    memset(&arg, 0, sizeof(arg));
+    if (wait) {
+        flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        if (timeout >= 0) {
+            ts.tv_sec  = timeout / 1000000;
+            ts.tv_nsec = (long long)(timeout % 1000000) * 1000;
+            arg.ts     = (uint64_t)(uintptr_t)&ts;
+        }
+    }
+    error = (int)syscall(__NR_io_uring_enter, impl->ring_fd, submit, wait ? 1 : 0, flags, &arg, sizeof(arg));
+    if (error < 0) {
+        if ((errno == ETIME) || (errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY)) {
+            /* ʱ, źжϻɶҪȴ¼ */
+            return error_ok;
+        }
+        log_error("io_uring_enter() failed, system error: %d", sys_get_errno());
+        return error_loop_fail;
+    }
+    return error_ok;
+}
+
+struct io_uring_sqe* uring_get_sqe(loop_uring_t* impl, per_io_t* per_io) {
+    struct io_uring_sqe* sqe   = 0;
+    unsigned int         index = 0;
+    if (impl->sq_local_tail - __atomic_load_n(impl->sq_head, __ATOMIC_ACQUIRE) >= impl->sq_entries) {
+        /* ύ, ύѾ */
+        uring_enter(impl, 0, 0);
+        if (impl->sq_local_tail - __atomic_load_n(impl->sq_head, __ATOMIC_ACQUIRE) >= impl->sq_entries) {
+            log_error("io_uring submission queue full");
+            return 0;
+        }
+    }
+    index = impl->sq_local_tail & *impl->sq_mask;
+    sqe = &impl->sqes[index];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->user_data = (uint64_t)(uintptr_t)per_io;
+    impl->sq_array[index] = index;
+    impl->sq_local_tail++;
+    return sqe;
+}
+
+int uring_post(kchannel_ref_t* channel_ref, per_io_t* per_io) {
+    struct io_uring_sqe* sqe      = 0;
+    per_sock_t*          per_sock = per_io->per_sock;
+    loop_uring_t*        impl     = get_impl(knet_channel_ref_get_loop(channel_ref));
+    if (per_io->pending) {
+        return error_ok;
+    }
+    sqe = uring_get_sqe(impl, per_io);
+    if (!sqe) {
+        return error_loop_fail;
+    }
+    sqe->fd = knet_channel_ref_get_socket_fd(channel_ref);
+    switch (per_io->type) {
+    case io_type_accept: /* һͶ, ÿӲһ¼ */
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        break;
+    case io_type_recv: /* һͶ, ںѡȡջ, ÿνղһ¼ */
+        sqe->opcode    = IORING_OP_RECV;
+        sqe->ioprio    = IORING_RECV_MULTISHOT;
+        sqe->flags     = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = URING_BUFFER_GROUP;
+        break;
+    case io_type_send:
+        sqe->opcode    = IORING_OP_SEND;
+        sqe->addr      = (uint64_t)(uintptr_t)(per_sock->send_buffer + per_sock->send_pos);
+        sqe->len       = per_sock->send_len - per_sock->send_pos;
+        sqe->msg_flags = MSG_NOSIGNAL;
+        break;
+    case io_type_poll: /* ȴ */
+        sqe->opcode        = IORING_OP_POLL_ADD;
+        sqe->poll32_events = POLLOUT;
+        break;
+    default:
+        verify(0);
+        break;
+    }
+    per_io->pending = 1;
+    /* ǰܱܵ */
+    knet_channel_ref_incref(channel_ref);
+    return error_ok;
+}
+
+void uring_cancel(loop_uring_t* impl, per_io_t* per_io) {
+    struct io_uring_sqe* sqe = 0;
+    if (!per_io->pending) {
+        return;
+    }
+    /* ȡ¼, ȡ¼ڼü */
+    sqe = uring_get_sqe(impl, 0);
+    if (!sqe) {
+        return;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd     = -1;
+    sqe->addr   = (uint64_t)(uintptr_t)per_io;
+}
+
+void uring_queue_send(loop_uring_t* impl, per_sock_t* per_sock) {
+    if (per_sock->send_queued || per_sock->io_send.pending) {
+        /* Ѿڻڷ, ɺ鷢ͻ */
+        return;
+    }
+    per_sock->send_queued = 1;
+    per_sock->next        = impl->send_list;
+    impl->send_list       = per_sock;
+}
+
+void uring_flush_send(loop_uring_t* impl) {
+    per_sock_t*     per_sock    = 0;
+    kchannel_ref_t* channel_ref = 0;
+    ksend_queue_t*  queue       = 0;
+    uint64_t        size        = 0;
+    while (impl->send_list) {
+        per_sock = impl->send_list;
+        impl->send_list = per_sock->next;
+        per_sock->next = 0;
+        per_sock->send_queued = 0;
+        channel_ref = per_sock->channel_ref;
+        if (!channel_ref || knet_channel_ref_check_state(channel_ref, channel_state_close)) {
+            continue;
+        }
+        if (per_sock->send_pos == per_sock->send_len) {
+            /*
+             * Ͷͷ, ͬһֵܵĶдϲΪһsend.
+             * ڷɺŴӶƳ, Ͷзǿʱдݲᱻֱӷ, ֤˳
+             */
+            queue = knet_channel_ref_get_send_queue(channel_ref);
+            size = send_queue_get_pending_bytes(queue);
+            if (!size) {
+                continue;
+            }
+            if (size > URING_SEND_SIZE) {
+                size = URING_SEND_SIZE;
+            }
+            if (size > per_sock->send_max) {
+                per_sock->send_buffer = knet_rcreate_raw(per_sock->send_buffer, (uint32_t)size);
+                verify(per_sock->send_buffer);
+                per_sock->send_max = (uint32_t)size;
+            }
+            per_sock->send_pos = 0;
+            per_sock->send_len = send_queue_copy(queue, per_sock->send_buffer, (uint32_t)size);
+        }
+        uring_post(channel_ref, &per_sock->io_send);
+    }
+}
+
+void uring_complete(kloop_t* loop, struct io_uring_cqe* cqe, time_t ts) {
+    per_io_t*       per_io      = (per_io_t*)(uintptr_t)cqe->user_data;
+    per_sock_t*     per_sock    = per_io->per_sock;
+    kchannel_ref_t* channel_ref = per_sock->channel_ref;
+    loop_uring_t*   impl        = get_impl(loop);
+    int             more        = (cqe->flags & IORING_CQE_F_MORE);
+    int             res         = cqe->res;
+    unsigned short  bid         = 0;
+    if (!more) {
+        /*  */
+        per_io->pending = 0;
+    }
+    if (channel_ref && knet_channel_ref_check_state(channel_ref, channel_state_close)) {
+        channel_ref = 0;
+    }
+    switch (per_io->type) {
+    case io_type_accept:
+        if (res >= 0) {
+            if (channel_ref) {
+                /* knet_impl_channel_acceptȡ */
+                per_sock->accept_fd = res;
+                knet_channel_ref_update(channel_ref, channel_event_recv, ts);
+            }
+            if (per_sock->accept_fd > 0) {
+                socket_close(per_sock->accept_fd);
+                per_sock->accept_fd = 0;
+            }
+        }
+        break;
+    case io_type_recv:
+        if (cqe->flags & IORING_CQE_F_BUFFER) {
+            bid = (unsigned short)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+            if (channel_ref && (res > 0)) {
+                knet_channel_ref_update_recv_buffer(channel_ref, impl->buffers + (size_t)bid * URING_BUFFER_SIZE, res, ts);
+            }
+            uring_buffer_recycle(impl, bid);
+        } else if (channel_ref && ((res == 0) || ((res < 0) && (res != -ENOBUFS) && (res != -ECANCELED)))) {
+            /* Զ˹رջ */
+            knet_channel_ref_close_check_reconnect(channel_ref);
+        }
+        break;
+    case io_type_send:
+        if (!channel_ref) {
+            break;
+        }
+        if (res < 0) {
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            break;
+        }
+        per_sock->send_pos += (uint32_t)res;
+        send_queue_eat(knet_channel_ref_get_send_queue(channel_ref), (uint32_t)res);
+        if ((per_sock->send_pos < per_sock->send_len) ||
+            !send_queue_empty(knet_channel_ref_get_send_queue(channel_ref))) {
+            /*  */
+            uring_queue_send(impl, per_sock);
+            knet_channel_ref_check_send_watermark(channel_ref);
+        } else {
+            /* ȫ */
+            knet_channel_ref_update(channel_ref, channel_event_send, ts);
+        }
+        break;
+    case io_type_poll:
+        if (channel_ref && (res > 0) && !(res & (POLLERR | POLLHUP))) {
+            /* , ʧʱȴӳʱ */
+            knet_channel_ref_update(channel_ref, channel_event_send, ts);
+        }
+        break;
+    default:
+        break;
+    }
+    if (more) {
+        return;
+    }
+    channel_ref = per_sock->channel_ref;
+    if (!channel_ref) {
+        /* ܵѾ */
+        return;
+    }
+    /* δںֹ(绺ľ), Ͷ */
+    if ((per_io->type == io_type_accept) &&
+        knet_channel_ref_check_state(channel_ref, channel_state_accept) &&
+        knet_channel_ref_check_event(channel_ref, channel_event_recv)) {
+        uring_post(channel_ref, per_io);
+    } else if ((per_io->type == io_type_recv) &&
+        knet_channel_ref_check_state(channel_ref, channel_state_active) &&
+        knet_channel_ref_check_event(channel_ref, channel_event_recv)) {
+        uring_post(channel_ref, per_io);
+    }
+    /* , ü */
+    knet_channel_ref_decref(channel_ref);
+}
+
+int _select(kloop_t* loop, int* count) {
+    struct io_uring_cqe cqe;
+    unsigned int        head  = 0;
+    int                 wait  = 1;
+    int                 error = error_ok;
+    time_t              ts    = 0;
+    loop_uring_t*       impl  = get_impl(loop);
+    *count = 0;
+    /* ύд */
+    uring_flush_send(impl);
+    head = *impl->cq_head;
+    if (head != __atomic_load_n(impl->cq_tail, __ATOMIC_ACQUIRE)) {
+        /* Ѿ¼, Ҫȴ */
+        wait = 0;
+    }
+    /* һϵͳύ͵ȴ, ȴʱȷ΢, ߾ȶʱҪtimerfd */
+    error = uring_enter(impl, wait, knet_loop_get_wait_timeout_us(loop));
+    if (error != error_ok) {
+        return error;
+    }
+    ts = time(0);
+    for (; head != __atomic_load_n(impl->cq_tail, __ATOMIC_ACQUIRE); ) {
+        cqe = impl->cqes[head & *impl->cq_mask];
+        head++;
+        /* ȹ黹ɶԪ, пܻύµ */
+        __atomic_store_n(impl->cq_head, head, __ATOMIC_RELEASE);
+        if (!cqe.user_data) {
+            /* ȡ */
+            continue;
+        }
+        uring_complete(loop, &cqe, ts);
+        (*count)++;
+    }
+    return error_ok;
+}
+
+int knet_impl_run_once(kloop_t* loop) {
+    int    count         = 0;
+    int    timeout_count = 0;
+    int    error         = _select(loop, &count);
+    if (error != error_ok) {
+        return error;
+    }
+    timeout_count = knet_loop_check_timeout(loop, time(0));
+    knet_loop_profile_increase_wakeup_count(knet_loop_get_profile(loop));
+    if (!count && !timeout_count) {
+        knet_loop_profile_increase_empty_wakeup_count(knet_loop_get_profile(loop));
+    }
+    knet_loop_check_close(loop);
+    return error_ok;
+}
+
+int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    per_sock_t* per_sock = get_data(channel_ref);
+    verify(per_sock);
+    if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
+        return error_already_close;
+    }
+    if (e & channel_event_recv) {
+        if (!per_sock->io_recv.pending) {
+            /* ܵͶaccept, ܵͶrecv */
+            if (knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+                per_sock->io_recv.type = io_type_accept;
+            } else {
+                per_sock->io_recv.type = io_type_recv;
+            }
+        }
+        uring_post(channel_ref, &per_sock->io_recv);
+    }
+    if (e & channel_event_send) {
+        if (knet_channel_ref_check_state(channel_ref, channel_state_connect)) {
+            /* ȴ */
+            uring_post(channel_ref, &per_sock->io_poll);
+        } else {
+            /* ´io_uring_enterǰύ */
+            uring_queue_send(get_impl(knet_channel_ref_get_loop(channel_ref)), per_sock);
+        }
+    }
+    return error_ok;
+}
+
+int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    per_sock_t*   per_sock = get_data(channel_ref);
+    loop_uring_t* impl     = get_impl(knet_channel_ref_get_loop(channel_ref));
+    verify(per_sock);
+    if (e & channel_event_recv) {
+        uring_cancel(impl, &per_sock->io_recv);
+    }
+    if (e & channel_event_send) {
+        uring_cancel(impl, &per_sock->io_poll);
+        uring_cancel(impl, &per_sock->io_send);
+    }
+    return error_ok;
+}
+
+int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    verify(loop);
+    verify(channel_ref);
+    if (!get_data(channel_ref)) {
+        knet_channel_ref_set_data(channel_ref, socket_data_create(channel_ref));
+    }
+    return error_ok;
+}
+
+int knet_impl_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    per_sock_t*   per_sock = get_data(channel_ref);
+    per_sock_t**  prev     = 0;
+    loop_uring_t* impl     = get_impl(loop);
+    if (!per_sock) {
+        return error_ok;
+    }
+    knet_channel_ref_set_data(channel_ref, 0);
+    per_sock->channel_ref = 0;
+    if (per_sock->send_queued) {
+        /* ӵȴɾ */
+        for (prev = &impl->send_list; *prev; prev = &(*prev)->next) {
+            if (*prev == per_sock) {
+                *prev = per_sock->next;
+                break;
+            }
+        }
+        per_sock->next = 0;
+        per_sock->send_queued = 0;
+    }
+    if (per_sock->io_recv.pending || per_sock->io_send.pending || per_sock->io_poll.pending) {
+        /* ں˿ʹ, ѡȡʱ */
+        per_sock->next = impl->orphan_list;
+        impl->orphan_list = per_sock;
+        return error_ok;
+    }
+    socket_data_destroy(per_sock);
+    return error_ok;
+}
+
+socket_t knet_impl_channel_accept(kchannel_ref_t* channel_ref) {
+    socket_t    client_fd = 0;
+    per_sock_t* per_sock  = get_data(channel_ref);
+    verify(per_sock);
+    client_fd = per_sock->accept_fd;
+    per_sock->accept_fd = 0;
+    return client_fd;
+}
+
+#endif /* LOOP_URING */
@@ -22,6 +22,9 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE /* accept4 */
+#endif /* defined(__linux__) && !defined(_GNU_SOURCE) */
 #include <stdarg.h>
 #if (!defined(_WIN32) && !defined(_WIN64))
     #if __APPLE__
@@ -45,6 +48,7 @@ struct _thread_runner_t {
     knet_thread_func_t func;         /* 线程函数 */
     void*              params;       /* 单参数 */
     kdlist_t*          multi_params; /* 多参数 */
+    int                loop_type;    /* 单参数为循环时的类型, 参见loop_type_e */
     volatile int       running;      /* 运行标志 */
     volatile int       stop;         /* 退出标志 */
     thread_id_t        thread_id;    /* 线程ID */
@@ -314,6 +318,35 @@ socket_t socket_accept6(socket_t socket_fd) {
     return client_fd;
 }
 
+socket_t socket_accept_nonblock(socket_t socket_fd, struct sockaddr* sa, socket_len_t* len) {
+    socket_t client_fd = 0; /* 客户端套接字 */
+#if defined(__linux__) && defined(SOCK_NONBLOCK)
+    /* 一次系统调用得到非阻塞套接字 */
+    client_fd = accept4(socket_fd, sa, len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+    client_fd = accept(socket_fd, sa, len);
+#endif /* defined(__linux__) && defined(SOCK_NONBLOCK) */
+#if (defined(_WIN32) || defined(_WIN64))
+    if (INVALID_SOCKET == client_fd) {
+        if (WSAEWOULDBLOCK != sys_get_errno()) {
+            log_error("accept() failed, system error: %d", sys_get_errno());
+        }
+        return 0;
+    }
+#else
+    if (client_fd < 0) {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+            log_error("accept() failed, system error: %d", sys_get_errno());
+        }
+        return 0;
+    }
+#endif /* defined(_WIN32) || defined(_WIN64) */
+#if !(defined(__linux__) && defined(SOCK_NONBLOCK))
+    socket_set_non_blocking_on(client_fd);
+#endif /* !(defined(__linux__) && defined(SOCK_NONBLOCK)) */
+    return client_fd;
+}
+
 int socket_set_reuse_addr_on(socket_t socket_fd) {
     int reuse_addr = 1;
     return setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse_addr , sizeof(reuse_addr));
@@ -391,6 +424,62 @@ int socket_set_keepalive_off(socket_t socket_fd) {
     return setsockopt(socket_fd, SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, sizeof(keepalive));
 }
 
+int socket_set_keepalive_on(socket_t socket_fd, int idle) {
+    int keepalive = 1;
+    if (setsockopt(socket_fd, SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, sizeof(keepalive))) {
+        return -1;
+    }
+    if (!idle) {
+        return 0;
+    }
+#if defined(TCP_KEEPIDLE)
+    return setsockopt(socket_fd, IPPROTO_TCP, TCP_KEEPIDLE, (char*)&idle, sizeof(idle));
+#elif defined(TCP_KEEPALIVE) /* __APPLE__ */
+    return setsockopt(socket_fd, IPPROTO_TCP, TCP_KEEPALIVE, (char*)&idle, sizeof(idle));
+#else
+    return -1;
+#endif /* defined(TCP_KEEPIDLE) */
+}
+
+int socket_set_linger_on(socket_t socket_fd, int seconds) {
+    struct linger linger;
+    memset(&linger, 0, sizeof(linger));
+    linger.l_onoff  = 1;
+    linger.l_linger = seconds;
+    return setsockopt(socket_fd, SOL_SOCKET, SO_LINGER, (char*)&linger, sizeof(linger));
+}
+
+int socket_set_defer_accept(socket_t socket_fd, int seconds) {
+#if defined(TCP_DEFER_ACCEPT)
+    return setsockopt(socket_fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, (char*)&seconds, sizeof(seconds));
+#else
+    (void)socket_fd;
+    (void)seconds;
+    return -1;
+#endif /* defined(TCP_DEFER_ACCEPT) */
+}
+
+int socket_set_quickack(socket_t socket_fd, int on) {
+#if defined(TCP_QUICKACK)
+    return setsockopt(socket_fd, IPPROTO_TCP, TCP_QUICKACK, (char*)&on, sizeof(on));
+#else
+    (void)socket_fd;
+    (void)on;
+    return -1;
+#endif /* defined(TCP_QUICKACK) */
+}
+
+int socket_set_user_timeout(socket_t socket_fd, uint32_t ms) {
+#if defined(TCP_USER_TIMEOUT)
+    unsigned int timeout = ms;
+    return setsockopt(socket_fd, IPPROTO_TCP, TCP_USER_TIMEOUT, (char*)&timeout, sizeof(timeout));
+#else
+    (void)socket_fd;
+    (void)ms;
+    return -1;
+#endif /* defined(TCP_USER_TIMEOUT) */
+}
+
 int socket_set_reuseport_on(socket_t socket_fd) {
 #if (defined(_WIN32) || defined(_WIN64))
     return -1;
@@ -431,6 +520,59 @@ int socket_check_send_ready(socket_t socket_fd) {
 #endif /* defined(_WIN32) || defined(_WIN64) */    
 }
 
+int socket_sendv(socket_t socket_fd, const kiovec_t* iov, int count) {
+    int           i          = 0;
+    int           size       = 0;
+#if (defined(_WIN32) || defined(_WIN64))
+    WSABUF        vec[SOCKET_IOV_MAX];
+    DWORD         send_bytes = 0;
+    DWORD         error      = 0;
+#else
+    struct iovec  vec[SOCKET_IOV_MAX];
+    struct msghdr msg;
+    int           send_bytes = 0;
+#endif /* defined(_WIN32) || defined(_WIN64) */
+    verify(iov);
+    verify((count > 0) && (count <= SOCKET_IOV_MAX));
+    for (; i < count; i++) {
+#if (defined(_WIN32) || defined(_WIN64))
+        vec[i].buf = (CHAR*)iov[i].data;
+        vec[i].len = (ULONG)iov[i].size;
+#else
+        vec[i].iov_base = (void*)iov[i].data;
+        vec[i].iov_len  = (size_t)iov[i].size;
+#endif /* defined(_WIN32) || defined(_WIN64) */
+        size += iov[i].size;
+    }
+#if (defined(_WIN32) || defined(_WIN64))
+    if (SOCKET_ERROR == WSASend(socket_fd, vec, (DWORD)count, &send_bytes, 0, 0, 0)) {
+        error = WSAGetLastError();
+        if ((error == WSAEINTR) || (error == WSAEINPROGRESS) || (error == WSAEWOULDBLOCK)) {
+            return 0;
+        }
+        log_error("WSASend() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return (int)send_bytes;
+#else
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = vec;
+    msg.msg_iovlen = count;
+    send_bytes = (int)sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
+    if (send_bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("sendmsg() failed, system error: %d", sys_get_errno());
+        return -1;
+    } else if (!send_bytes && size) {
+        log_error("sendmsg() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return send_bytes;
+#endif /* defined(_WIN32) || defined(_WIN64) */
+}
+
 int socket_send(socket_t socket_fd, const char* data, uint32_t size) {
     int send_bytes = 0;
 #if (defined(_WIN32) || defined(_WIN64))
@@ -495,6 +637,62 @@ int socket_recv(socket_t socket_fd, char* data, uint32_t size) {
     return recv_bytes;
 }
 
+int socket_recvv(socket_t socket_fd, const kiovec_t* iov, int count) {
+    int           i          = 0;
+#if (defined(_WIN32) || defined(_WIN64))
+    WSABUF        vec[SOCKET_IOV_MAX];
+    DWORD         recv_bytes = 0;
+    DWORD         flags      = 0;
+    DWORD         error      = 0;
+#else
+    struct iovec  vec[SOCKET_IOV_MAX];
+    struct msghdr msg;
+    int           recv_bytes = 0;
+#endif /* defined(_WIN32) || defined(_WIN64) */
+    verify(iov);
+    verify((count > 0) && (count <= SOCKET_IOV_MAX));
+    for (; i < count; i++) {
+#if (defined(_WIN32) || defined(_WIN64))
+        vec[i].buf = (CHAR*)iov[i].data;
+        vec[i].len = (ULONG)iov[i].size;
+#else
+        vec[i].iov_base = (void*)iov[i].data;
+        vec[i].iov_len  = (size_t)iov[i].size;
+#endif /* defined(_WIN32) || defined(_WIN64) */
+    }
+#if (defined(_WIN32) || defined(_WIN64))
+    if (SOCKET_ERROR == WSARecv(socket_fd, vec, (DWORD)count, &recv_bytes, &flags, 0, 0)) {
+        error = WSAGetLastError();
+        if ((error == WSAEINTR) || (error == WSAEINPROGRESS) || (error == WSAEWOULDBLOCK)) {
+            return 0;
+        }
+        log_error("WSARecv() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    if (!recv_bytes) {
+        log_error("WSARecv() failed, return 0, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return (int)recv_bytes;
+#else
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = vec;
+    msg.msg_iovlen = count;
+    recv_bytes = (int)recvmsg(socket_fd, &msg, MSG_NOSIGNAL);
+    if (recv_bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("recvmsg() failed, system error: %d", sys_get_errno());
+        return -1;
+    } else if (recv_bytes == 0) {
+        log_error("recvmsg() failed, return 0, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return recv_bytes;
+#endif /* defined(_WIN32) || defined(_WIN64) */
+}
+
 #if (defined(_WIN32) || defined(_WIN64))
 u_short _get_random_port(int begin, int gap) {
     srand((int)time(0));
@@ -602,68 +800,36 @@ error_return:
 }
 
 int socket_getpeername(kchannel_ref_t* channel_ref, kaddress_t* address) {
-    char ip[32] = {0};
-    struct sockaddr_in addr[2];
-    int port;
+    struct sockaddr_storage addr;
     socket_len_t len = sizeof(addr);
     int retval = getpeername(knet_channel_ref_get_socket_fd(channel_ref), (struct sockaddr*)&addr, &len);
     if (retval < 0) {
-        port = sys_get_errno();
         log_error("getpeername() failed, system error: %d", sys_get_errno());
         return error_getpeername;
     }
-    inet_ntop(AF_INET, &addr[0].sin_addr, ip, sizeof(ip));
-    port = ntohs(addr[0].sin_port);
-    knet_address_set(address, ip, port);
+    /* IP字符串在第一次取得时生成 */
+    knet_address_set_sockaddr(address, (struct sockaddr*)&addr);
     return error_ok;
 }
 
 int socket_getpeername6(kchannel_ref_t* channel_ref, kaddress_t* address) {
-    char ip[128] = { 0 };
-    struct sockaddr_in6 addr;
-    int port;
-    socket_len_t len = sizeof(addr);
-    int retval = getpeername(knet_channel_ref_get_socket_fd(channel_ref), (struct sockaddr*)&addr, &len);
-    if (retval < 0) {
-        log_error("getpeername() failed, system error: %d", sys_get_errno());
-        return error_getpeername;
-    }
-    inet_ntop(AF_INET6, &addr.sin6_addr, ip, sizeof(ip));
-    port = ntohs(addr.sin6_port);
-    knet_address_set(address, ip, port);
-    return error_ok;
+    return socket_getpeername(channel_ref, address);
 }
 
 int socket_getsockname(kchannel_ref_t* channel_ref,kaddress_t* address) {
-    char ip[32] = { 0 };
-    struct sockaddr_in addr;
-    int port;
+    struct sockaddr_storage addr;
     socket_len_t len = sizeof(addr);
     int retval = getsockname(knet_channel_ref_get_socket_fd(channel_ref), (struct sockaddr*)&addr, &len);
     if (retval < 0) {
         log_error("getsockname() failed, system error: %d", sys_get_errno());
         return error_getpeername;
     }
-    inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
-    port = ntohs(addr.sin_port);
-    knet_address_set(address, ip, port);
+    knet_address_set_sockaddr(address, (struct sockaddr*)&addr);
     return error_ok;
 }
 
 int socket_getsockname6(kchannel_ref_t* channel_ref, kaddress_t* address) {
-    char ip[128] = { 0 };
-    struct sockaddr_in6 addr;
-    int port;
-    socket_len_t len = sizeof(addr);
-    int retval = getsockname(knet_channel_ref_get_socket_fd(channel_ref), (struct sockaddr*)&addr, &len);
-    if (retval < 0) {
-        log_error("getsockname() failed, system error: %d", sys_get_errno());
-        return error_getpeername;
-    }
-    inet_ntop(AF_INET6, &addr.sin6_addr, ip, sizeof(ip));
-    port = ntohs(addr.sin6_port);
-    knet_address_set(address, ip, port);
-    return error_ok;
+    return socket_getsockname(channel_ref, address);
 }
 
 atomic_counter_t atomic_counter_inc(atomic_counter_t* counter) {
@@ -704,6 +870,33 @@ int atomic_counter_zero(atomic_counter_t* counter) {
     return (*counter == 0);
 }
 
+void* atomic_ptr_exchange(void* volatile* ptr, void* value) {
+#if (defined(_WIN32) || defined(_WIN64))
+    return InterlockedExchangePointer((PVOID volatile*)ptr, value);
+#else
+    return __atomic_exchange_n(ptr, value, __ATOMIC_ACQ_REL);
+#endif /* defined(_WIN32) || defined(_WIN64) */
+}
+
+void* atomic_ptr_load(void* volatile* ptr) {
+#if (defined(_WIN32) || defined(_WIN64))
+    void* value = *ptr;
+    MemoryBarrier();
+    return value;
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif /* defined(_WIN32) || defined(_WIN64) */
+}
+
+void atomic_ptr_store(void* volatile* ptr, void* value) {
+#if (defined(_WIN32) || defined(_WIN64))
+    MemoryBarrier();
+    *ptr = value;
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif /* defined(_WIN32) || defined(_WIN64) */
+}
+
 struct _lock_t {
     #if (defined(_WIN32) || defined(_WIN64))
         CRITICAL_SECTION lock;
@@ -821,9 +1014,8 @@ void _thread_loop_func(void* params) {
 void _thread_timer_loop_func(void* params) {
     kthread_runner_t* runner = (kthread_runner_t*)params;
     ktimer_loop_t* loop = (ktimer_loop_t*)runner->params;
-    int tick = (int)ktimer_loop_get_tick_intval(loop);
     while (thread_runner_check_start(runner)) {
-        thread_sleep_ms(tick);
+        ktimer_loop_sleep(loop);
         ktimer_loop_run_once(loop);
     }
     runner->stop = 1;
@@ -935,8 +1127,9 @@ int thread_runner_start_loop(kthread_runner_t* runner, kloop_t* loop, int stack_
 #endif /* defined(_WIN32) || defined(_WIN64) */
     verify(runner);
     verify(loop);
-    runner->params = loop;
-    runner->running = 1;
+    runner->params    = loop;
+    runner->loop_type = loop_type_loop;
+    runner->running   = 1;
 #if (defined(_WIN32) || defined(_WIN64))
     retval = _beginthread(thread_loop_func_win, stack_size, runner);
     if (retval <= 0) {
@@ -970,8 +1163,9 @@ int thread_runner_start_timer_loop(kthread_runner_t* runner, ktimer_loop_t* time
 #endif /* defined(_WIN32) || defined(_WIN64) */
     verify(runner);
     verify(timer_loop);
-    runner->params = timer_loop;
-    runner->running = 1;
+    runner->params    = timer_loop;
+    runner->loop_type = loop_type_timer;
+    runner->running   = 1;
 #if (defined(_WIN32) || defined(_WIN64))
     retval = _beginthread(thread_timer_loop_func_win, stack_size, runner);
     if (retval <= 0) {
@@ -1015,6 +1209,8 @@ int thread_runner_start_multi_loop_varg(kthread_runner_t* runner, int stack_size
             param = knet_create(thread_param_t);
             param->type = loop_type_loop;
             param->loop = va_arg(arg_ptr, kloop_t*);
+            /* 多个循环轮流运行, 不能让某个选取器长时间等待 */
+            knet_loop_set_max_wait((kloop_t*)param->loop, 1);
             dlist_add_tail_node(runner->multi_params, param);
             break;
         case 't':
@@ -1057,6 +1253,10 @@ int thread_runner_start_multi_loop_varg(kthread_runner_t* runner, int stack_size
 void thread_runner_stop(kthread_runner_t* runner) {
     verify(runner);
     runner->running = 0;
+    if (runner->loop_type == loop_type_loop) {
+        /* 选取器可能在等待事件, 唤醒后才能检查到退出标志 */
+        knet_loop_notify((kloop_t*)runner->params);
+    }
 }
 
 thread_id_t thread_runner_get_id(kthread_runner_t* runner) {
@@ -1119,6 +1319,14 @@ void thread_sleep_ms(int ms) {
 #endif /* defined(_WIN32) || defined(_WIN64) */
 }
 
+void thread_sleep_us(int us) {
+#if (defined(_WIN32) || defined(_WIN64))
+    Sleep((us + 999) / 1000);
+#else
+    usleep(us);
+#endif /* defined(_WIN32) || defined(_WIN64) */
+}
+
 int thread_set_tls_data(kthread_runner_t* runner, void* data) {
     verify(runner);
     if (!runner->tls_key) {
@@ -1177,6 +1385,12 @@ uint64_t time_get_milliseconds_19700101() {
     return (uint64_t)tp.tv_sec * 1000llu + (uint64_t)tp.tv_usec / 1000llu;
 }
 
+uint64_t time_get_microseconds_19700101() {
+    struct timeval tp;
+    time_gettimeofday(&tp, 0);
+    return (uint64_t)tp.tv_sec * 1000000llu + (uint64_t)tp.tv_usec;
+}
+
 void knet_localtime(struct tm* tm, const time_t* time) {
 #if defined(CYGWIN)
     localtime_r(time, tm);
@@ -1324,6 +1538,14 @@ const char* get_channel_cb_event_string(knet_channel_cb_event_e e) {
         return "channel idle timeout because there is no bytes received according to the idle timeout setting";
     case channel_cb_event_connect_timeout:
         return "channel try to connect remote host failed because the connect timeout setting reached";
+    case channel_cb_event_recv_throttle:
+        return "channel stopped reading because received bytes reached the high watermark";
+    case channel_cb_event_recv_resume:
+        return "channel resumed reading because received bytes dropped to the low watermark";
+    case channel_cb_event_send_high:
+        return "bytes waiting to be sent reached the high watermark";
+    case channel_cb_event_send_drained:
+        return "bytes waiting to be sent dropped to the low watermark";
     }
     return "unknown channel callback event";
 }
@@ -1344,6 +1566,14 @@ const char* get_channel_cb_event_name(knet_channel_cb_event_e e) {
         return "channel_cb_event_timeout";
     case channel_cb_event_connect_timeout:
         return "channel_cb_event_connect_timeout";
+    case channel_cb_event_recv_throttle:
+        return "channel_cb_event_recv_throttle";
+    case channel_cb_event_recv_resume:
+        return "channel_cb_event_recv_resume";
+    case channel_cb_event_send_high:
+        return "channel_cb_event_send_high";
+    case channel_cb_event_send_drained:
+        return "channel_cb_event_send_drained";
     }
     return "unknown channel callback event";
 }
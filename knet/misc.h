@@ -100,6 +100,17 @@ socket_t socket_accept(socket_t socket_fd);
  */
 socket_t socket_accept6(socket_t socket_fd);
 
+/**
+ * ӲȡöԶ˵ַ, ûʱ¼, ѭֱû
+ * ص׽Ƿ, Linuxʹaccept4ͬһϵͳ
+ * @param socket_fd ׽
+ * @param sa Զ˵ַ
+ * @param len ǰΪsaĳ, غΪԶ˵ַ
+ * @retval 0 ûӻʧ
+ * @retval Ч׽
+ */
+socket_t socket_accept_nonblock(socket_t socket_fd, struct sockaddr* sa, socket_len_t* len);
+
 /**
  * ر׽֣ǿƹرգ
  * @param socket_fd ׽
@@ -154,6 +165,55 @@ int socket_set_linger_off(socket_t socket_fd);
  */
 int socket_set_keepalive_off(socket_t socket_fd);
 
+/**
+ * keep-alive
+ * @param socket_fd
+ * @param idle ӿжúʼ̽룩, Ϊ0ʱʹϵͳĬֵ
+ * @retval 0 ɹ
+ * @retval  ʧ
+ */
+int socket_set_keepalive_on(socket_t socket_fd, int idle);
+
+/**
+ * linger
+ *
+ * رʱȴָʱ䷢δ͵
+ * @param socket_fd
+ * @param seconds ȴʱ䣨룩
+ * @retval 0 ɹ
+ * @retval  ʧ
+ */
+int socket_set_linger_on(socket_t socket_fd, int seconds);
+
+/**
+ * TCP_DEFER_ACCEPT, ֻԼ׽Ч
+ *
+ * ӽյݲŻaccept(), ֵ֧ƽ̨ʧ
+ * @param socket_fd
+ * @param seconds ȴʱ䣨룩
+ * @retval 0 ɹ
+ * @retval  ʧ
+ */
+int socket_set_defer_accept(socket_t socket_fd, int seconds);
+
+/**
+ * TCP_QUICKACK, ֵ֧ƽ̨ʧ
+ * @param socket_fd
+ * @param on ǷACK
+ * @retval 0 ɹ
+ * @retval  ʧ
+ */
+int socket_set_quickack(socket_t socket_fd, int on);
+
+/**
+ * TCP_USER_TIMEOUT, ֵ֧ƽ̨ʧ
+ * @param socket_fd
+ * @param ms ѷδȷϵʱ䣨룩, ʱӱر
+ * @retval 0 ɹ
+ * @retval  ʧ
+ */
+int socket_set_user_timeout(socket_t socket_fd, uint32_t ms);
+
 /**
  * reuseport
  * @param socket_fd
@@ -198,6 +258,18 @@ int socket_set_send_buffer_size(socket_t socket_fd, int size);
  */
 int socket_send(socket_t socket_fd, const char* data, uint32_t size);
 
+#define SOCKET_IOV_MAX 64 /* socket_sendvε෢͵ݿ */
+
+/**
+ * ɢ, һϵͳ÷Ͷݿ
+ * @param socket_fd
+ * @param iov ݿ
+ * @param count ݿ, ܳSOCKET_IOV_MAX
+ * @retval >=0 ʵʷ͵ֽ, 0ʾͻ
+ * @retval <0 ʧ
+ */
+int socket_sendv(socket_t socket_fd, const kiovec_t* iov, int count);
+
 /**
  * 
  * @param socket_fd
@@ -208,6 +280,17 @@ int socket_send(socket_t socket_fd, const char* data, uint32_t size);
  */
 int socket_recv(socket_t socket_fd, char* data, uint32_t size);
 
+/**
+ * ɢ, һϵͳ
+ * @param socket_fd
+ * @param iov , дiov[i].dataָڴ
+ * @param count , ܳSOCKET_IOV_MAX
+ * @retval >0 ʵʽյֽ
+ * @retval 0 ջΪ, ´μ
+ * @retval <0 ʧܻԶ˹ر
+ */
+int socket_recvv(socket_t socket_fd, const kiovec_t* iov, int count);
+
 /**
  * socketpair
  * @sa socketpair
@@ -245,4 +328,26 @@ int socket_getsockname6(kchannel_ref_t* channel_ref, kaddress_t* address);
  */
 int socket_check_send_ready(socket_t socket_fd);
 
+/**
+ * ԭӲ - ָ
+ * @param ptr ַָ
+ * @param value ֵ
+ * @return ǰֵ
+ */
+void* atomic_ptr_exchange(void* volatile* ptr, void* value);
+
+/**
+ * ԭӲ - ȡָ(acquire)
+ * @param ptr ַָ
+ * @return ֵָ
+ */
+void* atomic_ptr_load(void* volatile* ptr);
+
+/**
+ * ԭӲ - дָ(release)
+ * @param ptr ַָ
+ * @param value ֵ
+ */
+void atomic_ptr_store(void* volatile* ptr, void* value);
+
 #endif /* MISC_H */
@@ -42,6 +42,11 @@ extern uint64_t time_get_microseconds();
  */
 extern uint64_t time_get_milliseconds_19700101();
 
+/**
+ * ȡ197011յڵ΢
+ */
+extern uint64_t time_get_microseconds_19700101();
+
 /**
  * localtime
  * @see localtime_s or localtime_r
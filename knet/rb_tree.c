@@ -200,6 +200,8 @@ void krbtree_insert(krbtree_t* tree, krbnode_t* z) {
     } else {
         y->right = z;
     }
+    /* ²ĽڵΪɫ, 򲻻ᴥ, ļʹ˻Ϊ */
+    z->color = rb_color_red;
     /*  */
     krbtree_insert_fixup(tree, z);
 }
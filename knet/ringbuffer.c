@@ -26,6 +26,27 @@
 #include "ringbuffer.h"
 #include "logger.h"
 
+#if !(defined(_WIN32) || defined(_WIN64))
+    #define RINGBUFFER_MIRROR 1
+    #include <sys/mman.h>
+    #if defined(__linux__)
+        #include <sys/syscall.h>
+    #endif /* defined(__linux__) */
+#endif /* !(defined(_WIN32) || defined(_WIN64)) */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define RINGBUFFER_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        /* AVX2汾, ʱCPUѡ */
+        #define RINGBUFFER_AVX2 1
+        #include <immintrin.h>
+    #endif /* defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) */
+#endif /* defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) */
+
+#define RINGBUFFER_FIND_TARGET_MAX 32   /* ¼λõĿַ󳤶 */
+#define RINGBUFFER_REALLOC_MIN     1024 /* ڴ汻ͷź·С */
+
 #ifndef min
 #define min(a, b) ((a) < (b) ? (a) : (b))
 #endif
@@ -40,28 +61,225 @@ struct _ringbuffer_t {
     uint32_t count;                 /* ɶݳ */
     uint32_t window_read_lock_size; /* ڶ */
     uint32_t window_read_pos;       /* ڶλ */
+    int      mirror;                /* ǷΪӳģʽ, ֮ͬһҳĵڶӳ */
+    uint32_t find_scanned;          /* ϴβѾȷϲƥֽ, Ӷλÿʼ */
+    uint32_t find_length;           /* ϴβҵĿ곤 */
+    char     find_target[RINGBUFFER_FIND_TARGET_MAX]; /* ϴβҵĿ */
+    int      init;                  /* Ƿͨringbuffer_initʼ */
 };
 
+/**
+ * λǰsizeֽ, Ѳҹ֮
+ */
+#define ringbuffer_find_consume(rb, size) \
+    ((rb)->find_scanned = (((rb)->find_scanned > (size)) ? ((rb)->find_scanned - (size)) : 0))
+
+/**
+ * λǰsizeֽ, sizeܳ
+ */
+#define ringbuffer_advance(rb, pos, size) \
+    ((((pos) + (size)) >= (rb)->max_size) ? ((pos) + (size) - (rb)->max_size) : ((pos) + (size)))
+
+/**
+ * ӻposλøsizeֽڵbuffer, Խĩβʱθ
+ */
+void ringbuffer_copy_out(kringbuffer_t* rb, uint32_t pos, char* buffer, uint32_t size) {
+    uint32_t first = 0;
+    if (rb->mirror) {
+        /* ģʽ */
+        memcpy(buffer, rb->ptr + pos, size);
+        return;
+    }
+    first = min(size, rb->max_size - pos);
+    memcpy(buffer, rb->ptr + pos, first);
+    if (size > first) {
+        memcpy(buffer + first, rb->ptr, size - first);
+    }
+}
+
+/**
+ * buffersizeֽڵposλ, Խĩβʱθ
+ */
+void ringbuffer_copy_in(kringbuffer_t* rb, uint32_t pos, const char* buffer, uint32_t size) {
+    uint32_t first = 0;
+    if (rb->mirror) {
+        memcpy(rb->ptr + pos, buffer, size);
+        return;
+    }
+    first = min(size, rb->max_size - pos);
+    memcpy(rb->ptr + pos, buffer, first);
+    if (size > first) {
+        memcpy(rb->ptr, buffer + first, size - first);
+    }
+}
+
+#if RINGBUFFER_MIRROR
+
+/**
+ * ӳĳȱҳȵ
+ */
+uint32_t ringbuffer_mirror_round_size(uint32_t size) {
+    uint32_t page = (uint32_t)sysconf(_SC_PAGESIZE);
+    if (!size) {
+        size = page;
+    }
+    return (size + page - 1) / page * page;
+}
+
+/**
+ * ڴļ
+ */
+int ringbuffer_mirror_open_fd() {
+#if defined(__linux__) && defined(SYS_memfd_create)
+    return (int)syscall(SYS_memfd_create, "knet_ringbuffer", 1 /* MFD_CLOEXEC */);
+#else
+    char name[64] = {0};
+    int  fd       = -1;
+    snprintf(name, sizeof(name), "/knet_ringbuffer_%d_%p", (int)getpid(), (void*)&name);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name);
+    }
+    return fd;
+#endif /* defined(__linux__) && defined(SYS_memfd_create) */
+}
+
+/**
+ * ͬһҳӳ, صһӳʼַ
+ * @param size , ҳȵ
+ * @return ʧܷ0
+ */
+char* ringbuffer_mirror_map(uint32_t size) {
+    char* base = 0;
+    int   fd   = ringbuffer_mirror_open_fd();
+    if (fd < 0) {
+        return 0;
+    }
+    if (ftruncate(fd, size)) {
+        close(fd);
+        return 0;
+    }
+    /* ȱȵĵַռ, ٰļӳ䵽ǰ */
+    base = (char*)mmap(0, (size_t)size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (char*)MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+    if ((mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) ||
+        (mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)) {
+        munmap(base, (size_t)size * 2);
+        close(fd);
+        return 0;
+    }
+    /* ӳ佨ļҪ */
+    close(fd);
+    return base;
+}
+
+#endif /* RINGBUFFER_MIRROR */
+
+/**
+ * 仺ڴ
+ */
+char* ringbuffer_alloc(uint32_t size, int mirror) {
+#if RINGBUFFER_MIRROR
+    if (mirror) {
+        return ringbuffer_mirror_map(size);
+    }
+#else
+    (void)mirror;
+#endif /* RINGBUFFER_MIRROR */
+#ifdef DISABLE_KNET_MEM_FUNC
+    return (char*)malloc(size);
+#else
+    return knet_create_raw(size);
+#endif /* DISABLE_KNET_MEM_FUNC */
+}
+
+/**
+ * ͷŻڴ
+ */
+void ringbuffer_free(char* ptr, uint32_t size, int mirror) {
+    if (!ptr) {
+        /* ڴѾͷ */
+        return;
+    }
+#if RINGBUFFER_MIRROR
+    if (mirror) {
+        munmap(ptr, (size_t)size * 2);
+        return;
+    }
+#else
+    (void)mirror;
+#endif /* RINGBUFFER_MIRROR */
+    (void)size;
+#ifdef DISABLE_KNET_MEM_FUNC
+    free(ptr);
+#else
+    knet_free(ptr);
+#endif /* DISABLE_KNET_MEM_FUNC */
+}
+
+/**
+ * ǨƵ·Ļ, ݸƵ»ͷ
+ * @retval error_ok ɹ
+ * @retval error_ringbuffer_mirror_fail ӳʧ, ԭ
+ */
+int ringbuffer_realloc(kringbuffer_t* rb, uint32_t new_max_size, int mirror) {
+    uint32_t cur_count = rb->count;
+    char*    new_ptr   = 0;
+#if RINGBUFFER_MIRROR
+    if (mirror) {
+        new_max_size = ringbuffer_mirror_round_size(new_max_size);
+    }
+#endif /* RINGBUFFER_MIRROR */
+    new_ptr = ringbuffer_alloc(new_max_size, mirror);
+    if (!new_ptr) {
+        return error_ringbuffer_mirror_fail;
+    }
+    ringbuffer_copy_out(rb, rb->read_pos, new_ptr, cur_count);
+    ringbuffer_free(rb->ptr, rb->max_size, rb->mirror);
+    rb->ptr                   = new_ptr;
+    rb->read_pos              = 0;
+    rb->write_pos             = (cur_count == new_max_size) ? 0 : cur_count;
+    rb->max_size              = new_max_size;
+    rb->count                 = cur_count;
+    rb->mirror                = mirror;
+    rb->lock_size             = 0;
+    rb->lock_type             = 0;
+    rb->window_read_lock_size = 0;
+    rb->window_read_pos       = 0;
+    return error_ok;
+}
+
 kringbuffer_t* ringbuffer_create(uint32_t size) {
 #ifdef DISABLE_KNET_MEM_FUNC
     kringbuffer_t* rb = (kringbuffer_t*)malloc(sizeof(kringbuffer_t));
 #else
     kringbuffer_t* rb = knet_create(kringbuffer_t);
 #endif
+    verify(rb);
+    ringbuffer_init(rb, size);
+    rb->init = 0;
+    return rb;
+}
+
+uint32_t ringbuffer_get_object_size() {
+    return sizeof(kringbuffer_t);
+}
+
+kringbuffer_t* ringbuffer_init(kringbuffer_t* rb, uint32_t size) {
     verify(rb);
     memset(rb, 0, sizeof(kringbuffer_t));
     rb->lock_type = 0;
     rb->max_size  = size;
-#ifdef DISABLE_KNET_MEM_FUNC
-    rb->ptr       = (char*)malloc(size);
-#else
-    rb->ptr       = knet_create_raw(size);
-#endif
+    rb->ptr       = ringbuffer_alloc(size, 0);
     verify(rb->ptr);
     rb->lock_size = 0;
     rb->read_pos  = 0;
     rb->write_pos = 0;
     rb->count     = 0;
+    rb->init      = 1;
     return rb;
 }
 
@@ -74,6 +292,7 @@ int ringbuffer_eat_all(kringbuffer_t* rb) {
     rb->read_pos  = 0;
     rb->write_pos = 0;
     rb->count     = 0;
+    rb->find_scanned = 0;
     return error_ok;
 }
 
@@ -86,166 +305,322 @@ int ringbuffer_eat(kringbuffer_t* rb, uint32_t size) {
         return error_recvbuffer_not_enough;
     }
     rb->count -= size;
-    rb->read_pos = (rb->read_pos + size) % rb->max_size;
+    rb->read_pos = ringbuffer_advance(rb, rb->read_pos, size);
+    ringbuffer_find_consume(rb, size);
     return error_ok;
 }
 
 uint32_t ringbuffer_read(kringbuffer_t* rb, char* buffer, uint32_t size) {
-    uint32_t i = 0;
     verify(rb);
     verify(buffer);
     verify(size);
     size = min(rb->count, size);
-    for (; i < size; i++) {
-        buffer[i] = rb->ptr[rb->read_pos];
-        rb->read_pos = (rb->read_pos + 1) % rb->max_size;
-    }
+    ringbuffer_copy_out(rb, rb->read_pos, buffer, size);
+    rb->read_pos = ringbuffer_advance(rb, rb->read_pos, size);
     rb->count -= size;
+    ringbuffer_find_consume(rb, size);
     return size;
 }
 
 uint32_t ringbuffer_remove(kringbuffer_t* rb, uint32_t size) {
-    uint32_t i = 0;
     verify(rb);
     verify(size);
     size = min(rb->count, size);
-    for (; i < size; i++) {
-        rb->read_pos = (rb->read_pos + 1) % rb->max_size;
-    }
+    rb->read_pos = ringbuffer_advance(rb, rb->read_pos, size);
     rb->count -= size;
+    ringbuffer_find_consume(rb, size);
     return size;
 }
 
 void ringbuffer_enlarge(kringbuffer_t* rb, uint32_t size) {
-    uint32_t reserve_size = rb->max_size - rb->count;
-    uint32_t cur_count = rb->count;
+    uint32_t reserve_size = 0;
     uint32_t new_max_size = 0;
-    char* new_ptr = 0;
-    char* temp_ptr = 0;
     verify(rb);
     verify(size);
-    if (reserve_size < size) {
+    reserve_size = rb->max_size - rb->count;
+    if (reserve_size >= size) {
+        return;
+    }
+    if (!rb->max_size) {
+        /* ڴѾͷ, · */
+        new_max_size = (size > RINGBUFFER_REALLOC_MIN) ? size : RINGBUFFER_REALLOC_MIN;
+    } else {
         new_max_size = rb->max_size * 2;
-        while (new_max_size - cur_count < size) {
+        while (new_max_size - rb->count < size) {
             new_max_size += rb->max_size;
         }
-#ifdef DISABLE_KNET_MEM_FUNC
-        new_ptr = malloc(new_max_size);
+    }
+    if (error_ok != ringbuffer_realloc(rb, new_max_size, rb->mirror)) {
+        /* ޷µľӳʱ˻ͨģʽ */
+        ringbuffer_realloc(rb, new_max_size, 0);
+    }
+}
+
+int ringbuffer_set_mirror(kringbuffer_t* rb) {
+    verify(rb);
+    if (rb->mirror) {
+        return error_ok;
+    }
+    if (rb->lock_type) {
+        return error_recvbuffer_locked;
+    }
+#if RINGBUFFER_MIRROR
+    return ringbuffer_realloc(rb, rb->max_size, 1);
 #else
-        new_ptr = knet_malloc(new_max_size);
-#endif
-        temp_ptr = rb->ptr;
-        if (cur_count) {
-          ringbuffer_read(rb, new_ptr, cur_count);
-        } else {
-          ringbuffer_read(rb, new_ptr, rb->max_size);
-        }
-        memset(rb, 0, sizeof(struct _ringbuffer_t));
-        rb->ptr = new_ptr;
-        rb->read_pos = 0;
-        rb->write_pos = cur_count;
-        rb->max_size = new_max_size;
-        rb->count = cur_count;
-    #ifdef DISABLE_KNET_MEM_FUNC
-        free(temp_ptr);
-    #else
-        knet_free(temp_ptr);
-    #endif
-    } else {
-        return;
+    return error_ringbuffer_mirror_fail;
+#endif /* RINGBUFFER_MIRROR */
+}
+
+int ringbuffer_is_mirror(kringbuffer_t* rb) {
+    verify(rb);
+    return rb->mirror;
+}
+
+int ringbuffer_shrink(kringbuffer_t* rb, uint32_t size) {
+    verify(rb);
+    if (rb->lock_type) {
+        return error_recvbuffer_locked;
+    }
+    if (size < rb->count) {
+        size = rb->count;
+    }
+    if (!size) {
+        /* ͷȫڴ, дʱ· */
+        ringbuffer_free(rb->ptr, rb->max_size, rb->mirror);
+        rb->ptr             = 0;
+        rb->max_size        = 0;
+        rb->read_pos        = 0;
+        rb->write_pos       = 0;
+        rb->window_read_pos = 0;
+        return error_ok;
+    }
+#if RINGBUFFER_MIRROR
+    if (rb->mirror) {
+        size = ringbuffer_mirror_round_size(size);
     }
+#endif /* RINGBUFFER_MIRROR */
+    if (size >= rb->max_size) {
+        return error_ok;
+    }
+    return ringbuffer_realloc(rb, size, rb->mirror);
 }
 
 uint32_t ringbuffer_write(kringbuffer_t* rb, const char* buffer, uint32_t size) {
-    uint32_t i = 0;
     verify(rb);
     verify(buffer);
     verify(size);
     ringbuffer_enlarge(rb, size);
     size = (((rb->max_size - rb->count) > size) ? size : rb->max_size - rb->count);
-    for (; i < size; i++) {
-        rb->ptr[rb->write_pos] = buffer[i];
-        rb->write_pos = (rb->write_pos + 1) % rb->max_size;
-    }
+    ringbuffer_copy_in(rb, rb->write_pos, buffer, size);
+    rb->write_pos = ringbuffer_advance(rb, rb->write_pos, size);
     rb->count += size;
     return size;
 }
 
 uint32_t ringbuffer_replace(kringbuffer_t* rb, uint32_t pos, const char* buffer, uint32_t size) {
-    uint32_t i         = 0;
-    uint32_t write_pos = 0;
     verify(rb);
     verify(buffer);
     verify(size);
-    if (size > rb->max_size) {
+    if ((size > rb->max_size) || (pos >= rb->max_size)) {
         return 0;
     }
-    write_pos = (rb->read_pos + pos) % rb->max_size;
-    for (; i < size; i++) {
-        rb->ptr[write_pos] = buffer[i];
-        write_pos = (write_pos + 1) % rb->max_size;
-    }
+    /* ݱ޸, ѲҹʧЧ */
+    rb->find_scanned = 0;
+    ringbuffer_copy_in(rb, ringbuffer_advance(rb, rb->read_pos, pos), buffer, size);
     return size;
 }
 
 uint32_t ringbuffer_copy(kringbuffer_t* rb, char* buffer, uint32_t size) {
-    uint32_t i        = 0;
-    uint32_t read_pos = 0;
     verify(rb);
     verify(buffer);
     verify(size);
-    read_pos = rb->read_pos;
     size = min(rb->count, size);
-    for (; i < size; i++) {
-        buffer[i] = rb->ptr[read_pos];
-        read_pos = (read_pos + 1) % rb->max_size;
-    }
+    ringbuffer_copy_out(rb, rb->read_pos, buffer, size);
     return size;
 }
 
 uint32_t ringbuffer_copy_random(kringbuffer_t* rb, uint32_t pos, char* buffer, uint32_t size) {
-    uint32_t i = 0;
-    uint32_t read_pos = 0;
     verify(rb);
-    verify(pos >= 0);
     verify(size);
     verify(buffer);
     if (pos + size > rb->count) {
         return 0;
     }
-    size = min(rb->count - pos, size);
-    read_pos = (rb->read_pos + pos) % rb->max_size;
-    for (; i < size; i++) {
-        buffer[i] = rb->ptr[read_pos];
-        read_pos = (read_pos + 1) % rb->max_size;
-    }
+    ringbuffer_copy_out(rb, ringbuffer_advance(rb, rb->read_pos, pos), buffer, size);
     return size;
 }
 
+/**
+ * ڴڲtarget, 汾, memchrλֽ
+ * @return ƥʼַ, δҵ0
+ */
+const char* ringbuffer_search_scalar(const char* ptr, uint32_t size, const char* target, uint32_t length) {
+    const char* end = ptr + size - length + 1; /* ƥ */
+    const char* cur = ptr;
+    if (size < length) {
+        return 0;
+    }
+    for (; (cur < end) && (cur = (const char*)memchr(cur, target[0], end - cur)); cur++) {
+        if (!memcmp(cur + 1, target + 1, length - 1)) {
+            return cur;
+        }
+    }
+    return 0;
+}
+
+#if RINGBUFFER_SSE2
+
+/**
+ * SSE2汾, ÿαȽ16ѡֽںβֽ, ʱٱȽм䲿
+ */
+const char* ringbuffer_search_sse2(const char* ptr, uint32_t size, const char* target, uint32_t length) {
+    uint32_t i     = 0;
+    uint32_t mask  = 0;
+    uint32_t bit   = 0;
+    __m128i  first = _mm_set1_epi8(target[0]);
+    __m128i  last  = _mm_set1_epi8(target[length - 1]);
+    if (size < length) {
+        return 0;
+    }
+    for (; i + length + 15 <= size; i += 16) {
+        mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i*)(ptr + i))),
+            _mm_cmpeq_epi8(last, _mm_loadu_si128((const __m128i*)(ptr + i + length - 1)))));
+        for (; mask; mask &= mask - 1) {
+            for (bit = 0; !(mask & (1u << bit)); bit++);
+            if (!memcmp(ptr + i + bit + 1, target + 1, length - 1)) {
+                return ptr + i + bit;
+            }
+        }
+    }
+    return ringbuffer_search_scalar(ptr + i, size - i, target, length);
+}
+
+#endif /* RINGBUFFER_SSE2 */
+
+#if RINGBUFFER_AVX2
+
+/**
+ * AVX2汾, ÿαȽ32ѡ
+ */
+__attribute__((target("avx2")))
+const char* ringbuffer_search_avx2(const char* ptr, uint32_t size, const char* target, uint32_t length) {
+    uint32_t i     = 0;
+    uint32_t mask  = 0;
+    __m256i  first = _mm256_set1_epi8(target[0]);
+    __m256i  last  = _mm256_set1_epi8(target[length - 1]);
+    if (size < length) {
+        return 0;
+    }
+    for (; i + length + 31 <= size; i += 32) {
+        mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, _mm256_loadu_si256((const __m256i*)(ptr + i))),
+            _mm256_cmpeq_epi8(last, _mm256_loadu_si256((const __m256i*)(ptr + i + length - 1)))));
+        for (; mask; mask &= mask - 1) {
+            if (!memcmp(ptr + i + __builtin_ctz(mask) + 1, target + 1, length - 1)) {
+                return ptr + i + __builtin_ctz(mask);
+            }
+        }
+    }
+    return ringbuffer_search_sse2(ptr + i, size - i, target, length);
+}
+
+#endif /* RINGBUFFER_AVX2 */
+
+typedef const char* (*ringbuffer_search_t)(const char*, uint32_t, const char*, uint32_t);
+
+/**
+ * ڴڲtarget, ״εʱCPUѡʵ
+ * @return ƥʼַ, δҵ0
+ */
+const char* ringbuffer_search(const char* ptr, uint32_t size, const char* target, uint32_t length) {
+    static ringbuffer_search_t search = 0;
+    if (!search) {
+#if RINGBUFFER_AVX2
+        __builtin_cpu_init();
+        search = __builtin_cpu_supports("avx2") ? ringbuffer_search_avx2 : ringbuffer_search_sse2;
+#elif RINGBUFFER_SSE2
+        search = ringbuffer_search_sse2;
+#else
+        search = ringbuffer_search_scalar;
+#endif /* RINGBUFFER_AVX2 */
+    }
+    return search(ptr, size, target, length);
+}
+
 uint32_t ringbuffer_find(kringbuffer_t* rb, const char* target, uint32_t* size) {
-    uint32_t i      = 0; /* Ƿﵽĩβ */
-    int      index  = 0; /* ǰƥ䵽ַ± */
-    int      length = 0; /* ܳ */
-    int      pos    = 0; /* rbڵ± */
+    uint32_t    length = 0; /* Ŀ곤 */
+    uint32_t    start  = 0; /* βҵ, Զλ */
+    uint32_t    first  = 0; /* һݵĳ */
+    uint32_t    pos    = 0; /* ѡ, Զλ */
+    uint32_t    part   = 0; /* ѡڵһڵĳ */
+    const char* found  = 0;
     verify(rb);
     verify(target);
     verify(size);
-    length = (int)strlen(target);
-    pos    = rb->read_pos % rb->max_size;
-    for (; (i < rb->count) && (index < length); i++) {
-        if (rb->ptr[pos] == target[index]) { /* ƥ */
-            index += 1;                        /* ǰλõ */
-            pos    = (pos + 1) % rb->max_size; /* rbλõ */
-        } else { /* ʧ */
-            pos   = (rb->read_pos + i + 1) % rb->max_size; /* rbƥλ */
-            index = 0;                                 /* Ŀַ± */
+    length = (uint32_t)strlen(target);
+    if (!length) {
+        *size = 0;
+        return error_ok;
+    }
+    /* ĿͬʱϴѾȷûƥ, ֻµ */
+    if ((length <= RINGBUFFER_FIND_TARGET_MAX) && (length == rb->find_length) &&
+        !memcmp(target, rb->find_target, length)) {
+        start = rb->find_scanned;
+    }
+    /* ģʽȫ, ڶδӻͷʼ */
+    first = rb->mirror ? rb->count : min(rb->count, rb->max_size - rb->read_pos);
+    if (start < first) {
+        found = ringbuffer_search(rb->ptr + rb->read_pos + start, first - start, target, length);
+        if (found) {
+            pos = (uint32_t)(found - rb->ptr - rb->read_pos);
+            goto found_target;
         }
+        /* Խĩβĺѡ */
+        pos = (first >= length) ? (first - length + 1) : 0;
+        for (pos = (pos > start) ? pos : start; (pos < first) && (pos + length <= rb->count); pos++) {
+            part = first - pos;
+            if (!memcmp(rb->ptr + rb->read_pos + pos, target, part) &&
+                !memcmp(rb->ptr, target + part, length - part)) {
+                goto found_target;
+            }
+        }
+        start = first;
     }
-    if (index == length) {
-        *size = i; /* ַtarget */
-        return error_ok;
+    if (start < rb->count) {
+        found = ringbuffer_search(rb->ptr + start - first, rb->count - start, target, length);
+        if (found) {
+            pos = (uint32_t)(found - rb->ptr) + first;
+            goto found_target;
+        }
+    }
+    /* ¼Ѿȷϲƥ */
+    if (length <= RINGBUFFER_FIND_TARGET_MAX) {
+        memcpy(rb->find_target, target, length);
+        rb->find_length  = length;
+        rb->find_scanned = (rb->count >= length) ? (rb->count - length + 1) : 0;
     }
     return error_ringbuffer_not_found;
+
+found_target:
+    if (length <= RINGBUFFER_FIND_TARGET_MAX) {
+        memcpy(rb->find_target, target, length);
+        rb->find_length  = length;
+        rb->find_scanned = pos;
+    }
+    *size = pos + length; /* ַtarget */
+    return error_ok;
+}
+
+char* ringbuffer_peek(kringbuffer_t* rb, uint32_t* size) {
+    verify(rb);
+    verify(size);
+    if (rb->mirror || (rb->write_pos > rb->read_pos)) {
+        *size = rb->count;
+    } else {
+        *size = min(rb->count, rb->max_size - rb->read_pos);
+    }
+    return rb->ptr + rb->read_pos;
 }
 
 uint32_t ringbuffer_available(kringbuffer_t* rb) {
@@ -255,11 +630,14 @@ uint32_t ringbuffer_available(kringbuffer_t* rb) {
 
 void ringbuffer_destroy(kringbuffer_t* rb) {
     verify(rb);
+    ringbuffer_free(rb->ptr, rb->max_size, rb->mirror);
+    if (rb->init) {
+        /* ڴɵ߹ */
+        return;
+    }
 #ifdef DISABLE_KNET_MEM_FUNC
-    free(rb->ptr);
     free(rb);
 #else
-    knet_free(rb->ptr);
     knet_free(rb);
 #endif
 }
@@ -271,7 +649,10 @@ uint32_t ringbuffer_read_lock_size(kringbuffer_t* rb) {
     }
     rb->lock_type = 1;
     rb->lock_size = 0;
-    if (rb->write_pos > rb->read_pos) {
+    if (rb->mirror) {
+        /* ģʽпɶݶ */
+        rb->lock_size = rb->count;
+    } else if (rb->write_pos > rb->read_pos) {
         rb->lock_size = rb->write_pos - rb->read_pos;
     } else {
         rb->lock_size = rb->max_size - rb->read_pos;
@@ -295,10 +676,11 @@ void ringbuffer_read_commit(kringbuffer_t* rb, uint32_t size) {
     if (rb->lock_size < size) {
         return;
     }
-    rb->read_pos = (rb->read_pos + size) % rb->max_size;
+    rb->read_pos = ringbuffer_advance(rb, rb->read_pos, size);
     rb->lock_size = 0;
     rb->lock_type = 0;
     rb->count -= size;
+    ringbuffer_find_consume(rb, size);
 }
 
 void ringbuffer_read_unlock(kringbuffer_t* rb) {
@@ -320,7 +702,10 @@ uint32_t ringbuffer_window_read_lock_size(kringbuffer_t* rb) {
         rb->window_read_pos = rb->read_pos;
     }
     rb->window_read_lock_size = 0;
-    if (rb->write_pos > rb->window_read_pos) {
+    if (rb->mirror) {
+        rb->window_read_lock_size = rb->count - ((rb->window_read_pos >= rb->read_pos) ?
+            (rb->window_read_pos - rb->read_pos) : (rb->window_read_pos + rb->max_size - rb->read_pos));
+    } else if (rb->write_pos > rb->window_read_pos) {
         rb->window_read_lock_size = rb->write_pos - rb->window_read_pos;
     } else {
         rb->window_read_lock_size = rb->max_size - rb->window_read_pos;
@@ -339,17 +724,20 @@ void ringbuffer_window_read_commit(kringbuffer_t* rb, uint32_t size) {
     if (rb->window_read_lock_size < size) {
         return;
     }
-    rb->window_read_pos = (rb->window_read_pos + size) % rb->max_size;
+    rb->window_read_pos = ringbuffer_advance(rb, rb->window_read_pos, size);
 }
 
 uint32_t ringbuffer_write_lock_size(kringbuffer_t* rb) {
     verify(rb);
     if (ringbuffer_full(rb)) {
-        ringbuffer_enlarge(rb, rb->max_size);
+        ringbuffer_enlarge(rb, rb->max_size ? rb->max_size : RINGBUFFER_REALLOC_MIN);
     }
     rb->lock_type = 2;
     rb->lock_size = 0;
-    if (rb->write_pos >= rb->read_pos) {
+    if (rb->mirror) {
+        /* ģʽпдռ䶼 */
+        rb->lock_size = rb->max_size - rb->count;
+    } else if (rb->write_pos >= rb->read_pos) {
         rb->lock_size = rb->max_size - rb->write_pos;
     } else {
         rb->lock_size = rb->read_pos - rb->write_pos;
@@ -357,6 +745,27 @@ uint32_t ringbuffer_write_lock_size(kringbuffer_t* rb) {
     return rb->lock_size;
 }
 
+int ringbuffer_write_lock_iov(kringbuffer_t* rb, kiovec_t* iov) {
+    uint32_t first = 0;
+    verify(rb);
+    verify(iov);
+    if (ringbuffer_full(rb)) {
+        ringbuffer_enlarge(rb, rb->max_size ? rb->max_size : RINGBUFFER_REALLOC_MIN);
+    }
+    rb->lock_type = 2;
+    rb->lock_size = rb->max_size - rb->count;
+    /* ģʽ¿дռ, дλõĩβΪһ, ͷλΪڶ */
+    first = rb->mirror ? rb->lock_size : min(rb->lock_size, rb->max_size - rb->write_pos);
+    iov[0].data = rb->ptr + rb->write_pos;
+    iov[0].size = (int)first;
+    if (first == rb->lock_size) {
+        return 1;
+    }
+    iov[1].data = rb->ptr;
+    iov[1].size = (int)(rb->lock_size - first);
+    return 2;
+}
+
 char* ringbuffer_write_lock_ptr(kringbuffer_t* rb) {
     verify(rb);
     if (rb->lock_type != 2) {
@@ -373,7 +782,7 @@ void ringbuffer_write_commit(kringbuffer_t* rb, uint32_t size) {
     if (rb->lock_size < size) {
         return;
     }
-    rb->write_pos = (rb->write_pos + size) % rb->max_size;
+    rb->write_pos = ringbuffer_advance(rb, rb->write_pos, size);
     rb->lock_size = 0;
     rb->lock_type = 0;
     rb->count += size;
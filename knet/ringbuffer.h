@@ -28,4 +28,18 @@
 #include "config.h"
 #include "ringbuffer_api.h"
 
+/**
+ * ȡûλ, , ڽλǶ뵽ڴ
+ * @return λ
+ */
+uint32_t ringbuffer_get_object_size();
+
+/**
+ * ڵṩڴϳʼλ, ringbuffer_destroyֻͷŻ
+ * @param rb Ϊringbuffer_get_object_size()ڴ
+ * @param size 
+ * @return kringbuffer_tʵ
+ */
+kringbuffer_t* ringbuffer_init(kringbuffer_t* rb, uint32_t size);
+
 #endif /* RINGBUFFER_H */
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "send_queue.h"
+#include "misc.h"
+#include "logger.h"
+
+/**
+ * ݿ
+ */
+typedef enum _send_chunk_type_e {
+    send_chunk_pooled = 1, /* ػݿ */
+    send_chunk_raw,        /* ݿ, һд볬ػݿ鳤ȵ */
+    send_chunk_slice,      /* ⲿƬ */
+} send_chunk_type_e;
+
+/**
+ * ݿ, ػͶݿݽ
+ */
+typedef struct _send_chunk_t {
+    struct _send_chunk_t* next;     /* һݿ */
+    char*                 ptr;      /* ָ */
+    uint32_t              size;     /* ݳ */
+    uint32_t              pos;      /* ѷ͵ĳ */
+    uint32_t              capacity; /* ɵݳ */
+    send_chunk_type_e     type;     /* ݿ */
+    knet_write_free_cb_t  free_cb;  /* ⲿƬͷŻص */
+    void*                 ctx;      /* ⲿƬͷŻص */
+} send_chunk_t;
+
+/**
+ * ݿ, ֻkloop_t߳ڷ
+ */
+struct _send_pool_t {
+    send_chunk_t* free_list;  /* ݿ */
+    uint32_t      free_count; /* ݿ */
+    uint64_t      pending;    /* ʹݿصзͶڵȴ͵ֽ */
+};
+
+/**
+ * Ͷ
+ */
+struct _send_queue_t {
+    send_chunk_t* head;    /* ͷ */
+    send_chunk_t* tail;    /* β */
+    ksend_pool_t* pool;    /* ݿ, Ϊ0 */
+    uint64_t      pending; /* ȴ͵ֽ */
+    int           init;    /* Ƿͨsend_queue_initʼ */
+};
+
+ksend_pool_t* send_pool_create() {
+    ksend_pool_t* pool = knet_create(ksend_pool_t);
+    verify(pool);
+    memset(pool, 0, sizeof(ksend_pool_t));
+    return pool;
+}
+
+void send_pool_destroy(ksend_pool_t* pool) {
+    send_chunk_t* chunk = 0;
+    verify(pool);
+    while (pool->free_list) {
+        chunk = pool->free_list;
+        pool->free_list = chunk->next;
+        knet_free(chunk);
+    }
+    knet_free(pool);
+}
+
+uint64_t send_pool_get_pending_bytes(ksend_pool_t* pool) {
+    verify(pool);
+    return pool->pending;
+}
+
+send_chunk_t* send_chunk_create(ksend_queue_t* queue, send_chunk_type_e type, uint32_t capacity) {
+    send_chunk_t* chunk = 0;
+    if ((type == send_chunk_pooled) && queue->pool && queue->pool->free_list) {
+        /* ݿȡ */
+        chunk = queue->pool->free_list;
+        queue->pool->free_list = chunk->next;
+        queue->pool->free_count--;
+    } else if (type == send_chunk_slice) {
+        chunk = knet_create(send_chunk_t);
+    } else {
+        chunk = knet_create_type(send_chunk_t, sizeof(send_chunk_t) + capacity);
+    }
+    verify(chunk);
+    if (!chunk) {
+        return 0;
+    }
+    memset(chunk, 0, sizeof(send_chunk_t));
+    chunk->type     = type;
+    chunk->capacity = capacity;
+    if (type != send_chunk_slice) {
+        chunk->ptr = (char*)(chunk + 1);
+    }
+    return chunk;
+}
+
+void send_chunk_destroy(ksend_queue_t* queue, send_chunk_t* chunk) {
+    if (chunk->type == send_chunk_slice) {
+        if (chunk->free_cb) {
+            chunk->free_cb(chunk->ptr, (int)chunk->size, chunk->ctx);
+        }
+    } else if ((chunk->type == send_chunk_pooled) && queue->pool &&
+        (queue->pool->free_count < SEND_QUEUE_POOL_MAX)) {
+        /* յݿ */
+        chunk->next = queue->pool->free_list;
+        queue->pool->free_list = chunk;
+        queue->pool->free_count++;
+        return;
+    }
+    knet_free(chunk);
+}
+
+void send_queue_add_pending(ksend_queue_t* queue, uint64_t size) {
+    queue->pending += size;
+    if (queue->pool) {
+        queue->pool->pending += size;
+    }
+}
+
+void send_queue_sub_pending(ksend_queue_t* queue, uint64_t size) {
+    queue->pending -= size;
+    if (queue->pool) {
+        queue->pool->pending -= size;
+    }
+}
+
+void send_queue_append(ksend_queue_t* queue, send_chunk_t* chunk) {
+    if (queue->tail) {
+        queue->tail->next = chunk;
+    } else {
+        queue->head = chunk;
+    }
+    queue->tail = chunk;
+}
+
+ksend_queue_t* send_queue_create() {
+    ksend_queue_t* queue = knet_create(ksend_queue_t);
+    verify(queue);
+    memset(queue, 0, sizeof(ksend_queue_t));
+    return queue;
+}
+
+uint32_t send_queue_get_object_size() {
+    return sizeof(ksend_queue_t);
+}
+
+ksend_queue_t* send_queue_init(ksend_queue_t* queue) {
+    verify(queue);
+    memset(queue, 0, sizeof(ksend_queue_t));
+    queue->init = 1;
+    return queue;
+}
+
+void send_queue_destroy(ksend_queue_t* queue) {
+    send_chunk_t* chunk = 0;
+    verify(queue);
+    send_queue_sub_pending(queue, queue->pending);
+    while (queue->head) {
+        chunk = queue->head;
+        queue->head = chunk->next;
+        send_chunk_destroy(queue, chunk);
+    }
+    if (!queue->init) {
+        knet_free(queue);
+    }
+}
+
+void send_queue_set_pool(ksend_queue_t* queue, ksend_pool_t* pool) {
+    verify(queue);
+    if (queue->pool == pool) {
+        return;
+    }
+    if (queue->pool) {
+        queue->pool->pending -= queue->pending;
+    }
+    queue->pool = pool;
+    if (pool) {
+        pool->pending += queue->pending;
+    }
+}
+
+int send_queue_write(ksend_queue_t* queue, const char* data, uint32_t size) {
+    uint32_t      n     = 0;
+    send_chunk_t* chunk = 0;
+    verify(queue);
+    verify(data);
+    chunk = queue->tail;
+    /* βݿʣռ */
+    if (chunk && (chunk->type != send_chunk_slice) && (chunk->capacity > chunk->size)) {
+        n = ((chunk->capacity - chunk->size) > size) ? size : (chunk->capacity - chunk->size);
+        memcpy(chunk->ptr + chunk->size, data, n);
+        chunk->size += n;
+        data        += n;
+        size        -= n;
+        send_queue_add_pending(queue, n);
+    }
+    while (size) {
+        if (size >= SEND_QUEUE_CHUNK_SIZE) {
+            /* ʣһдݿ */
+            chunk = send_chunk_create(queue, send_chunk_raw, size);
+        } else {
+            chunk = send_chunk_create(queue, send_chunk_pooled, SEND_QUEUE_CHUNK_SIZE);
+        }
+        if (!chunk) {
+            return error_no_memory;
+        }
+        n = (chunk->capacity > size) ? size : chunk->capacity;
+        memcpy(chunk->ptr, data, n);
+        chunk->size = n;
+        data       += n;
+        size       -= n;
+        send_queue_append(queue, chunk);
+        send_queue_add_pending(queue, n);
+    }
+    return error_ok;
+}
+
+int send_queue_add_slice(ksend_queue_t* queue, char* data, uint32_t size, uint32_t pos,
+    knet_write_free_cb_t free_cb, void* ctx) {
+    send_chunk_t* chunk = 0;
+    verify(queue);
+    verify(data);
+    verify(pos < size);
+    chunk = send_chunk_create(queue, send_chunk_slice, size);
+    if (!chunk) {
+        return error_no_memory;
+    }
+    chunk->ptr     = data;
+    chunk->size    = size;
+    chunk->pos     = pos;
+    chunk->free_cb = free_cb;
+    chunk->ctx     = ctx;
+    send_queue_append(queue, chunk);
+    send_queue_add_pending(queue, size - pos);
+    return error_ok;
+}
+
+int send_queue_send(ksend_queue_t* queue, socket_t socket_fd, uint32_t* calls) {
+    kiovec_t      iov[SOCKET_IOV_MAX];
+    int           count = 0;
+    int           total = 0;
+    int           bytes = 0;
+    send_chunk_t* chunk = 0;
+    verify(queue);
+    verify(calls);
+    *calls = 0;
+    while (queue->head) {
+        /* һϵͳ÷ͶͷĶݿ */
+        for (count = 0, total = 0, chunk = queue->head; chunk && (count < SOCKET_IOV_MAX); chunk = chunk->next) {
+            iov[count].data = chunk->ptr + chunk->pos;
+            iov[count].size = (int)(chunk->size - chunk->pos);
+            total += iov[count].size;
+            count++;
+        }
+        bytes = socket_sendv(socket_fd, iov, count);
+        *calls += 1;
+        if (bytes < 0) {
+            /* 󣬹ر */
+            return error_send_fail;
+        }
+        send_queue_eat(queue, (uint32_t)bytes);
+        if (bytes < total) {
+            /* ׽ַͻ, ȴ´οд */
+            return error_send_patial;
+        }
+    }
+    return error_ok;
+}
+
+uint32_t send_queue_copy(ksend_queue_t* queue, char* buffer, uint32_t size) {
+    uint32_t      n     = 0;
+    uint32_t      bytes = 0;
+    send_chunk_t* chunk = 0;
+    verify(queue);
+    verify(buffer);
+    for (chunk = queue->head; chunk && (bytes < size); chunk = chunk->next) {
+        n = chunk->size - chunk->pos;
+        if (n > size - bytes) {
+            n = size - bytes;
+        }
+        memcpy(buffer + bytes, chunk->ptr + chunk->pos, n);
+        bytes += n;
+    }
+    return bytes;
+}
+
+void send_queue_eat(ksend_queue_t* queue, uint32_t size) {
+    uint32_t      n     = 0;
+    send_chunk_t* chunk = 0;
+    verify(queue);
+    while (size && queue->head) {
+        chunk = queue->head;
+        n = ((chunk->size - chunk->pos) > size) ? size : (chunk->size - chunk->pos);
+        chunk->pos += n;
+        size       -= n;
+        send_queue_sub_pending(queue, n);
+        if (chunk->pos == chunk->size) {
+            /*  */
+            queue->head = chunk->next;
+            if (!queue->head) {
+                queue->tail = 0;
+            }
+            send_chunk_destroy(queue, chunk);
+        }
+    }
+}
+
+uint64_t send_queue_get_pending_bytes(ksend_queue_t* queue) {
+    verify(queue);
+    return queue->pending;
+}
+
+int send_queue_empty(ksend_queue_t* queue) {
+    verify(queue);
+    return !queue->head;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SEND_QUEUE_H
+#define SEND_QUEUE_H
+
+#include "config.h"
+
+/*
+ * Ͷ
+ *
+ * ȴ͵ݱݿɵĵ, ݿΪ:
+ * 1. ̶ȵĳػݿ, kloop_tڵݿطͻ, дݸƵݿ
+ * 2. ⲿƬ, ɵṩ, ϺͷŻص
+ * ͨwritevһηͶݿ, ѷϵݿ, ڴռ
+ */
+
+#define SEND_QUEUE_CHUNK_SIZE 4096 /* ػݿ鳤 */
+#define SEND_QUEUE_POOL_MAX   256  /* ݿ໺Ŀݿ */
+
+/**
+ * ݿ
+ * @return ksend_pool_tʵ
+ */
+ksend_pool_t* send_pool_create();
+
+/**
+ * ݿ
+ * @param pool ksend_pool_tʵ
+ */
+void send_pool_destroy(ksend_pool_t* pool);
+
+/**
+ * ȡʹݿصзͶڵȴ͵ֽ
+ * @param pool ksend_pool_tʵ
+ * @return ȴ͵ֽ
+ */
+uint64_t send_pool_get_pending_bytes(ksend_pool_t* pool);
+
+/**
+ * Ͷ
+ * @return ksend_queue_tʵ
+ */
+ksend_queue_t* send_queue_create();
+
+uint32_t send_queue_get_object_size();
+
+ksend_queue_t* send_queue_init(ksend_queue_t* queue);
+
+/**
+ * ٷͶ, δ͵ⲿƬͷŻص
+ * @param queue ksend_queue_tʵ
+ */
+void send_queue_destroy(ksend_queue_t* queue);
+
+/**
+ * ݿ, δʱֱӷͷݿ
+ * ܵǨƵkloop_tʱ, ȴ͵ֽͬʱǨ
+ * @param queue ksend_queue_tʵ
+ * @param pool ksend_pool_tʵ
+ */
+void send_queue_set_pool(ksend_queue_t* queue, ksend_pool_t* pool);
+
+/**
+ * ݵβ
+ * @param queue ksend_queue_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int send_queue_write(ksend_queue_t* queue, const char* data, uint32_t size);
+
+/**
+ * ⲿƬβ, ݲ
+ * ʧʱͷŻص
+ * @param queue ksend_queue_tʵ
+ * @param data ָ
+ * @param size ݳ
+ * @param pos Ѿ͵ĳ
+ * @param free_cb ͷŻص
+ * @param ctx ͷŻص
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int send_queue_add_slice(ksend_queue_t* queue, char* data, uint32_t size, uint32_t pos,
+    knet_write_free_cb_t free_cb, void* ctx);
+
+/**
+ * ͨwritevͶ, ֱΪջ׽ַͻ
+ * @param queue ksend_queue_tʵ
+ * @param socket_fd ׽
+ * @param calls η͵ϵͳô
+ * @retval error_ok ȫ
+ * @retval error_send_patial ݵȴ
+ * @retval error_send_fail ʧ
+ */
+int send_queue_send(ksend_queue_t* queue, socket_t socket_fd, uint32_t* calls);
+
+/**
+ * ƶͷ, Ƴ
+ * @param queue ksend_queue_tʵ
+ * @param buffer Ŀ껺
+ * @param size Ŀ껺
+ * @return ʵʸƵֽ
+ */
+uint32_t send_queue_copy(ksend_queue_t* queue, char* buffer, uint32_t size);
+
+/**
+ * Ƴͷ
+ * @param queue ksend_queue_tʵ
+ * @param size Ƴֽ
+ */
+void send_queue_eat(ksend_queue_t* queue, uint32_t size);
+
+/**
+ * ȡõȴ͵ֽ
+ * @param queue ksend_queue_tʵ
+ * @return ȴ͵ֽ
+ */
+uint64_t send_queue_get_pending_bytes(ksend_queue_t* queue);
+
+/**
+ * ǷΪ
+ * @param queue ksend_queue_tʵ
+ * @retval 0 ǿ
+ * @retval  
+ */
+int send_queue_empty(ksend_queue_t* queue);
+
+#endif /* SEND_QUEUE_H */
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "socket_options.h"
+#include "misc.h"
+#include "logger.h"
+
+#define SOCKET_OPTIONS_RING_LEN -1 /* /дܵջͬ */
+
+/**
+ * ׽ѡ
+ */
+struct _socket_options_t {
+    int      nodelay;      /* Ƿرӳٷ */
+    int      linger;       /* Ƿlinger */
+    int      linger_time;  /* lingerȴʱ䣨룩 */
+    int      keepalive;    /* Ƿkeep-alive */
+    int      keepidle;     /* keep-aliveʱ䣨룩, 0ΪϵͳĬֵ */
+    int      recv_size;    /* , 0ΪϵͳԶ, SOCKET_OPTIONS_RING_LENΪܵջ */
+    int      send_size;    /* д, 0ΪϵͳԶ, SOCKET_OPTIONS_RING_LENΪܵջ */
+    int      defer_accept; /* TCP_DEFER_ACCEPT룩, 0Ϊر */
+    int      quickack;     /* ǷTCP_QUICKACK */
+    uint32_t user_timeout; /* TCP_USER_TIMEOUT룩, 0ΪϵͳĬֵ */
+};
+
+/**
+ * Ĭ
+ */
+static const ksocket_options_t default_options = {
+    1, 0, 0, 0, 0, SOCKET_OPTIONS_RING_LEN, SOCKET_OPTIONS_RING_LEN, 0, 0, 0
+};
+
+ksocket_options_t* knet_socket_options_create() {
+    ksocket_options_t* options = knet_create(ksocket_options_t);
+    verify(options);
+    *options = default_options;
+    return options;
+}
+
+void knet_socket_options_destroy(ksocket_options_t* options) {
+    verify(options);
+    knet_free(options);
+}
+
+int knet_socket_options_set_nodelay(ksocket_options_t* options, int on) {
+    verify(options);
+    options->nodelay = (on ? 1 : 0);
+    return error_ok;
+}
+
+int knet_socket_options_set_linger(ksocket_options_t* options, int on, int seconds) {
+    verify(options);
+    if (seconds < 0) {
+        return error_invalid_parameters;
+    }
+    options->linger      = (on ? 1 : 0);
+    options->linger_time = seconds;
+    return error_ok;
+}
+
+int knet_socket_options_set_keepalive(ksocket_options_t* options, int on, int idle) {
+    verify(options);
+    if (idle < 0) {
+        return error_invalid_parameters;
+    }
+    options->keepalive = (on ? 1 : 0);
+    options->keepidle  = idle;
+    return error_ok;
+}
+
+int knet_socket_options_set_buffer_size(ksocket_options_t* options, int recv_size, int send_size) {
+    verify(options);
+    if ((recv_size < SOCKET_OPTIONS_RING_LEN) || (send_size < SOCKET_OPTIONS_RING_LEN)) {
+        return error_invalid_parameters;
+    }
+    options->recv_size = recv_size;
+    options->send_size = send_size;
+    return error_ok;
+}
+
+int knet_socket_options_set_defer_accept(ksocket_options_t* options, int seconds) {
+    verify(options);
+    if (seconds < 0) {
+        return error_invalid_parameters;
+    }
+    options->defer_accept = seconds;
+    return error_ok;
+}
+
+int knet_socket_options_set_quickack(ksocket_options_t* options, int on) {
+    verify(options);
+    options->quickack = (on ? 1 : 0);
+    return error_ok;
+}
+
+int knet_socket_options_set_user_timeout(ksocket_options_t* options, uint32_t ms) {
+    verify(options);
+    options->user_timeout = ms;
+    return error_ok;
+}
+
+void knet_socket_options_apply(const ksocket_options_t* options, socket_t socket_fd, uint32_t recv_ring_len) {
+    if (!options) {
+        options = &default_options;
+    }
+    /* ½׽lingerkeep-aliveĬϹر, ϵͳĬֵͬѡ */
+    if (options->nodelay) {
+        socket_set_nagle_off(socket_fd);
+    }
+    if (options->linger) {
+        socket_set_linger_on(socket_fd, options->linger_time);
+    }
+    if (options->keepalive) {
+        socket_set_keepalive_on(socket_fd, options->keepidle);
+    }
+    /* ö/дȺϵͳԶ */
+    if (options->recv_size) {
+        socket_set_recv_buffer_size(socket_fd, (options->recv_size == SOCKET_OPTIONS_RING_LEN) ?
+            (int)recv_ring_len : options->recv_size);
+    }
+    if (options->send_size) {
+        socket_set_send_buffer_size(socket_fd, (options->send_size == SOCKET_OPTIONS_RING_LEN) ?
+            (int)recv_ring_len : options->send_size);
+    }
+    if (options->user_timeout) {
+        socket_set_user_timeout(socket_fd, options->user_timeout);
+    }
+    knet_socket_options_apply_accepted(options, socket_fd);
+}
+
+void knet_socket_options_apply_accepted(const ksocket_options_t* options, socket_t socket_fd) {
+    if (!options) {
+        return;
+    }
+    if (options->quickack) {
+        socket_set_quickack(socket_fd, 1);
+    }
+}
+
+void knet_socket_options_apply_listener(const ksocket_options_t* options, socket_t socket_fd) {
+    if (!options) {
+        return;
+    }
+    if (options->defer_accept) {
+        if (socket_set_defer_accept(socket_fd, options->defer_accept)) {
+            log_warn("setsockopt(TCP_DEFER_ACCEPT) failed, system error: %d", sys_get_errno());
+        }
+    }
+}
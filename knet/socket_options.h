@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SOCKET_OPTIONS_H
+#define SOCKET_OPTIONS_H
+
+#include "config.h"
+#include "socket_options_api.h"
+
+/**
+ * Ӧõ½׽
+ * @param options ksocket_options_tʵ, Ϊ0ʱʹĬ
+ * @param socket_fd ׽
+ * @param recv_ring_len ܵջ
+ */
+void knet_socket_options_apply(const ksocket_options_t* options, socket_t socket_fd, uint32_t recv_ring_len);
+
+/**
+ * ӦõӼ׽ּ̳ѡ׽, ֻòᱻ̳еѡ
+ * @param options ksocket_options_tʵ, Ϊ0ʱκ
+ * @param socket_fd ׽
+ */
+void knet_socket_options_apply_accepted(const ksocket_options_t* options, socket_t socket_fd);
+
+/**
+ * ֻԼ׽ЧѡӦõ׽, listen()֮ǰ
+ * @param options ksocket_options_tʵ, Ϊ0ʱκ
+ * @param socket_fd ׽
+ */
+void knet_socket_options_apply_listener(const ksocket_options_t* options, socket_t socket_fd);
+
+#endif /* SOCKET_OPTIONS_H */
@@ -32,6 +32,7 @@
 
 struct _stream_t {
     kchannel_ref_t* channel_ref;
+    int             init; /* Ƿͨstream_initʼ */
 };
 
 kstream_t* stream_create(kchannel_ref_t* channel_ref) {
@@ -44,9 +45,23 @@ kstream_t* stream_create(kchannel_ref_t* channel_ref) {
     return stream;
 }
 
+uint32_t stream_get_object_size() {
+    return sizeof(kstream_t);
+}
+
+kstream_t* stream_init(kstream_t* stream, kchannel_ref_t* channel_ref) {
+    verify(stream);
+    verify(channel_ref);
+    stream->channel_ref = channel_ref;
+    stream->init        = 1;
+    return stream;
+}
+
 void stream_destroy(kstream_t* stream) {
     verify(stream);
-    knet_free(stream);
+    if (!stream->init) {
+        knet_free(stream);
+    }
 }
 
 int knet_stream_available(kstream_t* stream) {
@@ -61,6 +76,7 @@ int knet_stream_pop(kstream_t* stream, void* buffer, int size) {
     verify(stream);
     verify(buffer);
     if (0 < ringbuffer_read(knet_channel_ref_get_ringbuffer(stream->channel_ref), (char*)buffer, size)) {
+        knet_channel_ref_check_recv_resume(stream->channel_ref);
         return error_ok;
     }
     return error_recv_fail;
@@ -85,16 +101,22 @@ int knet_stream_pop_until(kstream_t* stream, const char* end, void* buffer, int*
 }
 
 int knet_stream_eat_all(kstream_t* stream) {
+    int error = error_ok;
     verify(stream);
-    return ringbuffer_eat_all(knet_channel_ref_get_ringbuffer(stream->channel_ref));
+    error = ringbuffer_eat_all(knet_channel_ref_get_ringbuffer(stream->channel_ref));
+    knet_channel_ref_check_recv_resume(stream->channel_ref);
+    return error;
 }
 
 int knet_stream_eat(kstream_t* stream, int size) {
+    int error = error_ok;
     verify(stream);
     if (!size) {
         return error_ok;
     }
-    return ringbuffer_eat(knet_channel_ref_get_ringbuffer(stream->channel_ref), size);
+    error = ringbuffer_eat(knet_channel_ref_get_ringbuffer(stream->channel_ref), size);
+    knet_channel_ref_check_recv_resume(stream->channel_ref);
+    return error;
 }
 
 int knet_stream_push(kstream_t* stream, const void* buffer, int size) {
@@ -106,6 +128,33 @@ int knet_stream_push(kstream_t* stream, const void* buffer, int size) {
     return knet_channel_ref_write(stream->channel_ref, (char*)buffer, size);
 }
 
+int knet_stream_pushv(kstream_t* stream, const kiovec_t* iov, int count) {
+    verify(stream);
+    verify(iov);
+    if (count <= 0) {
+        return error_ok;
+    }
+    return knet_channel_ref_writev(stream->channel_ref, iov, count);
+}
+
+int knet_stream_push_owned(kstream_t* stream, void* buffer, int size, knet_write_free_cb_t free_cb, void* ctx) {
+    verify(stream);
+    verify(buffer);
+    verify(free_cb);
+    if (!size) {
+        free_cb(buffer, size, ctx);
+        return 0;
+    }
+    return knet_channel_ref_write_owned(stream->channel_ref, buffer, size, free_cb, ctx);
+}
+
+int knet_stream_push_buffer(kstream_t* stream, kbuffer_t* buffer) {
+    verify(stream);
+    verify(buffer);
+    return knet_stream_push_owned(stream, knet_buffer_get_ptr(buffer), (int)knet_buffer_get_length(buffer),
+        knet_buffer_free_cb, buffer);
+}
+
 int knet_stream_push_varg(kstream_t* stream, const char* format, ...) {
     char buffer[1024] = {0};
     int len           = 0;
@@ -142,6 +191,16 @@ int knet_stream_copy(kstream_t* stream, void* buffer, int size) {
     return error_ok;
 }
 
+const char* knet_stream_peek(kstream_t* stream, int* size) {
+    uint32_t    length = 0;
+    const char* ptr    = 0;
+    verify(stream);
+    verify(size);
+    ptr   = ringbuffer_peek(knet_channel_ref_get_ringbuffer(stream->channel_ref), &length);
+    *size = (int)length;
+    return ptr;
+}
+
 int knet_stream_replace(kstream_t* stream, int pos, void* buffer, int size) {
     if (!size) {
         return error_recv_fail;
@@ -199,6 +258,7 @@ int knet_stream_push_stream(kstream_t* stream, kstream_t* target) {
         }
     }
     ringbuffer_read_unlock(rb);
+    knet_channel_ref_check_recv_resume(stream->channel_ref);
     return error_ok;
 }
 
@@ -230,6 +290,7 @@ int knet_stream_push_stream_count(kstream_t* stream, kstream_t* target, int coun
         }
     }
     ringbuffer_read_unlock(rb);
+    knet_channel_ref_check_recv_resume(stream->channel_ref);
     return error_ok;
 }
 
@@ -278,6 +339,7 @@ int knet_stream_drain_ringbuffer(kstream_t* stream, kringbuffer_t* target) {
         }
     }
     ringbuffer_read_unlock(rb);
+    knet_channel_ref_check_recv_resume(stream->channel_ref);
     return error_ok;
 }
 
@@ -35,6 +35,20 @@
  */
 kstream_t* stream_create(kchannel_ref_t* channel_ref);
 
+/**
+ * ȡùܵ, ڽܵǶ뵽ڴ
+ * @return ܵ
+ */
+uint32_t stream_get_object_size();
+
+/**
+ * ڵṩڴϳʼܵ, stream_destroyͷڴ
+ * @param stream Ϊstream_get_object_size()ڴ
+ * @param channel_ref kchannel_ref_tʵ
+ * @return kstream_tʵ
+ */
+kstream_t* stream_init(kstream_t* stream, kchannel_ref_t* channel_ref);
+
 /**
  * ٹܵ
  * @param stream kstream_tʵ
@@ -107,6 +107,7 @@ extern int thread_runner_start_timer_loop(kthread_runner_t* runner, ktimer_loop_
  * ߳kloop_tktimer_loop_t
  *
  * formatڿжkloop_tlktimer_loop_ttƩ磺ltʶһkloop_tһktimer_loop_t
+ * kloop_tѡȡȴʱ佫Ϊ1, μknet_loop_set_max_wait
  * @param runner kthread_runner_tʵ
  * @param stack_size ջС
  * @param format ַ
@@ -154,6 +155,12 @@ extern thread_id_t thread_get_self_id();
  */
 extern void thread_sleep_ms(int ms);
 
+/**
+ * ˯, Windowsȡ
+ * @param us ˯ʱ䣨΢룩
+ */
+extern void thread_sleep_us(int us);
+
 /**
  * ̱߳ش洢
  * @param runner kthread_runner_tʵ
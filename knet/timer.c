@@ -28,6 +28,16 @@
 #include "logger.h"
 #include "rb_tree.h"
 
+#define TIMER_WHEEL_ROOT_BITS  8 /* һʱֲλ */
+#define TIMER_WHEEL_LEVEL_BITS 6 /* ʱֲλ */
+#define TIMER_WHEEL_LEVELS     4 /* һĲ */
+#define TIMER_WHEEL_ROOT_SIZE  (1 << TIMER_WHEEL_ROOT_BITS)
+#define TIMER_WHEEL_LEVEL_SIZE (1 << TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_ROOT_MASK  (TIMER_WHEEL_ROOT_SIZE - 1)
+#define TIMER_WHEEL_LEVEL_MASK (TIMER_WHEEL_LEVEL_SIZE - 1)
+#define TIMER_WHEEL_SLOTS      (TIMER_WHEEL_ROOT_SIZE + TIMER_WHEEL_LEVELS * TIMER_WHEEL_LEVEL_SIZE)
+#define TIMER_WHEEL_MAX_TICKS  0xffffffffULL /* ڵδ, ԶĶʱһȴ */
+
 /**
  * ʱ
  */
@@ -43,16 +53,25 @@ struct _ktimer_t {
     int             times;         /*  */
     int             current_times; /* ǰ */
     int             stop;          /* ֹ־ */
+    int             running;       /* Ƿڵûص, ʱʹ */
+    ktimer_node_t   node;          /* ʱֽڵ, ʱʹ */
 };
 
 /**
  * ʱѭ
  */
 struct _ktimer_loop_t {
-    krbtree_t* timer_tree; /*  */
-    int        running;    /* б־ */
-    uint64_t   last_tick;  /* һεѭʱ䣨룩 */
-    uint64_t   freq;       /* ѭü() */
+    ktimer_loop_type_e type;       /* ʱѭ */
+    krbtree_t*         timer_tree; /*  */
+    int                running;    /* б־ */
+    uint64_t           last_tick;  /* һεѭʱ䣨룩 */
+    uint64_t           freq;       /* ѭü() */
+    /* ֲʱ */
+    ktimer_node_t*     slots;      /* вĲ(ͷ), һǰ */
+    uint64_t           bitmap[TIMER_WHEEL_ROOT_SIZE / 64]; /* һǿղλͼ */
+    uint64_t           tick;       /* δ𳤶ȣ΢룩 */
+    uint64_t           current;    /* һҪĵδ */
+    uint32_t           count;      /* ʱڶʱ */
 };
 
 /**
@@ -79,6 +98,96 @@ int _ktimer_add_node(ktimer_t* timer, kdlist_node_t* node, time_t ms);
  */
 int _ktimer_add(ktimer_t* timer, time_t ms);
 
+/**
+ * ʱ϶뵽ڵ, ͬһڵĶʱһ
+ * @param value ʱ䣨δ
+ * @param window ڳ, С2ʱ
+ * @return ĵʱ
+ */
+uint64_t _ktimer_align(uint64_t value, uint64_t window);
+
+/**
+ * ʱֽڵĵڵδ
+ * @param timer_loop ʱѭ
+ * @param node ʱֽڵ
+ * @param us ʱ΢룩
+ * @return ڵδ
+ */
+uint64_t _ktimer_node_get_expire(ktimer_loop_t* timer_loop, ktimer_node_t* node, uint64_t us);
+
+/**
+ * 鶨ʱǷѾڵûص
+ * @param timer ʱ
+ * @retval 0 δ
+ * @retval  Ѿ
+ */
+int _ktimer_check_start(ktimer_t* timer);
+
+/**
+ * ʱֽڵ
+ * @param node ʱֽڵ
+ * @param cb ص
+ * @param data ص
+ * @param us ʱ΢룩
+ * @param intval ڣ΢룩, 0Ϊֻһ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+int _ktimer_node_start(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, uint64_t us, uint64_t intval);
+
+/**
+ * ktimer_tʱڵĽڵص, ʱͺ
+ * @param node ʱֽڵ
+ * @param data ʱ
+ */
+void _ktimer_wheel_cb(ktimer_node_t* node, void* data);
+
+/**
+ * ڵʱ, ݵڵδ뵱ǰδľѡڲ
+ * @param timer_loop ʱѭ
+ * @param node ʱֽڵ
+ */
+void _ktimer_wheel_add(ktimer_loop_t* timer_loop, ktimer_node_t* node);
+
+/**
+ * ڵʱȡ
+ * @param timer_loop ʱѭ
+ * @param node ʱֽڵ
+ */
+void _ktimer_wheel_remove(ktimer_loop_t* timer_loop, ktimer_node_t* node);
+
+/**
+ * ϲڵĽڵ·ʱ
+ * @param timer_loop ʱѭ
+ * @param level , 1ʼ
+ * @return ڲڵ
+ */
+int _ktimer_wheel_cascade(ktimer_loop_t* timer_loop, int level);
+
+/**
+ * ҵһindexʼĵһǿղ
+ * @param timer_loop ʱѭ
+ * @param index ʼ
+ * @return , ûзǿղʱTIMER_WHEEL_ROOT_SIZE
+ */
+int _ktimer_wheel_find(ktimer_loop_t* timer_loop, int index);
+
+/**
+ * ʱڵڵĶʱ
+ * @param timer_loop ʱѭ
+ * @param us ǰʱ΢룩
+ * @return ʱʱ
+ */
+int _ktimer_wheel_run_once(ktimer_loop_t* timer_loop, uint64_t us);
+
+/**
+ * ȡʱҪʱ
+ * @param timer_loop ʱѭ
+ * @retval 0 ûжʱ
+ * @retval  ʱ΢룩
+ */
+uint64_t _ktimer_wheel_get_next_expire(ktimer_loop_t* timer_loop);
+
 void _rb_node_destroy_cb(void* ptr, uint64_t key) {
     kdlist_node_t* node = 0;
     kdlist_node_t* temp = 0;
@@ -121,11 +230,17 @@ int _ktimer_add_node(ktimer_t* timer, kdlist_node_t* node, time_t ms) {
 int _ktimer_add(ktimer_t* timer, time_t ms) {
     kdlist_t*  list = 0;
     krbnode_t* rb_node = 0;
+    if (timer->timer_loop->type == ktimer_loop_type_wheel) {
+        /* ʹǶʱֽڵ, ڴ */
+        return _ktimer_node_start(&timer->node, _ktimer_wheel_cb, timer, (uint64_t)ms * 1000,
+            (timer->type == ktimer_type_once) ? 0 : (uint64_t)ms * 1000);
+    }
+    /* ͬһ(ͬһݲ)ڵĶʱһڵ */
+    ms = (time_t)_ktimer_align(time_get_milliseconds_19700101() + ms, timer->node.slack / 1000);
     rb_node = krbtree_find(timer->timer_loop->timer_tree, ms);
     if (!rb_node) {
         list    = dlist_create();
-        rb_node = krbnode_create(time_get_milliseconds_19700101() + ms,
-            list, _rb_node_destroy_cb);
+        rb_node = krbnode_create(ms, list, _rb_node_destroy_cb);
         /* ڵ */
         krbtree_insert(timer->timer_loop->timer_tree, rb_node);
     }
@@ -138,20 +253,285 @@ int _ktimer_add(ktimer_t* timer, time_t ms) {
     return error_ok;
 }
 
+uint64_t _ktimer_align(uint64_t value, uint64_t window) {
+    if (window < 2) {
+        return value;
+    }
+    return (value + window - 1) / window * window;
+}
+
+uint64_t _ktimer_node_get_expire(ktimer_loop_t* timer_loop, ktimer_node_t* node, uint64_t us) {
+    /* ȡ, ʱǰ */
+    return _ktimer_align((us + timer_loop->tick - 1) / timer_loop->tick, node->slack / timer_loop->tick);
+}
+
+int _ktimer_check_start(ktimer_t* timer) {
+    return (timer->current_list || timer->running || (timer->node.slot >= 0));
+}
+
+int _ktimer_node_start(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, uint64_t us, uint64_t intval) {
+    ktimer_loop_t* timer_loop = node->timer_loop;
+    if (timer_loop->type != ktimer_loop_type_wheel) {
+        /* ҪΪÿʱڵ */
+        return error_invalid_parameters;
+    }
+    if (node->slot >= 0) {
+        return error_multiple_start;
+    }
+    node->cb     = cb;
+    node->data   = data;
+    node->intval = intval;
+    node->expire = _ktimer_node_get_expire(timer_loop, node, time_get_microseconds_19700101() + us);
+    _ktimer_wheel_add(timer_loop, node);
+    return error_ok;
+}
+
+void _ktimer_wheel_cb(ktimer_node_t* node, void* data) {
+    ktimer_t* timer = (ktimer_t*)data;
+    /* صڵktimer_stopֹֻ־ */
+    timer->running = 1;
+    timer->cb(timer, timer->data);
+    timer->running = 0;
+    timer->current_times += 1;
+    if (timer->stop || ktimer_check_dead(timer)) {
+        /* ڽڵѾŻʱ */
+        ktimer_node_stop(node);
+        ktimer_destroy(timer);
+    }
+}
+
+void _ktimer_wheel_add(ktimer_loop_t* timer_loop, ktimer_node_t* node) {
+    uint64_t       expire = node->expire;
+    uint64_t       idx    = 0;
+    int            slot   = 0;
+    ktimer_node_t* head   = 0;
+    if (expire < timer_loop->current) {
+        /* Ѿ, һδ */
+        expire = timer_loop->current;
+    }
+    idx = expire - timer_loop->current;
+    if (idx > TIMER_WHEEL_MAX_TICKS) {
+        expire = timer_loop->current + TIMER_WHEEL_MAX_TICKS;
+        idx    = TIMER_WHEEL_MAX_TICKS;
+    }
+    if (idx < TIMER_WHEEL_ROOT_SIZE) {
+        slot = (int)(expire & TIMER_WHEEL_ROOT_MASK);
+        timer_loop->bitmap[slot >> 6] |= (1ULL << (slot & 63));
+    } else {
+        /* level㸲ǵľΪ1 << (TIMER_WHEEL_ROOT_BITS + level * TIMER_WHEEL_LEVEL_BITS) */
+        for (slot = 1; slot < TIMER_WHEEL_LEVELS; slot++) {
+            if (idx < (1ULL << (TIMER_WHEEL_ROOT_BITS + slot * TIMER_WHEEL_LEVEL_BITS))) {
+                break;
+            }
+        }
+        slot = TIMER_WHEEL_ROOT_SIZE + (slot - 1) * TIMER_WHEEL_LEVEL_SIZE +
+            (int)((expire >> (TIMER_WHEEL_ROOT_BITS + (slot - 1) * TIMER_WHEEL_LEVEL_BITS)) & TIMER_WHEEL_LEVEL_MASK);
+    }
+    /* β */
+    head             = &timer_loop->slots[slot];
+    node->slot       = slot;
+    node->prev       = head->prev;
+    node->next       = head;
+    head->prev->next = node;
+    head->prev       = node;
+    timer_loop->count++;
+}
+
+void _ktimer_wheel_remove(ktimer_loop_t* timer_loop, ktimer_node_t* node) {
+    ktimer_node_t* head = &timer_loop->slots[node->slot];
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    if ((node->slot < TIMER_WHEEL_ROOT_SIZE) && (head->next == head)) {
+        timer_loop->bitmap[node->slot >> 6] &= ~(1ULL << (node->slot & 63));
+    }
+    node->prev = 0;
+    node->next = 0;
+    node->slot = -1;
+    timer_loop->count--;
+}
+
+int _ktimer_wheel_cascade(ktimer_loop_t* timer_loop, int level) {
+    int            index = (int)((timer_loop->current >> (TIMER_WHEEL_ROOT_BITS + (level - 1) * TIMER_WHEEL_LEVEL_BITS)) &
+        TIMER_WHEEL_LEVEL_MASK);
+    ktimer_node_t* head  = &timer_loop->slots[TIMER_WHEEL_ROOT_SIZE + (level - 1) * TIMER_WHEEL_LEVEL_SIZE + index];
+    ktimer_node_t* node  = 0;
+    ktimer_node_t* next  = 0;
+    if (head->next == head) {
+        return index;
+    }
+    /* ժ, һĽڵܱŻͬһ */
+    node       = head->next;
+    head->prev->next = 0;
+    head->next = head;
+    head->prev = head;
+    for (; node; node = next) {
+        next = node->next;
+        timer_loop->count--;
+        /* 뵽ڸ, ² */
+        _ktimer_wheel_add(timer_loop, node);
+    }
+    return index;
+}
+
+int _ktimer_wheel_find(ktimer_loop_t* timer_loop, int index) {
+    uint64_t word = 0;
+    while (index < TIMER_WHEEL_ROOT_SIZE) {
+        word = timer_loop->bitmap[index >> 6] >> (index & 63);
+        if (!word) {
+            /*  */
+            index = (index | 63) + 1;
+            continue;
+        }
+        while (!(word & 1)) {
+            word >>= 1;
+            index++;
+        }
+        return index;
+    }
+    return TIMER_WHEEL_ROOT_SIZE;
+}
+
+int _ktimer_wheel_run_once(ktimer_loop_t* timer_loop, uint64_t us) {
+    uint64_t       target = us / timer_loop->tick; /* ˵δΪֹ */
+    uint64_t       next   = 0;
+    ktimer_node_t* node   = 0;
+    ktimer_node_t* head   = 0;
+    int            index  = 0;
+    int            level  = 0;
+    int            count  = 0;
+    if (!timer_loop->count) {
+        /* ûжʱ, ֱǰδ */
+        if (timer_loop->current <= target) {
+            timer_loop->current = target + 1;
+        }
+        return 0;
+    }
+    while (timer_loop->current <= target) {
+        index = (int)(timer_loop->current & TIMER_WHEEL_ROOT_MASK);
+        if (!index) {
+            /* һתһȦ, 㽫ϲڵĶʱ² */
+            for (level = 1; level <= TIMER_WHEEL_LEVELS; level++) {
+                if (_ktimer_wheel_cascade(timer_loop, level)) {
+                    break;
+                }
+            }
+        }
+        /* صڼĽڵ㵽ڵδ𶼴target, 뵱ǰ */
+        head = &timer_loop->slots[index];
+        while (head->next != head) {
+            node = head->next;
+            _ktimer_wheel_remove(timer_loop, node);
+            if (node->intval) {
+                /* ڽڵȷŻʱ, صڿֹͣ */
+                node->expire = _ktimer_node_get_expire(timer_loop, node, us + node->intval);
+                _ktimer_wheel_add(timer_loop, node);
+            }
+            count += 1;
+            /* صغٷʽڵ, صڿͷŽڵڵĶ */
+            node->cb(node, node->data);
+        }
+        if (!timer_loop->count) {
+            timer_loop->current = target + 1;
+            break;
+        }
+        /* һĿղ, ԽһҪ㴦ĵδ */
+        next = timer_loop->current - index + _ktimer_wheel_find(timer_loop, index + 1);
+        timer_loop->current = (next > target + 1) ? target + 1 : next;
+    }
+    return count;
+}
+
+uint64_t _ktimer_wheel_get_next_expire(ktimer_loop_t* timer_loop) {
+    uint64_t       start = 0;
+    uint64_t       round = 0;
+    uint64_t       next  = 0;
+    ktimer_node_t* head  = 0;
+    int            shift = 0;
+    int            level = 0;
+    int            index = 0;
+    int            i     = 0;
+    if (!timer_loop->count) {
+        return 0;
+    }
+    index = (int)(timer_loop->current & TIMER_WHEEL_ROOT_MASK);
+    start = timer_loop->current - index;
+    i     = _ktimer_wheel_find(timer_loop, index);
+    if (i < TIMER_WHEEL_ROOT_SIZE) {
+        /* һ㱾ȦڵĲ */
+        return (start + i) * timer_loop->tick;
+    }
+    /* нڵ㶼ڵǰδ֮TIMER_WHEEL_MAX_TICKSڵ */
+    next = timer_loop->current + TIMER_WHEEL_MAX_TICKS + 1;
+    i    = _ktimer_wheel_find(timer_loop, 0);
+    if (i < TIMER_WHEEL_ROOT_SIZE) {
+        /* һһȦĲ */
+        next = start + TIMER_WHEEL_ROOT_SIZE + i;
+    }
+    /* ϲĲڵδΪ1 << shiftʱ², ȡһǿղ۱²ĵδ */
+    for (level = 1; level <= TIMER_WHEEL_LEVELS; level++) {
+        shift = TIMER_WHEEL_ROOT_BITS + (level - 1) * TIMER_WHEEL_LEVEL_BITS;
+        round = (timer_loop->current + (1ULL << shift) - 1) >> shift;
+        for (i = 0; (i < TIMER_WHEEL_LEVEL_SIZE) && (((round + i) << shift) < next); i++) {
+            head = &timer_loop->slots[TIMER_WHEEL_ROOT_SIZE + (level - 1) * TIMER_WHEEL_LEVEL_SIZE +
+                (int)((round + i) & TIMER_WHEEL_LEVEL_MASK)];
+            if (head->next != head) {
+                next = (round + i) << shift;
+                break;
+            }
+        }
+    }
+    return next * timer_loop->tick;
+}
+
 ktimer_loop_t* ktimer_loop_create(time_t freq) {
+    return ktimer_loop_create_with_type(freq, ktimer_loop_type_rbtree);
+}
+
+ktimer_loop_t* ktimer_loop_create_with_type(time_t freq, ktimer_loop_type_e type) {
+    int            i          = 0;
     ktimer_loop_t* timer_loop = knet_create(ktimer_loop_t);
     verify(timer_loop);
     memset(timer_loop, 0, sizeof(ktimer_loop_t));
-    timer_loop->last_tick  = time_get_milliseconds_19700101();
-    timer_loop->timer_tree = krbtree_create();
-    timer_loop->freq       = freq;
+    timer_loop->type      = type;
+    timer_loop->last_tick = time_get_milliseconds_19700101();
+    timer_loop->freq      = freq;
+    if (type == ktimer_loop_type_wheel) {
+        /* δ𳤶Сֱͬ */
+        timer_loop->tick    = (freq > 0 ? (uint64_t)freq : 1) * 1000;
+        timer_loop->current = time_get_microseconds_19700101() / timer_loop->tick;
+        timer_loop->slots   = knet_create_type(ktimer_node_t, sizeof(ktimer_node_t) * TIMER_WHEEL_SLOTS);
+        verify(timer_loop->slots);
+        memset(timer_loop->slots, 0, sizeof(ktimer_node_t) * TIMER_WHEEL_SLOTS);
+        for (i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+            timer_loop->slots[i].prev = &timer_loop->slots[i];
+            timer_loop->slots[i].next = &timer_loop->slots[i];
+        }
+    } else {
+        timer_loop->timer_tree = krbtree_create();
+    }
     return timer_loop;
 }
 
 void ktimer_loop_destroy(ktimer_loop_t* timer_loop) {
+    int            i    = 0;
+    ktimer_node_t* node = 0;
     verify(timer_loop);
-    /* ٺ */
-    krbtree_destroy(timer_loop->timer_tree);
+    if (timer_loop->type == ktimer_loop_type_wheel) {
+        for (i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+            while (timer_loop->slots[i].next != &timer_loop->slots[i]) {
+                node = timer_loop->slots[i].next;
+                _ktimer_wheel_remove(timer_loop, node);
+                /* ktimer_t, Ƕʽʱɵͷ */
+                if (node->cb == _ktimer_wheel_cb) {
+                    ktimer_destroy((ktimer_t*)node->data);
+                }
+            }
+        }
+        knet_free(timer_loop->slots);
+    } else {
+        /* ٺ */
+        krbtree_destroy(timer_loop->timer_tree);
+    }
     knet_free(timer_loop);
 }
 
@@ -159,7 +539,7 @@ void ktimer_loop_run(ktimer_loop_t* timer_loop) {
     verify(timer_loop);
     timer_loop->running = 1;
     while (timer_loop->running) {
-        thread_sleep_ms((int)timer_loop->freq);
+        ktimer_loop_sleep(timer_loop);
         ktimer_loop_run_once(timer_loop);
     }
 }
@@ -176,10 +556,17 @@ int ktimer_loop_run_once(ktimer_loop_t* timer_loop) {
     kdlist_t*      timers  = 0;
     ktimer_t*      timer   = 0;
     uint64_t       key     = 0;
-    uint64_t       ms      = time_get_milliseconds_19700101(); /* ǰʱ룩 */
+    uint64_t       ms      = 0;
     int            count   = 0;
     verify(timer_loop);
+    if (timer_loop->type == ktimer_loop_type_wheel) {
+        /* ʱ΢ʱ */
+        key = time_get_microseconds_19700101();
+        timer_loop->last_tick = key / 1000;
+        return _ktimer_wheel_run_once(timer_loop, key);
+    }
     /* ¼ϴtickʱ */
+    ms = time_get_milliseconds_19700101();
     timer_loop->last_tick = ms;
     /* ʱСڵ */
     rb_node = krbtree_min(timer_loop->timer_tree);
@@ -209,7 +596,7 @@ int ktimer_loop_run_once(ktimer_loop_t* timer_loop) {
                     /* ܱ, ƶʱڵ */
                     timer->ms = ms + timer->intval;
                     dlist_remove(timers, node);
-                    _ktimer_add_node(timer, node, timer->ms);
+                    _ktimer_add_node(timer, node, (time_t)_ktimer_align(timer->ms, timer->node.slack / 1000));
                 }
             }
         }
@@ -227,6 +614,100 @@ int ktimer_loop_run_once(ktimer_loop_t* timer_loop) {
     return count;
 }
 
+uint64_t ktimer_loop_get_next_expire(ktimer_loop_t* timer_loop) {
+    krbnode_t* rb_node = 0;
+    verify(timer_loop);
+    if (timer_loop->type == ktimer_loop_type_wheel) {
+        return _ktimer_wheel_get_next_expire(timer_loop);
+    }
+    /* ʱСڵ */
+    rb_node = krbtree_min(timer_loop->timer_tree);
+    if (!rb_node) {
+        /* ûжʱ */
+        return 0;
+    }
+    /* ktimer_loop_run_onceֻʱСڵǰʱĽڵ, ȴ1 */
+    return (krbnode_get_key(rb_node) + 1) * 1000;
+}
+
+int ktimer_loop_get_next_timeout(ktimer_loop_t* timer_loop) {
+    time_t us = ktimer_loop_get_next_timeout_us(timer_loop);
+    if (us < 0) {
+        return -1;
+    }
+    /* ȡ, ȴʱʱѾ */
+    if ((us + 999) / 1000 > INT_MAX) {
+        return INT_MAX;
+    }
+    return (int)((us + 999) / 1000);
+}
+
+time_t ktimer_loop_get_next_timeout_us(ktimer_loop_t* timer_loop) {
+    uint64_t expire = ktimer_loop_get_next_expire(timer_loop);
+    uint64_t us     = 0;
+    if (!expire) {
+        /* ûжʱ */
+        return -1;
+    }
+    us = time_get_microseconds_19700101();
+    if (expire <= us) {
+        /* Ѿ */
+        return 0;
+    }
+    return (time_t)(expire - us);
+}
+
+int ktimer_loop_set_tick_us(ktimer_loop_t* timer_loop, time_t us) {
+    int            i     = 0;
+    uint64_t       tick  = 0;
+    ktimer_node_t* head  = 0;
+    ktimer_node_t* node  = 0;
+    ktimer_node_t* next  = 0;
+    ktimer_node_t* nodes = 0;
+    verify(timer_loop);
+    if ((timer_loop->type != ktimer_loop_type_wheel) || (us <= 0)) {
+        return error_invalid_parameters;
+    }
+    tick = timer_loop->tick;
+    if ((uint64_t)us == tick) {
+        return error_ok;
+    }
+    /* ժвڵĽڵ, ɵ */
+    for (i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        head = &timer_loop->slots[i];
+        if (head->next == head) {
+            continue;
+        }
+        head->prev->next = nodes;
+        nodes            = head->next;
+        head->next       = head;
+        head->prev       = head;
+    }
+    memset(timer_loop->bitmap, 0, sizeof(timer_loop->bitmap));
+    timer_loop->count   = 0;
+    timer_loop->tick    = (uint64_t)us;
+    timer_loop->current = timer_loop->current * tick / timer_loop->tick;
+    /* ڵδΪµĵδ𳤶Ⱥ·ʱ */
+    for (node = nodes; node; node = next) {
+        next         = node->next;
+        node->expire = (node->expire * tick + timer_loop->tick - 1) / timer_loop->tick;
+        _ktimer_wheel_add(timer_loop, node);
+    }
+    return error_ok;
+}
+
+void ktimer_loop_sleep(ktimer_loop_t* timer_loop) {
+    time_t us  = ktimer_loop_get_next_timeout_us(timer_loop);
+    time_t max = (time_t)timer_loop->freq * 1000;
+    /* һѭ, ڼĶʱᱻ̫ */
+    if ((us < 0) || (us > max)) {
+        us = max;
+    }
+    if (us > 0) {
+        thread_sleep_us((int)us);
+    }
+}
+
 ktimer_loop_t* ktimer_get_loop(ktimer_t* timer) {
     verify(timer);
     return timer->timer_loop;
@@ -239,6 +720,7 @@ ktimer_t* ktimer_create(ktimer_loop_t* timer_loop) {
     verify(timer);
     memset(timer, 0, sizeof(ktimer_t));
     timer->timer_loop = timer_loop;
+    ktimer_node_init(&timer->node, timer_loop);
     return timer;
 }
 
@@ -267,7 +749,15 @@ time_t ktimer_loop_get_tick_intval(ktimer_loop_t* timer_loop) {
 int ktimer_stop(ktimer_t* timer) {
     verify(timer);
     timer->stop = 1;
-    if (!timer->current_list) {
+    if (timer->running) {
+        /* ԼĻصֹͣ, صغ */
+        return error_ok;
+    }
+    if (timer->timer_loop->type == ktimer_loop_type_wheel) {
+        /* ʱڵĶʱȡ */
+        ktimer_node_stop(&timer->node);
+        ktimer_destroy(timer);
+    } else if (!timer->current_list) {
         /* δĶʱ, δ붨ʱ */
         ktimer_destroy(timer);
     }
@@ -279,18 +769,15 @@ int ktimer_start(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms) {
     verify(cb);
     verify(ms);
     verify(timer->timer_loop);
-    if (timer->current_list) {
+    if (_ktimer_check_start(timer)) {
         return error_multiple_start;
     }
-    if (error_ok != _ktimer_add(timer, ms)) {
-        return error_fail;
-    }
     timer->cb     = cb;
     timer->data   = data;
     timer->type   = ktimer_type_period;
     timer->ms     = time_get_milliseconds_19700101() + ms;
     timer->intval = ms;
-    return error_ok;
+    return _ktimer_add(timer, ms);
 }
 
 int ktimer_start_once(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms) {
@@ -298,18 +785,15 @@ int ktimer_start_once(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms) {
     verify(cb);
     verify(ms);
     verify(timer->timer_loop);
-    if (timer->current_list) {
+    if (_ktimer_check_start(timer)) {
         return error_multiple_start;
     }
-    if (error_ok != _ktimer_add(timer, ms)) {
-        return error_fail;
-    }
     timer->cb     = cb;
     timer->data   = data;
     timer->type   = ktimer_type_once;
     timer->ms     = time_get_milliseconds_19700101() + ms;
     timer->intval = ms;
-    return error_ok;
+    return _ktimer_add(timer, ms);
 }
 
 int ktimer_start_times(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms, int times) {
@@ -317,17 +801,128 @@ int ktimer_start_times(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms, i
     verify(cb);
     verify(ms);
     verify(timer->timer_loop);
-    if (timer->current_list) {
+    if (_ktimer_check_start(timer)) {
         return error_multiple_start;
     }
-    if (error_ok != _ktimer_add(timer, ms)) {
-        return error_fail;
-    }
     timer->cb     = cb;
     timer->data   = data;
     timer->type   = ktimer_type_times;
     timer->times  = times;
     timer->ms     = time_get_milliseconds_19700101() + ms;
     timer->intval = ms;
+    return _ktimer_add(timer, ms);
+}
+
+int ktimer_start_us(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t us) {
+    verify(timer);
+    verify(cb);
+    verify(us > 0);
+    verify(timer->timer_loop);
+    if (timer->timer_loop->type != ktimer_loop_type_wheel) {
+        /* ԺΪ */
+        return error_invalid_parameters;
+    }
+    if (_ktimer_check_start(timer)) {
+        return error_multiple_start;
+    }
+    timer->cb     = cb;
+    timer->data   = data;
+    timer->type   = ktimer_type_period;
+    timer->ms     = time_get_milliseconds_19700101() + us / 1000;
+    timer->intval = us / 1000;
+    return _ktimer_node_start(&timer->node, _ktimer_wheel_cb, timer, (uint64_t)us, (uint64_t)us);
+}
+
+int ktimer_start_once_us(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t us) {
+    verify(timer);
+    verify(cb);
+    verify(us > 0);
+    verify(timer->timer_loop);
+    if (timer->timer_loop->type != ktimer_loop_type_wheel) {
+        /* ԺΪ */
+        return error_invalid_parameters;
+    }
+    if (_ktimer_check_start(timer)) {
+        return error_multiple_start;
+    }
+    timer->cb     = cb;
+    timer->data   = data;
+    timer->type   = ktimer_type_once;
+    timer->ms     = time_get_milliseconds_19700101() + us / 1000;
+    timer->intval = us / 1000;
+    return _ktimer_node_start(&timer->node, _ktimer_wheel_cb, timer, (uint64_t)us, 0);
+}
+
+void ktimer_node_init(ktimer_node_t* node, ktimer_loop_t* timer_loop) {
+    verify(node);
+    verify(timer_loop);
+    memset(node, 0, sizeof(ktimer_node_t));
+    node->timer_loop = timer_loop;
+    node->slot       = -1;
+}
+
+int ktimer_node_start(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t ms) {
+    verify(ms);
+    return ktimer_node_start_us(node, cb, data, ms * 1000);
+}
+
+int ktimer_node_start_once(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t ms) {
+    verify(ms);
+    return ktimer_node_start_once_us(node, cb, data, ms * 1000);
+}
+
+int ktimer_node_restart(ktimer_node_t* node, time_t ms) {
+    verify(ms);
+    return ktimer_node_restart_us(node, ms * 1000);
+}
+
+int ktimer_node_start_us(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t us) {
+    verify(node);
+    verify(cb);
+    verify(us > 0);
+    verify(node->timer_loop);
+    return _ktimer_node_start(node, cb, data, (uint64_t)us, (uint64_t)us);
+}
+
+int ktimer_node_start_once_us(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t us) {
+    verify(node);
+    verify(cb);
+    verify(us > 0);
+    verify(node->timer_loop);
+    return _ktimer_node_start(node, cb, data, (uint64_t)us, 0);
+}
+
+int ktimer_node_restart_us(ktimer_node_t* node, time_t us) {
+    verify(node);
+    verify(us > 0);
+    verify(node->timer_loop);
+    if (!node->cb) {
+        /* δ */
+        return error_invalid_parameters;
+    }
+    ktimer_node_stop(node);
+    return _ktimer_node_start(node, node->cb, node->data, (uint64_t)us, node->intval ? (uint64_t)us : 0);
+}
+
+int ktimer_node_stop(ktimer_node_t* node) {
+    verify(node);
+    if (node->slot >= 0) {
+        _ktimer_wheel_remove(node->timer_loop, node);
+    }
     return error_ok;
 }
+
+int ktimer_node_check_start(ktimer_node_t* node) {
+    verify(node);
+    return (node->slot >= 0);
+}
+
+void ktimer_node_set_slack(ktimer_node_t* node, time_t slack) {
+    verify(node);
+    node->slack = (slack > 0) ? (uint64_t)slack * 1000 : 0;
+}
+
+void ktimer_set_slack(ktimer_t* timer, time_t slack) {
+    verify(timer);
+    ktimer_node_set_slack(&timer->node, slack);
+}
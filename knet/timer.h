@@ -34,4 +34,26 @@
  */
 void ktimer_destroy(ktimer_t* timer);
 
+/**
+ * ȡþһʱڵʱ
+ * @param timer_loop ktimer_loop_tʵ
+ * @retval -1 ûжʱ
+ * @retval  뵽ڵĺ
+ */
+int ktimer_loop_get_next_timeout(ktimer_loop_t* timer_loop);
+
+/**
+ * ȡöʱѭҪʱ
+ * @param timer_loop ktimer_loop_tʵ
+ * @retval 0 ûжʱ
+ * @retval  197011΢
+ */
+uint64_t ktimer_loop_get_next_expire(ktimer_loop_t* timer_loop);
+
+/**
+ * ߵһʱ, һѭ
+ * @param timer_loop ktimer_loop_tʵ
+ */
+void ktimer_loop_sleep(ktimer_loop_t* timer_loop);
+
 #endif /* TIMER_H */
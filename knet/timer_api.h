@@ -27,6 +27,21 @@
 
 #include "config.h"
 
+/**
+ * Ƕʽʱ, Աڲʹ
+ */
+struct _ktimer_node_t {
+    ktimer_node_t*   prev;       /* ǰһڵ */
+    ktimer_node_t*   next;       /* һڵ */
+    ktimer_loop_t*   timer_loop; /* ʱѭ */
+    ktimer_node_cb_t cb;         /* ص */
+    void*            data;       /* ص */
+    uint64_t         expire;     /* ڵδ */
+    uint64_t         intval;     /* ڣ΢룩, 0Ϊֻһ */
+    uint64_t         slack;      /* ݲ΢룩 */
+    int              slot;       /* ʱֲ, -1Ϊδ */
+};
+
 /**
  * @defgroup timer ʱ
  * ʱ
@@ -41,10 +56,24 @@
  * 2. һεĶʱ  ktimer_start_once
  * 3. жεĶʱ  ktimer_start_times
  *
- * ʱĴʽͨص봫ͳĶʱʽͬڲʵֲ
- * ʱļɾʱ临ӶȶO(logn)
+ * ʱĴʽͨص봫ͳĶʱʽͬڲʵֿڴ
+ * ʱѭʱѡ:
+ *
+ * 1.           ktimer_loop_create, ʱļɾʱ临ӶȶO(logn)
+ * 2. ֲʱ      ktimer_loop_create_with_type, ʱļ, ɾ͵ڵʱ临ӶȶO(1),
+ *                    ʺϴʱ, kloop_tڲʹ
+ *
+ * ֲʱֻ֧Ƕʽʱktimer_node_t, ɵΪṹԱ, ktimer_node_initʼ
+ * Է, ֹͣ, ڴ. ֹͣ߿ʱͷڵĶ.
+ *
+ * ҪȷĶʱ(, Ե)Եktimer_set_slackݲ, ʱ϶뵽ݲ
+ * , ͬһڵĶʱһ, ٶʱѭ(kloop_t)ĻѴ.
  *
- * ktimer_loop_runڲʹòϵͳṩĺ뼶˯ߺģֹCPUת
+ * ֲʱڲ΢ʱ, ktimer_loop_set_tick_usԽδ̵1, *_usϵк
+ * ΢뼶ʱ. kloop_tڵʱͨknet_loop_enable_hrtimer, epolltimerfd
+ * ĵʱ份.
+ *
+ * ktimer_loop_runڲߵĶʱ(freq)ֹCPUת
  * ϵͳṩ˯ߺͨǲ׼ȷģ˯>=ʱƬͨΪٷ֮2,
  * ڷǺ뼶ȷͨǹõģǵ10ֱʵĶʱзǳҪ
  * ȷĶʱҪòϵͳ߷ֱʱ亯д.
@@ -60,6 +89,33 @@
  */
 extern ktimer_loop_t* ktimer_loop_create(time_t freq);
 
+/**
+ * ָ͵Ķʱѭ
+ *
+ * ֲʱfreqΪδ𳤶, ʱʱȡδ, ԶʱΪ2^32δ
+ * @param freq Сֱʣ룩, ʱΪ0ʱδ𳤶Ϊ1
+ * @param type ʱѭ
+ * @return ktimer_loop_tʵ
+ */
+extern ktimer_loop_t* ktimer_loop_create_with_type(time_t freq, ktimer_loop_type_e type);
+
+/**
+ * ÷ֲʱֵĵδ𳤶, ѾĶʱԭʱ·ʱ
+ * @param timer_loop ktimer_loop_tʵ
+ * @param us δ𳤶ȣ΢룩
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters ʱѭǷֲʱֻus
+ */
+extern int ktimer_loop_set_tick_us(ktimer_loop_t* timer_loop, time_t us);
+
+/**
+ * ȡþһʱڵʱ
+ * @param timer_loop ktimer_loop_tʵ
+ * @retval -1 ûжʱ
+ * @retval  뵽ڵ΢
+ */
+extern time_t ktimer_loop_get_next_timeout_us(ktimer_loop_t* timer_loop);
+
 /**
  * ٶʱѭ
  * @return ktimer_loop_tʵ
@@ -141,6 +197,39 @@ extern int ktimer_start_once(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t
  */
 extern int ktimer_start_times(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms, int times);
 
+/**
+ * һԶʱ, ʱ΢, ֻڷֲʱ
+ * @param timer ktimer_tʵ
+ * @param cb ʱص
+ * @param data ص
+ * @param us ʱʱ΢룩
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters ʱѭǷֲʱ
+ * @retval  ʧ
+ */
+extern int ktimer_start_us(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t us);
+
+/**
+ * һֻһεĶʱ, ʱ΢, ֻڷֲʱ
+ * @param timer ktimer_tʵ
+ * @param cb ʱص
+ * @param data ص
+ * @param us ʱʱ΢룩
+ * @retval error_ok ɹ
+ * @retval error_invalid_parameters ʱѭǷֲʱ
+ * @retval  ʧ
+ */
+extern int ktimer_start_once_us(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t us);
+
+/**
+ * öʱݲ, һ(ڶʱһ)ʱЧ
+ *
+ * ʱ϶뵽slack, Ƴslack, ǰ
+ * @param timer ktimer_tʵ
+ * @param slack ݲ룩, 0Ϊ
+ */
+extern void ktimer_set_slack(ktimer_t* timer, time_t slack);
+
 /**
  * 鶨ʱǷڻصؼ
  * @param timer ktimer_tʵ
@@ -156,6 +245,103 @@ extern int ktimer_check_dead(ktimer_t* timer);
  */
 extern time_t ktimer_loop_get_tick_intval(ktimer_loop_t* timer_loop);
 
+/**
+ * ʼǶʽʱ
+ * @param node ktimer_node_tʵ
+ * @param timer_loop ֲʱ͵ktimer_loop_tʵ
+ */
+extern void ktimer_node_init(ktimer_node_t* node, ktimer_loop_t* timer_loop);
+
+/**
+ * ԵǶʽʱ
+ *
+ * صǰڵѾ·ʱ, ͷڶǰҪktimer_node_stop
+ * @param node ktimer_node_tʵ
+ * @param cb ʱص
+ * @param data ص
+ * @param ms ʱʱ룩
+ * @retval error_ok ɹ
+ * @retval error_multiple_start Ѿ
+ * @retval error_invalid_parameters ʱѭǷֲʱ
+ */
+extern int ktimer_node_start(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t ms);
+
+/**
+ * ֻʱһεǶʽʱ
+ *
+ * صǰڵѾȡ, صڿڵͷڶ
+ * @param node ktimer_node_tʵ
+ * @param cb ʱص
+ * @param data ص
+ * @param ms ʱʱ룩
+ * @retval error_ok ɹ
+ * @retval error_multiple_start Ѿ
+ * @retval error_invalid_parameters ʱѭǷֲʱ
+ */
+extern int ktimer_node_start_once(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t ms);
+
+/**
+ * ʹϴʱĻص, µĳʱǶʽʱ
+ * @param node ktimer_node_tʵ
+ * @param ms ʱʱ룩
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+extern int ktimer_node_restart(ktimer_node_t* node, time_t ms);
+
+/**
+ * Ƕʽʱ, ktimer_node_startͬ, ʱ΢
+ * @param node ktimer_node_tʵ
+ * @param cb ʱص
+ * @param data ص
+ * @param us ʱʱ΢룩
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+extern int ktimer_node_start_us(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t us);
+
+/**
+ * ֻһεǶʽʱ, ktimer_node_start_onceͬ, ʱ΢
+ * @param node ktimer_node_tʵ
+ * @param cb ʱص
+ * @param data ص
+ * @param us ʱʱ΢룩
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+extern int ktimer_node_start_once_us(ktimer_node_t* node, ktimer_node_cb_t cb, void* data, time_t us);
+
+/**
+ * µĳʱǶʽʱ, ktimer_node_restartͬ, ʱ΢
+ * @param node ktimer_node_tʵ
+ * @param us ʱʱ΢룩
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+extern int ktimer_node_restart_us(ktimer_node_t* node, time_t us);
+
+/**
+ * ֹͣǶʽʱ, δʱκ, ڻصڵ
+ * @param node ktimer_node_tʵ
+ * @retval error_ok ɹ
+ */
+extern int ktimer_node_stop(ktimer_node_t* node);
+
+/**
+ * Ƕʽʱݲ, ktimer_set_slackͬ
+ * @param node ktimer_node_tʵ
+ * @param slack ݲ룩, 0Ϊ
+ */
+extern void ktimer_node_set_slack(ktimer_node_t* node, time_t slack);
+
+/**
+ * ǶʽʱǷѾ
+ * @param node ktimer_node_tʵ
+ * @retval 0 δ
+ * @retval  Ѿ
+ */
+extern int ktimer_node_check_start(ktimer_node_t* node);
+
 /** @} */
 
 #endif /* TIMER_API_H */
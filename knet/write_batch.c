@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "write_batch.h"
+#include "loop.h"
+#include "channel_ref.h"
+#include "buffer.h"
+#include "list.h"
+#include "misc.h"
+#include "logger.h"
+
+#define WRITE_BATCH_DEFAULT_SIZE 16384 /* Ĭݴ滺 */
+
+/**
+ * ݼ¼ͷ, ݽ, ͷ֤
+ */
+typedef struct _write_batch_record_t {
+    kchannel_ref_t* channel_ref; /* Ŀܵ */
+    uint32_t        size;        /* ݳ */
+} write_batch_record_t;
+
+/**
+ * ͬһkloop_tݴ滺
+ */
+typedef struct _write_batch_stage_t {
+    kloop_t*        loop;        /* Ŀkloop_t */
+    kbuffer_t*      buffer;      /* ݴ滺, ͶݺȨƽĿkloop_t */
+    uint32_t        last;        /* һ¼ͷƫ */
+    kchannel_ref_t* channel_ref; /* һ¼Ŀܵ */
+    uint64_t        first_ms;    /* һ¼дʱ䣨룩 */
+} write_batch_stage_t;
+
+struct _write_batch_t {
+    kdlist_t*            stage_list; /* ݴ滺 */
+    write_batch_stage_t* last_stage; /* һʹõݴ滺 */
+    uint32_t             size;       /* ݴ滺 */
+    uint32_t             max_delay;  /* ݴȴʱ䣨룩 */
+};
+
+kwrite_batch_t* knet_write_batch_create(uint32_t size, uint32_t max_delay) {
+    kwrite_batch_t* batch = knet_create(kwrite_batch_t);
+    verify(batch);
+    memset(batch, 0, sizeof(kwrite_batch_t));
+    batch->stage_list = dlist_create();
+    verify(batch->stage_list);
+    batch->size      = size ? size : WRITE_BATCH_DEFAULT_SIZE;
+    batch->max_delay = max_delay;
+    return batch;
+}
+
+void write_batch_stage_flush(write_batch_stage_t* stage) {
+    verify(stage);
+    if (!stage->buffer) {
+        return;
+    }
+    /* ݴ滺Ϊһ߳¼Ͷ */
+    knet_loop_notify_send_batch(stage->loop, stage->buffer);
+    stage->buffer      = 0;
+    stage->channel_ref = 0;
+}
+
+void knet_write_batch_destroy(kwrite_batch_t* batch) {
+    kdlist_node_t*       node  = 0;
+    kdlist_node_t*       temp  = 0;
+    write_batch_stage_t* stage = 0;
+    verify(batch);
+    dlist_for_each_safe(batch->stage_list, node, temp) {
+        stage = (write_batch_stage_t*)dlist_node_get_data(node);
+        write_batch_stage_flush(stage);
+        knet_free(stage);
+    }
+    dlist_destroy(batch->stage_list);
+    knet_free(batch);
+}
+
+void knet_write_batch_flush(kwrite_batch_t* batch) {
+    kdlist_node_t* node = 0;
+    kdlist_node_t* temp = 0;
+    verify(batch);
+    dlist_for_each_safe(batch->stage_list, node, temp) {
+        write_batch_stage_flush((write_batch_stage_t*)dlist_node_get_data(node));
+    }
+}
+
+write_batch_stage_t* write_batch_get_stage(kwrite_batch_t* batch, kloop_t* loop, int create) {
+    kdlist_node_t*       node  = 0;
+    kdlist_node_t*       temp  = 0;
+    write_batch_stage_t* stage = 0;
+    if (batch->last_stage && (batch->last_stage->loop == loop)) {
+        return batch->last_stage;
+    }
+    dlist_for_each_safe(batch->stage_list, node, temp) {
+        stage = (write_batch_stage_t*)dlist_node_get_data(node);
+        if (stage->loop == loop) {
+            batch->last_stage = stage;
+            return stage;
+        }
+    }
+    if (!create) {
+        return 0;
+    }
+    stage = knet_create(write_batch_stage_t);
+    verify(stage);
+    memset(stage, 0, sizeof(write_batch_stage_t));
+    stage->loop = loop;
+    dlist_add_tail_node(batch->stage_list, stage);
+    batch->last_stage = stage;
+    return stage;
+}
+
+int knet_write_batch_push(kwrite_batch_t* batch, kchannel_ref_t* channel_ref, const void* data, int size) {
+    kloop_t*             loop   = 0;
+    write_batch_stage_t* stage  = 0;
+    write_batch_record_t record;
+    uint32_t             need   = 0;
+    verify(batch);
+    verify(channel_ref);
+    verify(data);
+    if (size <= 0) {
+        return error_ok;
+    }
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return error_not_connected;
+    }
+    loop = knet_channel_ref_get_loop(channel_ref);
+    if ((knet_loop_get_thread_id(loop) == thread_get_self_id()) ||
+        ((uint32_t)size + sizeof(write_batch_record_t) > batch->size)) {
+        /* Ҫݴ, Ͷݴݱ֤˳ */
+        stage = write_batch_get_stage(batch, loop, 0);
+        if (stage) {
+            write_batch_stage_flush(stage);
+        }
+        return knet_channel_ref_write(channel_ref, (const char*)data, size);
+    }
+    stage = write_batch_get_stage(batch, loop, 1);
+    /* һ¼дͬһܵʱֱ׷ */
+    need = (uint32_t)size;
+    if (stage->channel_ref != channel_ref) {
+        need += sizeof(write_batch_record_t);
+    }
+    if (stage->buffer && (knet_buffer_get_max_size(stage->buffer) - knet_buffer_get_length(stage->buffer) < need)) {
+        write_batch_stage_flush(stage);
+    }
+    if (!stage->buffer) {
+        stage->buffer = knet_buffer_create(batch->size);
+        verify(stage->buffer);
+        if (!stage->buffer) {
+            return error_no_memory;
+        }
+        stage->first_ms = time_get_milliseconds();
+    }
+    if (stage->channel_ref == channel_ref) {
+        memcpy(&record, knet_buffer_get_ptr(stage->buffer) + stage->last, sizeof(record));
+        record.size += (uint32_t)size;
+    } else {
+        stage->last        = knet_buffer_get_length(stage->buffer);
+        stage->channel_ref = channel_ref;
+        record.channel_ref = channel_ref;
+        record.size        = (uint32_t)size;
+        knet_buffer_put(stage->buffer, (const char*)&record, sizeof(record));
+    }
+    memcpy(knet_buffer_get_ptr(stage->buffer) + stage->last, &record, sizeof(record));
+    knet_buffer_put(stage->buffer, (const char*)data, (uint32_t)size);
+    if (!batch->max_delay || (time_get_milliseconds() - stage->first_ms >= batch->max_delay)) {
+        write_batch_stage_flush(stage);
+    }
+    return error_ok;
+}
+
+void knet_write_batch_dispatch(kloop_t* loop, kbuffer_t* buffer) {
+    write_batch_record_t record;
+    char*                ptr = 0;
+    char*                end = 0;
+    verify(loop);
+    verify(buffer);
+    ptr = knet_buffer_get_ptr(buffer);
+    end = ptr + knet_buffer_get_length(buffer);
+    while (ptr + sizeof(record) <= end) {
+        memcpy(&record, ptr, sizeof(record));
+        ptr += sizeof(record);
+        verify(ptr + record.size <= end);
+        /* ͬһֻܵһη */
+        if (knet_channel_ref_check_state(record.channel_ref, channel_state_active)) {
+            knet_channel_ref_update_send_data_in_loop(loop, record.channel_ref, ptr, (int)record.size);
+        }
+        ptr += record.size;
+    }
+}
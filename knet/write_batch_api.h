@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRITE_BATCH_API_H
+#define WRITE_BATCH_API_H
+
+#include "config.h"
+
+/**
+ * д
+ *
+ * дһ̶߳ռʹ, ͬһkloop_tдkloop_tӦݴ滺,
+ * ﵽȻʱֵΪһ߳¼Ͷ, дͬһܵĿ߳ںϲΪһη.
+ * дĹܵͶݲ֮ǰ뱣Ч
+ * @param size ÿkloop_tݴ滺ȣֽڣ, Ϊ0ʱʹĬֵ
+ * @param max_delay ݴȴʱ䣨룩, дʱ, Ϊ0ʱÿдͶ
+ * @return kwrite_batch_tʵ
+ */
+FuncExport kwrite_batch_t* knet_write_batch_create(uint32_t size, uint32_t max_delay);
+
+/**
+ * д, ݴݽͶ
+ * @param batch kwrite_batch_tʵ
+ */
+FuncExport void knet_write_batch_destroy(kwrite_batch_t* batch);
+
+/**
+ * д
+ *
+ * ڹ̵ܵ߳ûݳȳݴ滺ʱ, Ͷݴֱдܵ
+ * @param batch kwrite_batch_tʵ
+ * @param channel_ref ܵ
+ * @param data ָ
+ * @param size ݳ
+ * @retval error_ok ɹ
+ * @retval  ʧ
+ */
+FuncExport int knet_write_batch_push(kwrite_batch_t* batch, kchannel_ref_t* channel_ref, const void* data, int size);
+
+/**
+ * Ͷݴ
+ * @param batch kwrite_batch_tʵ
+ */
+FuncExport void knet_write_batch_flush(kwrite_batch_t* batch);
+
+#endif /* WRITE_BATCH_API_H */
@@ -0,0 +1,126 @@
+#include "knet.h"
+
+#if defined(_MSC_VER )
+#pragma comment(lib,"Ws2_32.lib")
+#endif /* defined(_MSC_VER) */
+
+/*
+ * ӽ/رѹ
+ * ͬʱɸ, ӽر, رպٷµ,
+ * ͳÿ뽨ÿ(ͱܵĹܵ)ڴ
+ */
+
+int             connection_n  = 20000;
+int             concurrency   = 16;
+int             port          = 8000;
+int             connecting_n  = 0;
+int             closed_n      = 0;
+uint64_t        malloc_n      = 0;
+uint64_t        start_ms      = 0;
+uint64_t        start_malloc  = 0;
+
+void* counting_malloc(size_t size) {
+    malloc_n++;
+    return malloc(size);
+}
+
+void* counting_realloc(void* ptr, size_t size) {
+    malloc_n++;
+    return realloc(ptr, size);
+}
+
+void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e);
+
+void start_connect(kloop_t* loop) {
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 0, 1024 * 16);
+    connecting_n++;
+    knet_channel_ref_set_cb(connector, connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", port, 10);
+}
+
+void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+    uint64_t cost  = 0;
+    kloop_t* loop  = knet_channel_ref_get_loop(channel);
+    if (e & channel_cb_event_accept) {
+        knet_channel_ref_set_cb(channel, acceptor_cb);
+    } else if (e & channel_cb_event_close) {
+        /* Զ˹ر, һ */
+        closed_n++;
+        if (closed_n >= connection_n) {
+            cost = time_get_milliseconds() - start_ms;
+            printf("connection: %d, concurrency: %d, cost: %llu ms, %.0f connections/s, "
+                "allocations: %llu, %.2f allocations/connection\n",
+                closed_n, concurrency, (unsigned long long)cost,
+                cost ? (double)closed_n * 1000 / cost : 0.0,
+                (unsigned long long)(malloc_n - start_malloc), (double)(malloc_n - start_malloc) / closed_n);
+            knet_loop_exit(loop);
+        }
+    }
+}
+
+void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+    if (e & channel_cb_event_connect) {
+        knet_channel_ref_close(channel);
+    } else if (e & channel_cb_event_close) {
+        /* һ */
+        if (connecting_n < connection_n) {
+            start_connect(knet_channel_ref_get_loop(channel));
+        }
+    } else if (e & channel_cb_event_connect_timeout) {
+        printf("connect timeout\n");
+        knet_loop_exit(knet_channel_ref_get_loop(channel));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int             i        = 0;
+    kloop_t*        loop     = 0;
+    kchannel_ref_t* acceptor = 0;
+    static const char* helper_string =
+        "-n    connection count, default 20000\n"
+        "-c    concurrent connector count, default 16\n"
+        "-port listen port, default 8000\n";
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp("-n", argv[i])) {
+            connection_n = atoi(argv[i+1]);
+        } else if (!strcmp("-c", argv[i])) {
+            concurrency = atoi(argv[i+1]);
+        } else if (!strcmp("-port", argv[i])) {
+            port = atoi(argv[i+1]);
+        } else {
+            printf("%s", helper_string);
+            return 0;
+        }
+    }
+    if ((connection_n <= 0) || (concurrency <= 0)) {
+        printf("%s", helper_string);
+        return 0;
+    }
+    if (concurrency > connection_n) {
+        concurrency = connection_n;
+    }
+
+    /* ͳоknet_mallocknet_reallocķ */
+    knet_set_malloc_func(counting_malloc);
+    knet_set_realloc_func(counting_realloc);
+
+    loop     = knet_loop_create();
+    acceptor = knet_loop_create_channel(loop, 0, 1024 * 16);
+    knet_channel_ref_set_cb(acceptor, acceptor_cb);
+    if (error_ok != knet_channel_ref_accept(acceptor, 0, port, 1024)) {
+        printf("listen at %d failed\n", port);
+        return 0;
+    }
+
+    start_ms     = time_get_milliseconds();
+    start_malloc = malloc_n;
+    for (i = 0; i < concurrency; i++) {
+        start_connect(loop);
+    }
+
+    knet_loop_run(loop);
+    knet_loop_destroy(loop);
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "knet.h"
+
+#if defined(_MSC_VER )
+#pragma comment(lib,"Ws2_32.lib")
+#endif /* defined(_MSC_VER) */
+
+/*
+ * ߳¼ѹ
+ * ߳ͬʱͬһloopڵĹܵд, ÿд붼һ̷߳¼,
+ * ͳloopյȫݵĺʱ. ʹ-bд, ͬһloop߳ݴϲͶ
+ */
+
+#define MESSAGE_SIZE 100
+
+int             producer_n    = 16;
+int             message_n     = 20000;
+int             port          = 8000;
+int             batch_size    = 0;
+uint64_t        total_bytes   = 0;
+uint64_t        recv_bytes    = 0;
+uint64_t        start_ms      = 0;
+kchannel_ref_t* connector     = 0;
+kchannel_ref_t* holder        = 0;
+kthread_runner_t** producers  = 0;
+
+void producer_func(kthread_runner_t* runner) {
+    int       i                     = 0;
+    char      buffer[MESSAGE_SIZE]  = {0};
+    kstream_t* stream               = knet_channel_ref_get_stream(connector);
+    kwrite_batch_t* batch           = 0;
+    (void)runner;
+    memset(buffer, 'x', sizeof(buffer));
+    if (batch_size) {
+        /* ݴȴ1 */
+        batch = knet_write_batch_create(batch_size, 1);
+        for (i = 0; i < message_n; i++) {
+            knet_write_batch_push(batch, connector, buffer, sizeof(buffer));
+        }
+        knet_write_batch_destroy(batch);
+        return;
+    }
+    for (i = 0; i < message_n; i++) {
+        /* loop߳д, תΪ̷߳¼ */
+        knet_stream_push(stream, buffer, sizeof(buffer));
+    }
+}
+
+void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+    uint64_t   cost   = 0;
+    kstream_t* stream = knet_channel_ref_get_stream(channel);
+    if (e & channel_cb_event_accept) {
+        knet_channel_ref_set_cb(channel, acceptor_cb);
+    } else if (e & channel_cb_event_recv) {
+        recv_bytes += knet_stream_available(stream);
+        knet_stream_eat_all(stream);
+        if (recv_bytes >= total_bytes) {
+            cost = time_get_milliseconds() - start_ms;
+            printf("producer: %d, batch: %d, message: %d, bytes: %llu, cost: %llu ms, %.0f events/s, notify: %llu\n",
+                producer_n, batch_size, producer_n * message_n, (unsigned long long)recv_bytes,
+                (unsigned long long)cost, cost ? (double)producer_n * message_n * 1000 / cost : 0.0,
+                (unsigned long long)knet_loop_profile_get_notify_count(
+                    knet_loop_get_profile(knet_channel_ref_get_loop(channel))));
+            knet_loop_exit(knet_channel_ref_get_loop(channel));
+        }
+    }
+}
+
+void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+    int i = 0;
+    if (e & channel_cb_event_connect) {
+        /* ߳̽ǰֹܵ */
+        holder   = knet_channel_ref_share(channel);
+        start_ms = time_get_milliseconds();
+        for (i = 0; i < producer_n; i++) {
+            producers[i] = thread_runner_create(producer_func, 0);
+            thread_runner_start(producers[i], 0);
+        }
+    } else if (e & channel_cb_event_close) {
+        printf("connector closed, received bytes: %llu\n", (unsigned long long)recv_bytes);
+        knet_loop_exit(knet_channel_ref_get_loop(channel));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int             i        = 0;
+    kloop_t*        loop     = 0;
+    kchannel_ref_t* acceptor = 0;
+    static const char* helper_string =
+        "-p    producer thread count, default 16\n"
+        "-n    message count per producer, default 20000\n"
+        "-port listen port, default 8000\n"
+        "-b    write batch size in bytes, default 0 (no batching)\n";
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp("-p", argv[i])) {
+            producer_n = atoi(argv[i+1]);
+        } else if (!strcmp("-n", argv[i])) {
+            message_n = atoi(argv[i+1]);
+        } else if (!strcmp("-port", argv[i])) {
+            port = atoi(argv[i+1]);
+        } else if (!strcmp("-b", argv[i])) {
+            batch_size = atoi(argv[i+1]);
+        } else {
+            printf("%s", helper_string);
+            return 0;
+        }
+    }
+    if ((producer_n <= 0) || (message_n <= 0) || (batch_size < 0)) {
+        printf("%s", helper_string);
+        return 0;
+    }
+
+    total_bytes = (uint64_t)producer_n * message_n * MESSAGE_SIZE;
+    producers   = (kthread_runner_t**)malloc(sizeof(kthread_runner_t*) * producer_n);
+    memset(producers, 0, sizeof(kthread_runner_t*) * producer_n);
+
+    loop      = knet_loop_create();
+    acceptor  = knet_loop_create_channel(loop, 0, 1024 * 64);
+    connector = knet_loop_create_channel(loop, 0, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, acceptor_cb);
+    knet_channel_ref_set_cb(connector, connector_cb);
+    if (error_ok != knet_channel_ref_accept(acceptor, 0, port, 10)) {
+        printf("listen at %d failed\n", port);
+        return 0;
+    }
+    knet_channel_ref_connect(connector, "127.0.0.1", port, 10);
+
+    knet_loop_run(loop);
+
+    for (i = 0; i < producer_n; i++) {
+        if (producers[i]) {
+            thread_runner_join(producers[i]);
+            thread_runner_destroy(producers[i]);
+        }
+    }
+    free(producers);
+    if (holder) {
+        knet_channel_ref_leave(holder);
+    }
+    knet_loop_destroy(loop);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "knet.h"
+
+#if defined(_MSC_VER )
+#pragma comment(lib,"Ws2_32.lib")
+#endif /* defined(_MSC_VER) */
+
+/*
+ * ߾ȶʱ
+ * kloop_tinterval΢ΪһǶʽʱ, ͳÿδڼƻʱӳ,
+ * ֱĬϵ1ʱֺͿ߾ȶʱ(knet_loop_enable_hrtimer)
+ */
+
+int       fire_n     = 2000;
+int       interval   = 250;
+int       tick       = 50;
+int       fired_n    = 0;
+uint64_t  deadline   = 0;
+uint64_t* lateness   = 0;
+
+void bench_node_cb(ktimer_node_t* node, void* data) {
+    uint64_t now = time_get_microseconds_19700101();
+    kloop_t* loop = (kloop_t*)data;
+    lateness[fired_n++] = (now > deadline) ? now - deadline : 0;
+    /* ڶʱԱδʱΪһεʱ */
+    deadline = now + interval;
+    if (fired_n >= fire_n) {
+        ktimer_node_stop(node);
+        knet_loop_exit(loop);
+    }
+}
+
+int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+void bench(const char* name, int hrtimer) {
+    int           i     = 0;
+    uint64_t      total = 0;
+    uint64_t      cost  = 0;
+    ktimer_node_t node;
+    kloop_t*      loop  = knet_loop_create();
+    if (hrtimer && (error_ok != knet_loop_enable_hrtimer(loop, tick))) {
+        printf("enable hrtimer failed\n");
+        knet_loop_destroy(loop);
+        return;
+    }
+    fired_n = 0;
+    ktimer_node_init(&node, knet_loop_get_timer_loop(loop));
+    cost     = time_get_milliseconds();
+    deadline = time_get_microseconds_19700101() + interval;
+    ktimer_node_start_us(&node, bench_node_cb, loop, interval);
+    knet_loop_run(loop);
+    cost = time_get_milliseconds() - cost;
+    for (i = 0; i < fired_n; i++) {
+        total += lateness[i];
+    }
+    qsort(lateness, fired_n, sizeof(uint64_t), compare_u64);
+    printf("%-7s interval: %d us, fired: %d, wall %llu ms, lateness avg %.1f us, p50 %llu us, p99 %llu us, max %llu us, "
+        "%llu wakeups\n", name, interval, fired_n, (unsigned long long)cost, (double)total / fired_n,
+        (unsigned long long)lateness[fired_n / 2], (unsigned long long)lateness[fired_n * 99 / 100],
+        (unsigned long long)lateness[fired_n - 1],
+        (unsigned long long)knet_loop_profile_get_wakeup_count(knet_loop_get_profile(loop)));
+    knet_loop_destroy(loop);
+}
+
+int main(int argc, char* argv[]) {
+    int         i    = 0;
+    const char* type = "all";
+    static const char* helper_string =
+        "-n    fire count, default 2000\n"
+        "-i    timer interval in microseconds, default 250\n"
+        "-k    hrtimer wheel tick in microseconds, default 50\n"
+        "-t    default, hrtimer or all, default all\n";
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp("-n", argv[i])) {
+            fire_n = atoi(argv[i+1]);
+        } else if (!strcmp("-i", argv[i])) {
+            interval = atoi(argv[i+1]);
+        } else if (!strcmp("-k", argv[i])) {
+            tick = atoi(argv[i+1]);
+        } else if (!strcmp("-t", argv[i])) {
+            type = argv[i+1];
+        } else {
+            printf("%s", helper_string);
+            return 0;
+        }
+    }
+    if ((fire_n <= 0) || (interval <= 0) || (tick <= 0)) {
+        printf("%s", helper_string);
+        return 0;
+    }
+    lateness = (uint64_t*)malloc(sizeof(uint64_t) * fire_n);
+
+    if (!strcmp(type, "default") || !strcmp(type, "all")) {
+        bench("default", 0);
+    }
+    if (!strcmp(type, "hrtimer") || !strcmp(type, "all")) {
+        bench("hrtimer", 1);
+    }
+
+    free(lateness);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "knet.h"
+
+#if defined(_MSC_VER )
+#pragma comment(lib,"Ws2_32.lib")
+#endif /* defined(_MSC_VER) */
+
+/*
+ * λ
+ * ÿдһٶȡ(Ƴ)һ, Ȳǲȵ, ݻԽĩβ
+ * findģⰴжȡ: ÿյһݲһн, нƳ
+ */
+
+#define RING_SIZE (1024 * 256 + 7)
+
+uint64_t total = 1024 * 1024 * 512; /* ÿԴֽ */
+
+void bench(const char* name, uint32_t size, int remove) {
+    uint64_t       i      = 0;
+    uint64_t       n      = total / size;
+    uint64_t       start  = 0;
+    uint64_t       cost   = 0;
+    char*          buffer = (char*)malloc(size);
+    kringbuffer_t* rb     = ringbuffer_create(RING_SIZE);
+    memset(buffer, 'x', size);
+    /* Ԥдһ, дλô */
+    ringbuffer_write(rb, buffer, size / 2 + 1);
+    start = time_get_milliseconds();
+    for (; i < n; i++) {
+        ringbuffer_write(rb, buffer, size);
+        if (remove) {
+            ringbuffer_remove(rb, size);
+        } else {
+            ringbuffer_read(rb, buffer, size);
+        }
+    }
+    cost = time_get_milliseconds() - start;
+    printf("%-14s size: %6u, ops: %10llu, cost: %6llu ms, %.2f GB/s\n", name, size,
+        (unsigned long long)n, (unsigned long long)cost,
+        cost ? (double)n * size / cost * 1000 / (1024 * 1024 * 1024) : 0.0);
+    ringbuffer_destroy(rb);
+    free(buffer);
+}
+
+void bench_find(uint32_t line_size, uint32_t chunk_size) {
+    uint64_t       i      = 0;
+    uint64_t       n      = total / line_size;
+    uint64_t       start  = 0;
+    uint64_t       cost   = 0;
+    uint32_t       j      = 0;
+    uint32_t       size   = 0;
+    char*          buffer = (char*)malloc(chunk_size);
+    kringbuffer_t* rb     = ringbuffer_create(RING_SIZE);
+    memset(buffer, 'x', chunk_size);
+    start = time_get_milliseconds();
+    for (; i < n; i++) {
+        /* зֶε, ÿεﶼһ */
+        for (j = 0; j + chunk_size < line_size; j += chunk_size) {
+            ringbuffer_write(rb, buffer, chunk_size);
+            if (error_ok == ringbuffer_find(rb, "\r\n", &size)) {
+                printf("unexpected line end\n");
+                return;
+            }
+        }
+        ringbuffer_write(rb, buffer, line_size - j - 2);
+        ringbuffer_write(rb, "\r\n", 2);
+        if ((error_ok != ringbuffer_find(rb, "\r\n", &size)) || (size != line_size)) {
+            printf("line end not found\n");
+            return;
+        }
+        ringbuffer_remove(rb, size);
+    }
+    cost = time_get_milliseconds() - start;
+    printf("%-14s line: %6u, chunk: %4u, lines: %8llu, cost: %6llu ms, %.2f GB/s\n", "find", line_size, chunk_size,
+        (unsigned long long)n, (unsigned long long)cost,
+        cost ? (double)n * line_size / cost * 1000 / (1024 * 1024 * 1024) : 0.0);
+    ringbuffer_destroy(rb);
+    free(buffer);
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t sizes[] = { 16, 1024, 1024 * 64 };
+    int      i       = 0;
+    if (argc > 1) {
+        total = (uint64_t)atoi(argv[1]) * 1024 * 1024;
+    }
+    if (!total) {
+        printf("usage: bench_ringbuffer [MB per test, default 512]\n");
+        return 0;
+    }
+    for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        bench("write/read", sizes[i], 0);
+        bench("write/remove", sizes[i], 1);
+    }
+    bench_find(256, 32);
+    bench_find(1024 * 16, 1024);
+    return 0;
+}
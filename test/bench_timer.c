@@ -0,0 +1,192 @@
+#include "knet.h"
+
+#if defined(_MSC_VER )
+#pragma comment(lib,"Ws2_32.lib")
+#endif /* defined(_MSC_VER) */
+
+/*
+ * ʱѭ, ȽϺͷֲʱ
+ * start: timer_nʱĶʱ
+ * stop: ֹͣδڵĶʱ(ӳʱʱĳ)
+ * expire: timer_nʱĶʱ, жʱѭֱȫ, ͳѭڵĺʱ
+ * node: ʹǶʽʱktimer_node_t, ֹͣڴ
+ * ʹ-söʱݲ, ͳжʱڵѭ
+ */
+
+int      timer_n   = 1000000;
+int      max_ms    = 1000;
+int      slack     = 0;
+int      fired_n   = 0;
+uint32_t seed      = 1;
+uint64_t malloc_n  = 0;
+
+void* counting_malloc(size_t size) {
+    malloc_n++;
+    return malloc(size);
+}
+
+void bench_timer_cb(ktimer_t* timer, void* data) {
+    (void)timer;
+    (void)data;
+    fired_n++;
+}
+
+void bench_node_cb(ktimer_node_t* node, void* data) {
+    (void)node;
+    (void)data;
+    fired_n++;
+}
+
+int random_ms() {
+    /* ƽ̨޹صͬ */
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % max_ms) + 1;
+}
+
+void bench(const char* name, ktimer_loop_type_e type) {
+    int            i      = 0;
+    uint64_t       start  = 0;
+    uint64_t       cost   = 0;
+    uint64_t       busy   = 0;
+    int            wakeup = 0;
+    ktimer_t**     timers = (ktimer_t**)malloc(sizeof(ktimer_t*) * timer_n);
+    ktimer_loop_t* loop   = ktimer_loop_create_with_type(0, type);
+
+    seed     = 1;
+    malloc_n = 0;
+    start    = time_get_microseconds();
+    for (i = 0; i < timer_n; i++) {
+        timers[i] = ktimer_create(loop);
+        ktimer_set_slack(timers[i], slack);
+        ktimer_start_once(timers[i], bench_timer_cb, 0, random_ms());
+    }
+    cost = time_get_microseconds() - start;
+    printf("%-7s start:  %d timers, %8llu us, %6.1f ns/timer, %.2f allocations/timer\n", name, timer_n,
+        (unsigned long long)cost, (double)cost * 1000 / timer_n, (double)malloc_n / timer_n);
+
+    start = time_get_microseconds();
+    for (i = 0; i < timer_n; i++) {
+        ktimer_stop(timers[i]);
+    }
+    /* ֹͣĶʱڶʱѭʱͷ, ֹͣʱ */
+    ktimer_loop_destroy(loop);
+    cost = time_get_microseconds() - start;
+    printf("%-7s stop:   %d timers, %8llu us, %6.1f ns/timer\n", name, timer_n,
+        (unsigned long long)cost, (double)cost * 1000 / timer_n);
+
+    loop    = ktimer_loop_create_with_type(0, type);
+    fired_n = 0;
+    for (i = 0; i < timer_n; i++) {
+        timers[i] = ktimer_create(loop);
+        ktimer_set_slack(timers[i], slack);
+        ktimer_start_once(timers[i], bench_timer_cb, 0, random_ms());
+    }
+    cost = time_get_milliseconds();
+    while (fired_n < timer_n) {
+        thread_sleep_ms(1);
+        start = time_get_microseconds();
+        if (ktimer_loop_run_once(loop)) {
+            wakeup++;
+        }
+        busy += time_get_microseconds() - start;
+    }
+    cost = time_get_milliseconds() - cost;
+    printf("%-7s expire: %d timers, %8llu us in loop, %6.1f ns/timer, wall %llu ms, %d timer wakeups\n", name, timer_n,
+        (unsigned long long)busy, (double)busy * 1000 / timer_n, (unsigned long long)cost, wakeup);
+    ktimer_loop_destroy(loop);
+    free(timers);
+}
+
+void bench_node() {
+    int            i      = 0;
+    uint64_t       start  = 0;
+    uint64_t       cost   = 0;
+    uint64_t       busy   = 0;
+    int            wakeup = 0;
+    ktimer_node_t* nodes  = (ktimer_node_t*)malloc(sizeof(ktimer_node_t) * timer_n);
+    ktimer_loop_t* loop   = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
+
+    for (i = 0; i < timer_n; i++) {
+        ktimer_node_init(&nodes[i], loop);
+        ktimer_node_set_slack(&nodes[i], slack);
+    }
+    seed     = 1;
+    malloc_n = 0;
+    start    = time_get_microseconds();
+    for (i = 0; i < timer_n; i++) {
+        ktimer_node_start_once(&nodes[i], bench_node_cb, 0, random_ms());
+    }
+    cost = time_get_microseconds() - start;
+    printf("%-7s start:  %d timers, %8llu us, %6.1f ns/timer, %.2f allocations/timer\n", "node", timer_n,
+        (unsigned long long)cost, (double)cost * 1000 / timer_n, (double)malloc_n / timer_n);
+
+    start = time_get_microseconds();
+    for (i = 0; i < timer_n; i++) {
+        ktimer_node_stop(&nodes[i]);
+    }
+    cost = time_get_microseconds() - start;
+    printf("%-7s stop:   %d timers, %8llu us, %6.1f ns/timer\n", "node", timer_n,
+        (unsigned long long)cost, (double)cost * 1000 / timer_n);
+
+    fired_n = 0;
+    for (i = 0; i < timer_n; i++) {
+        ktimer_node_start_once(&nodes[i], bench_node_cb, 0, random_ms());
+    }
+    cost = time_get_milliseconds();
+    while (fired_n < timer_n) {
+        thread_sleep_ms(1);
+        start = time_get_microseconds();
+        if (ktimer_loop_run_once(loop)) {
+            wakeup++;
+        }
+        busy += time_get_microseconds() - start;
+    }
+    cost = time_get_milliseconds() - cost;
+    printf("%-7s expire: %d timers, %8llu us in loop, %6.1f ns/timer, wall %llu ms, %d timer wakeups\n", "node", timer_n,
+        (unsigned long long)busy, (double)busy * 1000 / timer_n, (unsigned long long)cost, wakeup);
+    ktimer_loop_destroy(loop);
+    free(nodes);
+}
+
+int main(int argc, char* argv[]) {
+    int         i    = 0;
+    const char* type = "all";
+    static const char* helper_string =
+        "-n    timer count, default 1000000\n"
+        "-m    max timeout in milliseconds, default 1000\n"
+        "-t    rbtree, wheel, node or all, default all\n"
+        "-s    timer slack in milliseconds, default 0\n";
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp("-n", argv[i])) {
+            timer_n = atoi(argv[i+1]);
+        } else if (!strcmp("-m", argv[i])) {
+            max_ms = atoi(argv[i+1]);
+        } else if (!strcmp("-t", argv[i])) {
+            type = argv[i+1];
+        } else if (!strcmp("-s", argv[i])) {
+            slack = atoi(argv[i+1]);
+        } else {
+            printf("%s", helper_string);
+            return 0;
+        }
+    }
+    if ((timer_n <= 0) || (max_ms <= 0) || (slack < 0)) {
+        printf("%s", helper_string);
+        return 0;
+    }
+    /* ͳʱʱknet_mallocķ */
+    knet_set_malloc_func(counting_malloc);
+
+    if (!strcmp(type, "rbtree") || !strcmp(type, "all")) {
+        bench("rbtree", ktimer_loop_type_rbtree);
+    }
+    if (!strcmp(type, "wheel") || !strcmp(type, "all")) {
+        bench("wheel", ktimer_loop_type_wheel);
+    }
+    if (!strcmp(type, "node") || !strcmp(type, "all")) {
+        bench_node();
+    }
+
+    return 0;
+}
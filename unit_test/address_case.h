@@ -52,3 +52,51 @@ CASE(Test_Address) {
 
     knet_loop_destroy(loop);
 }
+
+int Test_Address_Binary_Accept = 0;
+
+CASE(Test_Address_Binary) {
+    // ܵĹܵԶ˵ַڽʱԶƱ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                kaddress_t* peer = knet_channel_ref_get_peer_address(channel);
+                int length = 0;
+                const unsigned char* ip = (const unsigned char*)address_get_ip_bytes(peer, &length);
+                const struct sockaddr* sa = address_get_sockaddr(peer, &length);
+                if ((AF_INET == address_get_family(peer)) && ip && (127 == ip[0]) && (1 == ip[3]) &&
+                    sa && (sizeof(struct sockaddr_in) == length) &&
+                    (ntohs(((const struct sockaddr_in*)sa)->sin_port) == address_get_port(peer)) &&
+                    (std::string(LOOP_ADDR) == address_get_ip(peer))) {
+                    Test_Address_Binary_Accept++;
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* channel = knet_loop_create_channel(loop, 0, 1024);
+    // δ, ƵַЧ
+    kaddress_t* peer = knet_channel_ref_get_peer_address(channel);
+    EXPECT_FALSE(address_get_family(peer));
+    EXPECT_FALSE(address_get_ip_bytes(peer, 0));
+    EXPECT_FALSE(address_get_sockaddr(peer, 0));
+    knet_channel_ref_close(channel);
+
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_accept(acceptor, 0, 8000, 1);
+    knet_channel_ref_connect(connector, LOOP_ADDR, 8000, 1);
+    for (int i = 0; (i < 100) && !Test_Address_Binary_Accept; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Address_Binary_Accept);
+    // Զ˵ַͨgetpeernameȡ
+    peer = knet_channel_ref_get_peer_address(connector);
+    EXPECT_TRUE(AF_INET == address_get_family(peer));
+    EXPECT_TRUE(8000 == address_get_port(peer));
+    EXPECT_TRUE(std::string(LOOP_ADDR) == address_get_ip(peer));
+
+    knet_loop_destroy(loop);
+}
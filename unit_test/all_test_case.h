@@ -32,6 +32,7 @@
 #include "timer_case.h"
 //#include "loop_profile_case.h"
 #include "trie_case.h"
+#include "ringbuffer_case.h"
 #include "ip_filter_case.h"
 #include "misc_case.h"
 
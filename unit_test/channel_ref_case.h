@@ -260,6 +260,56 @@ CASE(Test_Channel_Recv_Timeout) {
     knet_loop_destroy(loop);
 }
 
+uint64_t case_Test_Channel_Recv_Timeout_Touch_ms = 0;
+int case_Test_Channel_Recv_Timeout_Touch_accept = 0;
+
+CASE(Test_Channel_Recv_Timeout_Touch) {
+    // յʱгʱ, ֹͣͺŴ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+                knet_channel_ref_set_timeout(channel, 1);
+                case_Test_Channel_Recv_Timeout_Touch_accept = 1;
+            } else if (e & channel_cb_event_recv) {
+                knet_stream_eat_all(knet_channel_ref_get_stream(channel));
+            } else if (e & channel_cb_event_timeout) {
+                if (!case_Test_Channel_Recv_Timeout_Touch_ms) {
+                    case_Test_Channel_Recv_Timeout_Touch_ms = time_get_milliseconds();
+                }
+            }
+        }
+    };
+    kloop_t* loop = knet_loop_create();
+    knet_loop_set_max_wait(loop, 10);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 8, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_accept(acceptor, LOOP_ADDR, 8000, 1);
+    knet_channel_ref_connect(connector, LOOP_ADDR, 8000, 1);
+    for (int i = 0; (i < 100) && !case_Test_Channel_Recv_Timeout_Touch_accept; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == case_Test_Channel_Recv_Timeout_Touch_accept);
+    // 2.5ÿ300뷢һ, 1Ķгʱ
+    uint64_t start = time_get_milliseconds();
+    uint64_t last  = 0;
+    while (time_get_milliseconds() - start < 2500) {
+        if (time_get_milliseconds() - last >= 300) {
+            last = time_get_milliseconds();
+            knet_stream_push(knet_channel_ref_get_stream(connector), "x", 1);
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(0 == case_Test_Channel_Recv_Timeout_Touch_ms);
+    uint64_t stop = time_get_milliseconds();
+    while (!case_Test_Channel_Recv_Timeout_Touch_ms && (time_get_milliseconds() - stop < 3000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(case_Test_Channel_Recv_Timeout_Touch_ms >= stop);
+    knet_loop_destroy(loop);
+}
+
 kchannel_ref_t* case_Test_Channel_Share_Leave_channel = 0;
 
 CASE(Test_Channel_Share_Leave) {
@@ -293,6 +343,8 @@ CASE(Test_Channel_Share_Leave) {
     EXPECT_TRUE(knet_channel_ref_check_state(acceptor, channel_state_accept));
 
     knet_loop_run(loop);
+    // ûжʱʱѡȡһֱȴ, Ƶȴʱ
+    knet_loop_set_max_wait(loop, 10);
     // 
     knet_channel_ref_leave(case_Test_Channel_Share_Leave_channel);
     // ٹܵ
@@ -303,3 +355,519 @@ CASE(Test_Channel_Share_Leave) {
     // ʣ3ܵﱻ
     knet_loop_destroy(loop);
 }
+
+CASE(Test_Loop_Max_Wait) {
+    // û¼Ͷʱʱѡȡȴȴʱ
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    knet_loop_set_max_wait(loop, 100);
+    EXPECT_TRUE(100 == knet_loop_get_max_wait(loop));
+    uint64_t start = time_get_milliseconds();
+    for (int i = 0; i < 3; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(time_get_milliseconds() - start >= 250);
+    EXPECT_TRUE(3 == knet_loop_profile_get_wakeup_count(profile));
+    EXPECT_TRUE(3 == knet_loop_profile_get_empty_wakeup_count(profile));
+    knet_loop_destroy(loop);
+}
+
+int Test_Loop_Timer_Wakeup_Fired = 0;
+
+CASE(Test_Loop_Timer_Wakeup) {
+    // kloop_tڵĶʱڼ붨ʱѴ
+    struct holder {
+        static void timer_cb(ktimer_node_t*, void*) {
+            Test_Loop_Timer_Wakeup_Fired++;
+        }
+    };
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    ktimer_node_t nodes[3];
+    // 50봰ǰ, 13뵽ڵĶʱ뵽ͬһʱ
+    while (time_get_milliseconds_19700101() % 50 >= 25) {
+        thread_sleep_ms(1);
+    }
+    for (int i = 0; i < 3; i++) {
+        ktimer_node_init(&nodes[i], knet_loop_get_timer_loop(loop));
+        ktimer_node_set_slack(&nodes[i], 50);
+        ktimer_node_start_once(&nodes[i], &holder::timer_cb, 0, i + 1);
+    }
+    // ûȴʱ, ѡȡĶʱ
+    for (int i = 0; (i < 100) && (Test_Loop_Timer_Wakeup_Fired < 3); i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(3 == Test_Loop_Timer_Wakeup_Fired);
+    EXPECT_TRUE(1 == knet_loop_profile_get_timer_wakeup_count(profile));
+    knet_loop_destroy(loop);
+}
+
+uint64_t Test_Loop_Hrtimer_Fired = 0;
+
+CASE(Test_Loop_Hrtimer) {
+    // ߾ȶʱѡȡǺ붨ʱʱ
+    struct holder {
+        static void timer_cb(ktimer_node_t*, void*) {
+            Test_Loop_Hrtimer_Fired = time_get_microseconds_19700101();
+        }
+    };
+    kloop_t* loop = knet_loop_create();
+    EXPECT_FALSE(knet_loop_check_hrtimer(loop));
+    EXPECT_TRUE(error_ok == knet_loop_enable_hrtimer(loop, 50));
+    EXPECT_TRUE(knet_loop_check_hrtimer(loop));
+    ktimer_node_t node;
+    ktimer_node_init(&node, knet_loop_get_timer_loop(loop));
+    for (int k = 0; k < 3; k++) {
+        Test_Loop_Hrtimer_Fired = 0;
+        uint64_t deadline = time_get_microseconds_19700101() + 500;
+        EXPECT_TRUE(error_ok == ktimer_node_start_once_us(&node, &holder::timer_cb, 0, 500));
+        for (int i = 0; (i < 100) && !Test_Loop_Hrtimer_Fired; i++) {
+            knet_loop_run_once(loop);
+        }
+        EXPECT_TRUE(Test_Loop_Hrtimer_Fired >= deadline);
+    }
+    EXPECT_TRUE(3 == knet_loop_profile_get_timer_wakeup_count(knet_loop_get_profile(loop)));
+    knet_loop_destroy(loop);
+}
+
+int Test_Loop_Notify_Coalesce_Recv_Bytes = 0;
+
+CASE(Test_Loop_Notify_Coalesce) {
+    // ѡȡ֮ǰ, ߳Ŀ߳¼ֻѡȡһ
+    struct holder {
+        static void producer(kthread_runner_t* runner) {
+            kchannel_ref_t* channel = (kchannel_ref_t*)thread_runner_get_params(runner);
+            for (int i = 0; i < 10000; i++) {
+                knet_stream_push(knet_channel_ref_get_stream(channel), "0123456789", 10);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Loop_Notify_Coalesce_Recv_Bytes += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+                if (Test_Loop_Notify_Coalesce_Recv_Bytes == 100000) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+
+    uint64_t notify = knet_loop_profile_get_notify_count(profile);
+    kthread_runner_t* runner = thread_runner_create(&holder::producer, connector);
+    thread_runner_start(runner, 0);
+    thread_runner_join(runner);
+    thread_runner_destroy(runner);
+    EXPECT_TRUE(notify + 1 == knet_loop_profile_get_notify_count(profile));
+
+    knet_loop_run(loop);
+    EXPECT_TRUE(100000 == Test_Loop_Notify_Coalesce_Recv_Bytes);
+    knet_loop_destroy(loop);
+}
+
+int Test_Write_Batch_Next = 0;
+
+CASE(Test_Write_Batch) {
+    // ߳д, ݰд˳򵽴
+    struct holder {
+        static void producer(kthread_runner_t* runner) {
+            kchannel_ref_t* channel = (kchannel_ref_t*)thread_runner_get_params(runner);
+            kwrite_batch_t* batch = knet_write_batch_create(1024, 1000);
+            for (int i = 0; i < 10000; i++) {
+                EXPECT_TRUE(error_ok == knet_write_batch_push(batch, channel, &i, sizeof(i)));
+            }
+            knet_write_batch_destroy(batch);
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int i = 0;
+                while (error_ok == knet_stream_pop(stream, &i, sizeof(i))) {
+                    EXPECT_TRUE(i == Test_Write_Batch_Next);
+                    Test_Write_Batch_Next++;
+                }
+                if (Test_Write_Batch_Next == 10000) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+
+    uint64_t notify = knet_loop_profile_get_notify_count(profile);
+    kthread_runner_t* runner = thread_runner_create(&holder::producer, connector);
+    thread_runner_start(runner, 0);
+    thread_runner_join(runner);
+    thread_runner_destroy(runner);
+    EXPECT_TRUE(notify + 1 == knet_loop_profile_get_notify_count(profile));
+
+    knet_loop_run(loop);
+    EXPECT_TRUE(10000 == Test_Write_Batch_Next);
+    knet_loop_destroy(loop);
+}
+
+kchannel_ref_t* Test_Recv_Watermark_Client = 0;
+int Test_Recv_Watermark_Throttle = 0;
+int Test_Recv_Watermark_Resume = 0;
+int Test_Recv_Watermark_Close = 0;
+
+CASE(Test_Recv_Watermark) {
+    // շȡʱͣȡǹر, ȡݺָȡ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Recv_Watermark_Client = channel;
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv_throttle) {
+                Test_Recv_Watermark_Throttle++;
+            } else if (e & channel_cb_event_recv_resume) {
+                Test_Recv_Watermark_Resume++;
+            } else if (e & channel_cb_event_close) {
+                Test_Recv_Watermark_Close++;
+            }
+        }
+    };
+
+    const int total = 1024 * 1024;
+    int received = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 4);
+    EXPECT_TRUE(error_invalid_parameters == knet_channel_ref_set_recv_watermark(acceptor, 1024, 1024));
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_recv_watermark(acceptor, 1024 * 16, 1024 * 4));
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+    EXPECT_TRUE(error_ok == push_fill(knet_channel_ref_get_stream(connector), 'x', total));
+
+    for (int i = 0; (i < 10000) && (received < total) && !Test_Recv_Watermark_Close; i++) {
+        knet_loop_run_once(loop);
+        if (!Test_Recv_Watermark_Client) {
+            continue;
+        }
+        kstream_t* stream = knet_channel_ref_get_stream(Test_Recv_Watermark_Client);
+        int available = knet_stream_available(stream);
+        if (received + available == total) {
+            // ȫѾ
+            received = total;
+            EXPECT_TRUE(error_ok == knet_stream_eat(stream, available));
+            break;
+        }
+        if (!knet_channel_ref_check_recv_throttle(Test_Recv_Watermark_Client)) {
+            continue;
+        }
+        EXPECT_TRUE(available >= 1024 * 16);
+#if !LOOP_URING
+        // ͣȡ, io_uringѾύĽԻд
+        knet_loop_run_once(loop);
+        EXPECT_TRUE(available == knet_stream_available(stream));
+#endif // !LOOP_URING
+        available = knet_stream_available(stream);
+        // ȡݺָȡ
+        received += available;
+        EXPECT_TRUE(error_ok == knet_stream_eat(stream, available));
+        EXPECT_TRUE(!knet_channel_ref_check_recv_throttle(Test_Recv_Watermark_Client));
+    }
+    EXPECT_TRUE(total == received);
+    EXPECT_TRUE(!Test_Recv_Watermark_Close);
+    EXPECT_TRUE(Test_Recv_Watermark_Throttle > 0);
+    EXPECT_TRUE(Test_Recv_Watermark_Throttle == Test_Recv_Watermark_Resume);
+    knet_loop_destroy(loop);
+}
+
+int Test_Send_Watermark_High = 0;
+int Test_Send_Watermark_Drained = 0;
+int Test_Send_Watermark_Close = 0;
+uint64_t Test_Send_Watermark_Received = 0;
+
+CASE(Test_Send_Watermark) {
+    // Ͷгˮλʱ֪ͨһ, ˮλʱ֪ͨһ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Send_Watermark_Received += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            (void)channel;
+            if (e & channel_cb_event_send_high) {
+                Test_Send_Watermark_High++;
+            } else if (e & channel_cb_event_send_drained) {
+                Test_Send_Watermark_Drained++;
+            } else if (e & channel_cb_event_close) {
+                Test_Send_Watermark_Close++;
+            }
+        }
+    };
+
+    const int total = 1024 * 1024 * 16;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    EXPECT_TRUE(error_invalid_parameters == knet_channel_ref_set_send_watermark(connector, 1024, 1024));
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_send_watermark(connector, 1024 * 64, 1024 * 16));
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+    EXPECT_TRUE(error_ok == push_fill(knet_channel_ref_get_stream(connector), 'x', total));
+    // дloop߳, ˮλ֪ͨ
+    EXPECT_TRUE(knet_channel_ref_get_send_pending_bytes(connector) >= 1024 * 64);
+    EXPECT_TRUE(1 == Test_Send_Watermark_High);
+    EXPECT_TRUE(0 == Test_Send_Watermark_Drained);
+
+    for (int i = 0; (i < 100000) && (Test_Send_Watermark_Received < (uint64_t)total) &&
+        !Test_Send_Watermark_Close; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE((uint64_t)total == Test_Send_Watermark_Received);
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_pending_bytes(connector));
+    EXPECT_TRUE(!Test_Send_Watermark_Close);
+    EXPECT_TRUE(1 == Test_Send_Watermark_High);
+    EXPECT_TRUE(1 == Test_Send_Watermark_Drained);
+    knet_loop_destroy(loop);
+}
+
+kchannel_ref_t* Test_Recv_Buffer_Adaptive_Client = 0;
+
+CASE(Test_Recv_Buffer_Adaptive) {
+    // ջӳʼȰ, ȡݲкسʼ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Recv_Buffer_Adaptive_Client = channel;
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            }
+        }
+    };
+
+    const int total = 1024 * 32;
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 16);
+    EXPECT_TRUE(error_invalid_parameters == knet_channel_ref_set_recv_buffer_adaptive(acceptor, 0, 0, 1));
+    EXPECT_TRUE(error_invalid_parameters == knet_channel_ref_set_recv_buffer_adaptive(acceptor, 2048, 1024, 1));
+    uint64_t base = knet_loop_profile_get_recv_buffer_bytes(profile);
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_recv_buffer_adaptive(acceptor, 1024, 1024 * 64, 1));
+    // Ľջ
+    base -= 1024 * 15;
+    EXPECT_TRUE(base == knet_loop_profile_get_recv_buffer_bytes(profile));
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+    EXPECT_TRUE(error_ok == push_fill(knet_channel_ref_get_stream(connector), 'x', total));
+
+    for (int i = 0; (i < 1000) && (!Test_Recv_Buffer_Adaptive_Client ||
+        (knet_stream_available(knet_channel_ref_get_stream(Test_Recv_Buffer_Adaptive_Client)) < total)); i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Recv_Buffer_Adaptive_Client != 0);
+    kstream_t* stream = knet_channel_ref_get_stream(Test_Recv_Buffer_Adaptive_Client);
+    EXPECT_TRUE(total == knet_stream_available(stream));
+    // 
+    EXPECT_TRUE(knet_loop_profile_get_recv_buffer_bytes(profile) >= base + total);
+    EXPECT_TRUE(error_ok == knet_stream_eat_all(stream));
+
+    // кسʼ
+    uint64_t start = time_get_milliseconds();
+    while (!knet_loop_profile_get_recv_buffer_shrink_count(profile) && (time_get_milliseconds() - start < 5000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == knet_loop_profile_get_recv_buffer_shrink_count(profile));
+    EXPECT_TRUE(base + 1024 == knet_loop_profile_get_recv_buffer_bytes(profile));
+    knet_loop_destroy(loop);
+}
+
+int Test_Recv_Shared_Lines = 0;
+int Test_Recv_Shared_Available = 0;
+
+CASE(Test_Recv_Shared) {
+    // ģʽ»صݲռùܵĽջ, ûдݱ´λص
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char line[32] = {0};
+            int  size     = sizeof(line);
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Recv_Shared_Available = knet_stream_available(stream);
+                while (error_ok == knet_stream_pop_until(stream, "\n", line, &size)) {
+                    if ((size == 7) && !memcmp(line, "abcdef\n", 7)) {
+                        Test_Recv_Shared_Lines++;
+                    } else if ((size == 4) && !memcmp(line, "ghi\n", 4)) {
+                        Test_Recv_Shared_Lines++;
+                    }
+                    size = sizeof(line);
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 16);
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_recv_shared(acceptor, 1));
+    // Ľջͷ
+    uint64_t base = knet_loop_profile_get_recv_buffer_bytes(profile);
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+    kstream_t* stream = knet_channel_ref_get_stream(connector);
+
+    // ϢڹܵԼĽջ
+    EXPECT_TRUE(error_ok == knet_stream_push(stream, "abc", 3));
+    for (int i = 0; (i < 100) && (Test_Recv_Shared_Available < 3); i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(3 == Test_Recv_Shared_Available);
+    EXPECT_TRUE(knet_loop_profile_get_recv_buffer_bytes(profile) > base);
+
+    // ȡȫݺͷ
+    EXPECT_TRUE(error_ok == knet_stream_push(stream, "def\n", 4));
+    for (int i = 0; (i < 100) && !Test_Recv_Shared_Lines; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Recv_Shared_Lines);
+    EXPECT_TRUE(7 == Test_Recv_Shared_Available);
+    EXPECT_TRUE(base == knet_loop_profile_get_recv_buffer_bytes(profile));
+
+    // صڴݲ
+    char data[400] = {0};
+    for (int i = 0; i < 100; i++) {
+        memcpy(data + i * 4, "ghi\n", 4);
+    }
+    EXPECT_TRUE(error_ok == knet_stream_push(stream, data, sizeof(data)));
+    for (int i = 0; (i < 100) && (Test_Recv_Shared_Lines < 101); i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(101 == Test_Recv_Shared_Lines);
+    EXPECT_TRUE(base == knet_loop_profile_get_recv_buffer_bytes(profile));
+    knet_loop_destroy(loop);
+}
+
+CASE(Test_Channel_Block_Reuse) {
+    kloop_t*        loop    = knet_loop_create();
+    kchannel_ref_t* channel = knet_loop_create_channel(loop, 0, 1024);
+    kchannel_ref_t* reused  = 0;
+    uint64_t        uuid    = knet_channel_ref_get_uuid(channel);
+
+    // δloopĹܵرʱ, ڴյloopڴ
+    knet_channel_ref_close(channel);
+    reused = knet_loop_create_channel(loop, 0, 1024);
+    EXPECT_TRUE(reused == channel);
+    // õڴ³ʼ
+    EXPECT_TRUE(uuid != knet_channel_ref_get_uuid(reused));
+    EXPECT_TRUE(knet_channel_ref_get_stream(reused));
+    EXPECT_TRUE(0 == knet_stream_available(knet_channel_ref_get_stream(reused)));
+    knet_channel_ref_close(reused);
+
+    knet_loop_destroy(loop);
+}
+
+int Test_Accept_Budget_Count = 0;
+int Test_Accept_Budget_Peer = 0;
+
+CASE(Test_Accept_Budget) {
+    // ÿζ¼2, ʣ֮ѭڽ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Accept_Budget_Count++;
+                // Զ˵ַڽʱȡ
+                kaddress_t* peer = knet_channel_ref_get_peer_address(channel);
+                if ((std::string(LOOP_ADDR) == address_get_ip(peer)) && address_get_port(peer)) {
+                    Test_Accept_Budget_Peer++;
+                }
+            }
+        }
+    };
+
+    const int count = 16;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    EXPECT_TRUE(error_invalid_parameters == knet_channel_ref_set_accept_budget(acceptor, -1));
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_accept_budget(acceptor, 2));
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8000, count));
+    for (int i = 0; i < count; i++) {
+        kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+        knet_channel_ref_connect(connector, LOOP_ADDR, 8000, 1);
+    }
+    for (int i = 0; (i < 100) && (Test_Accept_Budget_Count < count); i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(count == Test_Accept_Budget_Count);
+    EXPECT_TRUE(count == Test_Accept_Budget_Peer);
+    knet_loop_destroy(loop);
+}
+
+int Test_Socket_Options_Accept = 0;
+int Test_Socket_Options_Keepalive = 0;
+
+CASE(Test_Socket_Options) {
+    // ñܵĹ̳ܵ, ǰӦ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Socket_Options_Accept++;
+                int keepalive = 0;
+                socket_len_t len = sizeof(keepalive);
+                getsockopt(knet_channel_ref_get_socket_fd(channel), SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, &len);
+                if (keepalive) {
+                    Test_Socket_Options_Keepalive++;
+                }
+            }
+        }
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                // TCP_DEFER_ACCEPTʱյݺܽ
+                knet_stream_push(knet_channel_ref_get_stream(channel), "hello", 5);
+            }
+        }
+    };
+
+    ksocket_options_t* options = knet_socket_options_create();
+    EXPECT_TRUE(error_invalid_parameters == knet_socket_options_set_buffer_size(options, -2, 0));
+    EXPECT_TRUE(error_invalid_parameters == knet_socket_options_set_keepalive(options, 1, -1));
+    EXPECT_TRUE(error_invalid_parameters == knet_socket_options_set_defer_accept(options, -1));
+    EXPECT_TRUE(error_ok == knet_socket_options_set_keepalive(options, 1, 60));
+    EXPECT_TRUE(error_ok == knet_socket_options_set_buffer_size(options, 0, 0));
+    EXPECT_TRUE(error_ok == knet_socket_options_set_defer_accept(options, 1));
+    EXPECT_TRUE(error_ok == knet_socket_options_set_quickack(options, 1));
+    EXPECT_TRUE(error_ok == knet_socket_options_set_user_timeout(options, 5000));
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel_with_options(loop, 1, 1024, options);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8000, 10));
+    kchannel_ref_t* connector = knet_loop_create_channel_with_options(loop, 1, 1024, options);
+    int keepalive = 0;
+    socket_len_t len = sizeof(keepalive);
+    getsockopt(knet_channel_ref_get_socket_fd(connector), SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, &len);
+    EXPECT_TRUE(keepalive);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, LOOP_ADDR, 8000, 1);
+    for (int i = 0; (i < 100) && !Test_Socket_Options_Accept; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Socket_Options_Accept);
+    EXPECT_TRUE(1 == Test_Socket_Options_Keepalive);
+    knet_loop_destroy(loop);
+    knet_socket_options_destroy(options);
+}
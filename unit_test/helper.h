@@ -168,4 +168,28 @@ inline std::string getBinaryPath() {
 #define LOCAL_ADDR "0.0.0.0"
 #endif
 
+#include <cstdlib>
+#include <cstring>
+#include "knet.h"
+
+// 8000˿ڽһ, ɵߴ, ǷѾ
+inline bool connect_pair(kloop_t* loop, kchannel_ref_t* connector, kchannel_ref_t* acceptor, knet_channel_ref_cb_t acceptor_cb) {
+    knet_channel_ref_accept(acceptor, 0, 8000, 1);
+    knet_channel_ref_connect(connector, LOOP_ADDR, 8000, 1);
+    knet_channel_ref_set_cb(acceptor, acceptor_cb);
+    for (int i = 0; (i < 100) && !knet_channel_ref_check_state(connector, channel_state_active); i++) {
+        knet_loop_run_once(loop);
+    }
+    return (knet_channel_ref_check_state(connector, channel_state_active) != 0);
+}
+
+// дsizeֽڵbyte
+inline int push_fill(kstream_t* stream, char byte, int size) {
+    char* data = (char*)malloc(size);
+    memset(data, byte, size);
+    int error = knet_stream_push(stream, data, size);
+    free(data);
+    return error;
+}
+
 #endif // HEPLER_H
@@ -51,3 +51,39 @@ CASE(Test_Ip_Filter_Load) {
     EXPECT_TRUE(knet_ip_filter_check(f, "1.2.3.4"));
     knet_ip_filter_destroy(f);
 }
+
+kip_filter_t* Test_Ip_Filter_Channel_Filter = 0;
+int Test_Ip_Filter_Channel_Count = 0;
+
+CASE(Test_Ip_Filter_Check_Channel) {
+    // 鱻ܹܵĶԶ˵ַ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                if (knet_ip_filter_check_channel(Test_Ip_Filter_Channel_Filter, channel)) {
+                    Test_Ip_Filter_Channel_Count++;
+                }
+                knet_channel_ref_close(channel);
+            }
+        }
+    };
+
+    Test_Ip_Filter_Channel_Filter = knet_ip_filter_create();
+    EXPECT_TRUE(error_ok == knet_ip_filter_add(Test_Ip_Filter_Channel_Filter, LOOP_ADDR));
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_accept(acceptor, 0, 8000, 1);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_connect(connector, LOOP_ADDR, 8000, 1);
+    for (int i = 0; (i < 100) && !Test_Ip_Filter_Channel_Count; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Ip_Filter_Channel_Count);
+    // ɾٱ
+    EXPECT_TRUE(error_ok == knet_ip_filter_remove(Test_Ip_Filter_Channel_Filter, LOOP_ADDR));
+    EXPECT_FALSE(knet_ip_filter_check_address(Test_Ip_Filter_Channel_Filter,
+        knet_channel_ref_get_peer_address(connector)));
+    knet_loop_destroy(loop);
+    knet_ip_filter_destroy(Test_Ip_Filter_Channel_Filter);
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2014-2015, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "helper.h"
+#include "knet.h"
+
+CASE(Test_Ringbuffer_Wrap) {
+    // дԽĩβ
+    kringbuffer_t* rb = ringbuffer_create(10);
+    char buffer[16] = {0};
+    EXPECT_TRUE(7 == ringbuffer_write(rb, "0123456", 7));
+    EXPECT_TRUE(5 == ringbuffer_remove(rb, 5));
+    EXPECT_TRUE(6 == ringbuffer_write(rb, "abcdef", 6));
+    EXPECT_TRUE(8 == ringbuffer_available(rb));
+    EXPECT_TRUE(8 == ringbuffer_copy(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, "56abcdef", 8));
+    EXPECT_TRUE(3 == ringbuffer_copy_random(rb, 4, buffer, 3));
+    EXPECT_TRUE(!memcmp(buffer, "cde", 3));
+    EXPECT_TRUE(2 == ringbuffer_replace(rb, 3, "XY", 2));
+    EXPECT_TRUE(8 == ringbuffer_read(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, "56aXYdef", 8));
+    EXPECT_TRUE(ringbuffer_empty(rb));
+    ringbuffer_destroy(rb);
+}
+
+CASE(Test_Ringbuffer_Enlarge) {
+    // ݺݱ˳
+    kringbuffer_t* rb = ringbuffer_create(8);
+    char buffer[32] = {0};
+    EXPECT_TRUE(6 == ringbuffer_write(rb, "012345", 6));
+    EXPECT_TRUE(4 == ringbuffer_remove(rb, 4));
+    EXPECT_TRUE(20 == ringbuffer_write(rb, "abcdefghijklmnopqrst", 20));
+    EXPECT_TRUE(ringbuffer_get_max_size(rb) >= 22);
+    EXPECT_TRUE(22 == ringbuffer_read(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, "45abcdefghijklmnopqrst", 22));
+    ringbuffer_destroy(rb);
+}
+
+CASE(Test_Ringbuffer_Mirror) {
+    // ģʽ¿Խĩβݿ
+    kringbuffer_t* rb = ringbuffer_create(10);
+    char*    data     = 0;
+    char*    ptr      = 0;
+    uint32_t max_size = 0;
+    uint32_t size     = 0;
+    EXPECT_TRUE(3 == ringbuffer_write(rb, "012", 3));
+    if (error_ok != ringbuffer_set_mirror(rb)) {
+        // ǰƽ̨֧
+        EXPECT_TRUE(!ringbuffer_is_mirror(rb));
+        ringbuffer_destroy(rb);
+        return;
+    }
+    EXPECT_TRUE(ringbuffer_is_mirror(rb));
+    EXPECT_TRUE(3 == ringbuffer_available(rb));
+    max_size = ringbuffer_get_max_size(rb);
+    EXPECT_TRUE(max_size >= 10);
+    data = (char*)malloc(max_size * 2);
+    memset(data, 'x', max_size * 2);
+    // дλƶĩβǰ3ֽ
+    EXPECT_TRUE(max_size - 6 == ringbuffer_write(rb, data, max_size - 6));
+    EXPECT_TRUE(max_size - 3 == ringbuffer_remove(rb, max_size - 3));
+    EXPECT_TRUE(8 == ringbuffer_write(rb, "abcdefgh", 8));
+    ptr = ringbuffer_peek(rb, &size);
+    EXPECT_TRUE((8 == size) && !memcmp(ptr, "abcdefgh", 8));
+    EXPECT_TRUE(8 == ringbuffer_read_lock_size(rb));
+    EXPECT_TRUE(!memcmp(ringbuffer_read_lock_ptr(rb), "abcdefgh", 8));
+    ringbuffer_read_unlock(rb);
+    EXPECT_TRUE(max_size - 8 == ringbuffer_write_lock_size(rb));
+    ringbuffer_write_unlock(rb);
+    // ݺ󱣳־ģʽ˳
+    EXPECT_TRUE(max_size == ringbuffer_write(rb, data, max_size));
+    EXPECT_TRUE(ringbuffer_is_mirror(rb));
+    EXPECT_TRUE(max_size + 8 == ringbuffer_available(rb));
+    ptr = ringbuffer_peek(rb, &size);
+    EXPECT_TRUE((max_size + 8 == size) && !memcmp(ptr, "abcdefgh", 8));
+    EXPECT_TRUE(!memcmp(ptr + 8, data, max_size));
+    free(data);
+    ringbuffer_destroy(rb);
+}
+
+CASE(Test_Ringbuffer_Find) {
+    // ҽֽڱȽһ, ԽĩβĿ
+    char data[300];
+    uint32_t size = 0;
+    for (int i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (char)('a' + i % 7);
+    }
+    for (int offset = 0; offset < 200; offset += 13) {
+        for (int pos = 0; pos < 280; pos += 17) {
+            kringbuffer_t* rb = ringbuffer_create(256);
+            ringbuffer_write(rb, data, offset + 1);
+            ringbuffer_remove(rb, offset + 1);
+            memcpy(data + pos, "\r\n", 2);
+            if (pos + 2 <= 256) {
+                ringbuffer_write(rb, data, 256);
+                EXPECT_TRUE(error_ok == ringbuffer_find(rb, "\r\n", &size));
+                EXPECT_TRUE((uint32_t)pos + 2 == size);
+                EXPECT_TRUE(error_ok == ringbuffer_find(rb, "\r\n", &size));
+                EXPECT_TRUE((uint32_t)pos + 2 == size);
+            } else {
+                ringbuffer_write(rb, data, 256);
+                EXPECT_TRUE(error_ringbuffer_not_found == ringbuffer_find(rb, "\r\n", &size));
+            }
+            data[pos] = (char)('a' + pos % 7);
+            data[pos + 1] = (char)('a' + (pos + 1) % 7);
+            ringbuffer_destroy(rb);
+        }
+    }
+}
+
+CASE(Test_Ringbuffer_Find_Partial) {
+    // ݷֶε, ֻµĲ, Ŀ걻ε
+    kringbuffer_t* rb = ringbuffer_create(64);
+    uint32_t size = 0;
+    char buffer[64] = {0};
+    EXPECT_TRUE(40 == ringbuffer_write(rb, "0123456789012345678901234567890123456789", 40));
+    EXPECT_TRUE(36 == ringbuffer_remove(rb, 36));
+    EXPECT_TRUE(20 == ringbuffer_write(rb, "abcdefghijklmnopqrs\r", 20));
+    EXPECT_TRUE(error_ringbuffer_not_found == ringbuffer_find(rb, "\r\n", &size));
+    EXPECT_TRUE(error_ringbuffer_not_found == ringbuffer_find(rb, "\r\n", &size));
+    EXPECT_TRUE(error_ringbuffer_not_found == ringbuffer_find(rb, "end", &size));
+    EXPECT_TRUE(20 == ringbuffer_write(rb, "\nline2 end\r\nxxxxxxxx", 20));
+    EXPECT_TRUE(error_ok == ringbuffer_find(rb, "\r\n", &size));
+    EXPECT_TRUE(25 == size);
+    EXPECT_TRUE(25 == ringbuffer_read(rb, buffer, size));
+    EXPECT_TRUE(!memcmp(buffer, "6789abcdefghijklmnopqrs\r\n", 25));
+    EXPECT_TRUE(error_ok == ringbuffer_find(rb, "\r\n", &size));
+    EXPECT_TRUE(11 == size);
+    // ޸ݺ²
+    EXPECT_TRUE(error_ok == ringbuffer_find(rb, "xxx", &size));
+    EXPECT_TRUE(14 == size);
+    EXPECT_TRUE(1 == ringbuffer_replace(rb, 0, "x", 1));
+    EXPECT_TRUE(error_ok == ringbuffer_find(rb, "xine", &size));
+    EXPECT_TRUE(4 == size);
+    ringbuffer_destroy(rb);
+}
+
+CASE(Test_Ringbuffer_Write_Lock_Iov) {
+    // дռԽĩβʱΪ
+    kringbuffer_t* rb = ringbuffer_create(10);
+    kiovec_t iov[2];
+    char buffer[16] = {0};
+    EXPECT_TRUE(7 == ringbuffer_write(rb, "0123456", 7));
+    EXPECT_TRUE(5 == ringbuffer_remove(rb, 5));
+    EXPECT_TRUE(2 == ringbuffer_write_lock_iov(rb, iov));
+    EXPECT_TRUE((3 == iov[0].size) && (5 == iov[1].size));
+    memcpy((char*)iov[0].data, "abc", 3);
+    memcpy((char*)iov[1].data, "de", 2);
+    ringbuffer_write_commit(rb, 5);
+    EXPECT_TRUE(7 == ringbuffer_read(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, "56abcde", 7));
+    ringbuffer_destroy(rb);
+    // дռʱֻһ
+    rb = ringbuffer_create(10);
+    EXPECT_TRUE(3 == ringbuffer_write(rb, "012", 3));
+    EXPECT_TRUE(1 == ringbuffer_write_lock_iov(rb, iov));
+    EXPECT_TRUE(7 == iov[0].size);
+    ringbuffer_write_unlock(rb);
+    ringbuffer_destroy(rb);
+}
+
+CASE(Test_Ringbuffer_Shrink) {
+    // , ȲСڿɶݳ
+    kringbuffer_t* rb = ringbuffer_create(16);
+    char data[100] = {0};
+    char out[100]  = {0};
+    for (int i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (char)i;
+    }
+    EXPECT_TRUE(10 == ringbuffer_write(rb, data, 10));
+    EXPECT_TRUE(5 == ringbuffer_remove(rb, 5));
+    EXPECT_TRUE(100 == ringbuffer_write(rb, data + 10, 90) + ringbuffer_write(rb, data, 10));
+    EXPECT_TRUE(ringbuffer_get_max_size(rb) > 105);
+    EXPECT_TRUE(error_ok == ringbuffer_shrink(rb, 8));
+    EXPECT_TRUE(105 == ringbuffer_get_max_size(rb));
+    EXPECT_TRUE(105 == ringbuffer_read(rb, out, 95) + ringbuffer_read(rb, out, 10));
+    EXPECT_TRUE(!memcmp(out, data, 10));
+    // Ϊʱָ, ڵǰʱ
+    EXPECT_TRUE(error_ok == ringbuffer_shrink(rb, 8));
+    EXPECT_TRUE(8 == ringbuffer_get_max_size(rb));
+    EXPECT_TRUE(error_ok == ringbuffer_shrink(rb, 64));
+    EXPECT_TRUE(8 == ringbuffer_get_max_size(rb));
+    EXPECT_TRUE(8 == ringbuffer_write_lock_size(rb));
+    EXPECT_TRUE(error_recvbuffer_locked == ringbuffer_shrink(rb, 4));
+    ringbuffer_write_unlock(rb);
+    // Ϊʱͷȫڴ, дʱ·
+    EXPECT_TRUE(error_ok == ringbuffer_shrink(rb, 0));
+    EXPECT_TRUE(0 == ringbuffer_get_max_size(rb));
+    EXPECT_TRUE(0 == ringbuffer_read_lock_size(rb));
+    EXPECT_TRUE(3 == ringbuffer_write(rb, "xyz", 3));
+    EXPECT_TRUE(3 == ringbuffer_read(rb, out, sizeof(out)));
+    EXPECT_TRUE(!memcmp(out, "xyz", 3));
+    EXPECT_TRUE(error_ok == ringbuffer_shrink(rb, 0));
+    EXPECT_TRUE(ringbuffer_write_lock_size(rb) > 0);
+    ringbuffer_write_unlock(rb);
+    ringbuffer_destroy(rb);
+}
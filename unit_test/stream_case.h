@@ -158,3 +158,260 @@ CASE(Test_Stream_Copy_Stream) {
     knet_loop_run(loop);
     knet_loop_destroy(loop);
 }
+
+int Test_Stream_Push_Owned_Free_Count = 0;
+int Test_Stream_Push_Owned_Recv_Bytes = 0;
+kchannel_ref_t* Test_Stream_Push_Owned_Connector = 0;
+
+CASE(Test_Stream_Push_Owned) {
+    // 㿽, ׽ַͻʱʣݲ, ɺͷ
+    struct holder {
+        static void free_cb(void* ptr, int size, void* ctx) {
+            EXPECT_TRUE(ptr == ctx);
+            EXPECT_TRUE(size == 1024 * 1024 * 4);
+            free(ptr);
+            Test_Stream_Push_Owned_Free_Count++;
+        }
+
+        static void producer(kthread_runner_t* runner) {
+            // ߳㿽
+            kbuffer_t* buffer = (kbuffer_t*)thread_runner_get_params(runner);
+            EXPECT_TRUE(error_ok == knet_stream_push_buffer(knet_channel_ref_get_stream(Test_Stream_Push_Owned_Connector), buffer));
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Stream_Push_Owned_Recv_Bytes += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+                if (Test_Stream_Push_Owned_Recv_Bytes == 1024 * 1024 * 4 + 1024) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    Test_Stream_Push_Owned_Connector = connector;
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+
+    kstream_t* stream = knet_channel_ref_get_stream(connector);
+    char* data = (char*)malloc(1024 * 1024 * 4);
+    memset(data, 'x', 1024 * 1024 * 4);
+    EXPECT_TRUE(error_ok == knet_stream_push_owned(stream, data, 1024 * 1024 * 4, &holder::free_cb, data));
+
+    // ͬһkbuffer_tͺɵ߳һ
+    kbuffer_t* buffer = knet_buffer_create(1024);
+    char temp[1024];
+    memset(temp, 'y', sizeof(temp));
+    knet_buffer_put(buffer, temp, sizeof(temp));
+    knet_buffer_incref(buffer);
+    kthread_runner_t* runner = thread_runner_create(&holder::producer, buffer);
+    thread_runner_start(runner, 0);
+    thread_runner_join(runner);
+    thread_runner_destroy(runner);
+
+    knet_loop_run(loop);
+    EXPECT_TRUE(1 == Test_Stream_Push_Owned_Free_Count);
+    EXPECT_TRUE(1024 * 1024 * 4 + 1024 == Test_Stream_Push_Owned_Recv_Bytes);
+    EXPECT_TRUE(0 == knet_buffer_decref(buffer));
+    knet_loop_destroy(loop);
+}
+
+int Test_Stream_Pushv_Recv_Bytes = 0;
+kchannel_ref_t* Test_Stream_Pushv_Connector = 0;
+
+CASE(Test_Stream_Pushv) {
+    // ͷ, , βɢд, ն˰˳յ
+    struct holder {
+        static void push(kchannel_ref_t* channel) {
+            static char body[1024 * 256];
+            memset(body, 'b', sizeof(body));
+            kiovec_t iov[3] = {{"head", 4}, {body, sizeof(body)}, {"tail", 4}};
+            EXPECT_TRUE(error_ok == knet_stream_pushv(knet_channel_ref_get_stream(channel), iov, 3));
+        }
+
+        static void producer(kthread_runner_t* runner) {
+            (void)runner;
+            // ̷߳ɢд
+            push(Test_Stream_Pushv_Connector);
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                char temp[4] = {0};
+                // ÿյһİ
+                while (knet_stream_available(stream) >= 1024 * 256 + 8) {
+                    EXPECT_TRUE(error_ok == knet_stream_pop(stream, temp, 4));
+                    EXPECT_TRUE(!memcmp(temp, "head", 4));
+                    EXPECT_TRUE(error_ok == knet_stream_eat(stream, 1024 * 256));
+                    EXPECT_TRUE(error_ok == knet_stream_pop(stream, temp, 4));
+                    EXPECT_TRUE(!memcmp(temp, "tail", 4));
+                    Test_Stream_Pushv_Recv_Bytes += 1024 * 256 + 8;
+                }
+                if (Test_Stream_Pushv_Recv_Bytes == (1024 * 256 + 8) * 2) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    Test_Stream_Pushv_Connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 512);
+    EXPECT_TRUE(connect_pair(loop, Test_Stream_Pushv_Connector, acceptor, &holder::acceptor_cb));
+
+    // ǰ̷߳ɢд
+    holder::push(Test_Stream_Pushv_Connector);
+    kthread_runner_t* runner = thread_runner_create(&holder::producer, 0);
+    thread_runner_start(runner, 0);
+    thread_runner_join(runner);
+    thread_runner_destroy(runner);
+
+    knet_loop_run(loop);
+    EXPECT_TRUE((1024 * 256 + 8) * 2 == Test_Stream_Pushv_Recv_Bytes);
+    knet_loop_destroy(loop);
+}
+
+int Test_Stream_Send_Pending_Recv_Bytes = 0;
+
+CASE(Test_Stream_Send_Pending) {
+    // δ͵ݼȴֽ, ȫͺ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Stream_Send_Pending_Recv_Bytes += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+                if (Test_Stream_Send_Pending_Recv_Bytes == 1024 * 1024 * 4) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+
+    // ֶд, ׽ַͻдʣݽ뷢Ͷ
+    for (int i = 0; i < 64; i++) {
+        EXPECT_TRUE(error_ok == push_fill(knet_channel_ref_get_stream(connector), 'x', 1024 * 64));
+    }
+    EXPECT_TRUE(knet_loop_profile_get_send_pending_bytes(profile) > 0);
+
+    knet_loop_run(loop);
+    EXPECT_TRUE(1024 * 1024 * 4 == Test_Stream_Send_Pending_Recv_Bytes);
+    EXPECT_TRUE(0 == knet_loop_profile_get_send_pending_bytes(profile));
+    knet_loop_destroy(loop);
+}
+
+int Test_Stream_Peek_Recv_Bytes = 0;
+
+CASE(Test_Stream_Peek) {
+    // ջ, ܵĹܵԭطȫɶ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int size = 0;
+                const char* ptr = knet_stream_peek(stream, &size);
+                EXPECT_TRUE(size == knet_stream_available(stream));
+                for (int i = 0; i < size; i++) {
+                    EXPECT_TRUE(ptr[i] == (char)('a' + (Test_Stream_Peek_Recv_Bytes + i) % 26));
+                }
+                Test_Stream_Peek_Recv_Bytes += size;
+                knet_stream_eat(stream, size);
+                if (Test_Stream_Peek_Recv_Bytes == 1024 * 1024) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 16);
+    if (error_ok != knet_channel_ref_set_recv_mirror(acceptor)) {
+        // ǰƽ̨֧
+        knet_loop_destroy(loop);
+        return;
+    }
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+    // Ȳǻȵ, ݻԽĩβ
+    char buffer[1000];
+    for (int i = 0, sent = 0; sent < 1024 * 1024; sent += i) {
+        i = (1024 * 1024 - sent) < (int)sizeof(buffer) ? (1024 * 1024 - sent) : (int)sizeof(buffer);
+        for (int j = 0; j < i; j++) {
+            buffer[j] = (char)('a' + (sent + j) % 26);
+        }
+        EXPECT_TRUE(error_ok == knet_stream_push(knet_channel_ref_get_stream(connector), buffer, i));
+    }
+    knet_loop_run(loop);
+    EXPECT_TRUE(1024 * 1024 == Test_Stream_Peek_Recv_Bytes);
+    knet_loop_destroy(loop);
+}
+
+int Test_Stream_Recv_Calls_Bytes = 0;
+
+CASE(Test_Stream_Recv_Calls) {
+    // ջʱһϵͳ, ݱ˳, ϵͳôͳ
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, acceptor_cb);
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                char buffer[777];
+                // ÿֻȡ, дλòϿԽĩβ
+                while (knet_stream_available(stream) >= (int)sizeof(buffer)) {
+                    EXPECT_TRUE(error_ok == knet_stream_pop(stream, buffer, sizeof(buffer)));
+                    for (int i = 0; i < (int)sizeof(buffer); i++) {
+                        EXPECT_TRUE(buffer[i] == (char)((Test_Stream_Recv_Calls_Bytes + i) % 251));
+                    }
+                    Test_Stream_Recv_Calls_Bytes += sizeof(buffer);
+                }
+                if (Test_Stream_Recv_Calls_Bytes == 777 * 1000) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 4000);
+    EXPECT_TRUE(connect_pair(loop, connector, acceptor, &holder::acceptor_cb));
+    uint64_t send_calls = knet_loop_profile_get_send_call_count(profile);
+    char* data = (char*)malloc(777 * 1000);
+    for (int i = 0; i < 777 * 1000; i++) {
+        data[i] = (char)(i % 251);
+    }
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(error_ok == knet_stream_push(knet_channel_ref_get_stream(connector), data + i * 777, 777));
+    }
+    knet_loop_run(loop);
+    EXPECT_TRUE(777 * 1000 == Test_Stream_Recv_Calls_Bytes);
+    EXPECT_TRUE(knet_loop_profile_get_send_call_count(profile) > send_calls);
+#if !LOOP_URING
+    // io_uringͨύн, ϵͳô
+    EXPECT_TRUE(knet_loop_profile_get_recv_call_count(profile) > 0);
+    EXPECT_TRUE(knet_loop_profile_get_recv_call_count(profile) < 777 * 1000 / 777);
+#endif // !LOOP_URING
+    free(data);
+    knet_loop_destroy(loop);
+}
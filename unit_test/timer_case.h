@@ -114,3 +114,280 @@ CASE(Test_Timer_Stop) {
     EXPECT_TRUE(100 == Test_Timer_i);
     ktimer_loop_destroy(l);
 }
+
+CASE(Test_Timer_Wheel_Run_Once) {
+    Test_Timer_i = 0;
+    struct holder {
+        static void timer_cb(ktimer_t* t, void*) {
+            Test_Timer_i++;
+            EXPECT_TRUE(ktimer_check_dead(t));
+        }
+    };
+
+    // δ𳤶10ʱ
+    ktimer_loop_t* l = ktimer_loop_create_with_type(10, ktimer_loop_type_wheel);
+    EXPECT_TRUE(10 == ktimer_loop_get_tick_intval(l));
+    for (int i = 0; i < 100; i++) {
+        ktimer_t* t = ktimer_create(l);
+        ktimer_start_once(t, &holder::timer_cb, 0, 90);
+    }
+    ktimer_loop_run_once(l);
+    EXPECT_TRUE(0 == Test_Timer_i);
+    thread_sleep_ms(100);
+    ktimer_loop_run_once(l);
+    EXPECT_TRUE(100 == Test_Timer_i);
+    ktimer_loop_destroy(l);
+}
+
+CASE(Test_Timer_Wheel_Stop) {
+    Test_Timer_i = 0;
+    struct holder {
+        static void timer_cb(ktimer_t* t, void*) {
+            // ڻصֹͣԼ
+            EXPECT_TRUE(error_ok == ktimer_stop(t));
+            Test_Timer_i++;
+        }
+    };
+
+    ktimer_loop_t* l = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
+    ktimer_t* timers[100] = {0};
+    for (int i = 0; i < 100; i++) {
+        timers[i] = ktimer_create(l);
+        ktimer_start(timers[i], &holder::timer_cb, 0, 20);
+        EXPECT_TRUE(error_multiple_start == ktimer_start(timers[i], &holder::timer_cb, 0, 20));
+    }
+    // ǰֹͣһ
+    for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(error_ok == ktimer_stop(timers[i]));
+    }
+    for (int i = 0; i < 20; i++) {
+        thread_sleep_ms(5);
+        ktimer_loop_run_once(l);
+    }
+    // ڶʱڻصֹͣٴ
+    EXPECT_TRUE(50 == Test_Timer_i);
+    ktimer_loop_destroy(l);
+}
+
+CASE(Test_Timer_Wheel_Cascade) {
+    Test_Timer_i = 0;
+    struct holder {
+        static void timer_cb(ktimer_t*, void* data) {
+            // ǰ
+            EXPECT_TRUE(time_get_milliseconds_19700101() >= *(uint64_t*)data);
+            Test_Timer_i++;
+        }
+    };
+
+    // δ𳤶1, 300ڵĶʱڵڶ, ǰһ
+    ktimer_loop_t* l = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
+    uint64_t deadline = time_get_milliseconds_19700101() + 300;
+    ktimer_t* t = ktimer_create(l);
+    ktimer_start_times(t, &holder::timer_cb, &deadline, 300, 2);
+    for (int i = 0; (i < 1000) && (Test_Timer_i < 1); i++) {
+        thread_sleep_ms(1);
+        ktimer_loop_run_once(l);
+    }
+    EXPECT_TRUE(1 == Test_Timer_i);
+    for (int i = 0; (i < 1000) && (Test_Timer_i < 2); i++) {
+        thread_sleep_ms(1);
+        ktimer_loop_run_once(l);
+    }
+    EXPECT_TRUE(2 == Test_Timer_i);
+    ktimer_loop_destroy(l);
+}
+
+CASE(Test_Timer_Wheel_Next_Expire) {
+    Test_Timer_i = 0;
+    struct holder {
+        static void timer_cb(ktimer_t*, void*) {
+            Test_Timer_i++;
+        }
+    };
+
+    // δ𳤶1, 2000ڵĶʱڵڶ, ȴڲ۱һǵһתһȦ
+    ktimer_loop_t* l = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
+    ktimer_t* t = ktimer_create(l);
+    ktimer_start_once(t, &holder::timer_cb, 0, 2000);
+    EXPECT_TRUE(ktimer_loop_get_next_timeout_us(l) > 1700 * 1000);
+    int wakeup = 0;
+    for (int i = 0; (i < 10) && (Test_Timer_i < 1); i++) {
+        thread_sleep_ms((int)((ktimer_loop_get_next_timeout_us(l) + 999) / 1000));
+        ktimer_loop_run_once(l);
+        wakeup++;
+    }
+    EXPECT_TRUE(1 == Test_Timer_i);
+    // һһ, һ
+    EXPECT_TRUE(wakeup <= 3);
+    ktimer_loop_destroy(l);
+}
+
+struct Test_Timer_Node_Request {
+    int           id;
+    ktimer_node_t deadline;
+};
+
+CASE(Test_Timer_Node) {
+    Test_Timer_i = 0;
+    struct holder {
+        static void timeout_cb(ktimer_node_t* node, void* data) {
+            // ڵѾȡ, صͷڶ
+            EXPECT_FALSE(ktimer_node_check_start(node));
+            Test_Timer_Node_Request* request = (Test_Timer_Node_Request*)data;
+            Test_Timer_i += request->id;
+            delete request;
+        }
+        static void period_cb(ktimer_node_t* node, void*) {
+            // ڽڵѾ·ʱ
+            EXPECT_TRUE(ktimer_node_check_start(node));
+            if (++Test_Timer_i == 3) {
+                ktimer_node_stop(node);
+            }
+        }
+    };
+
+    // ֧Ƕʽʱ
+    ktimer_loop_t* r = ktimer_loop_create(0);
+    ktimer_node_t n;
+    ktimer_node_init(&n, r);
+    EXPECT_TRUE(error_invalid_parameters == ktimer_node_start_once(&n, &holder::period_cb, 0, 10));
+    EXPECT_FALSE(ktimer_node_check_start(&n));
+    ktimer_loop_destroy(r);
+
+    ktimer_loop_t* l = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
+    // , ڶڳʱǰ
+    Test_Timer_Node_Request* first = new Test_Timer_Node_Request;
+    Test_Timer_Node_Request* second = new Test_Timer_Node_Request;
+    first->id = 1;
+    second->id = 100;
+    ktimer_node_init(&first->deadline, l);
+    ktimer_node_init(&second->deadline, l);
+    EXPECT_TRUE(error_ok == ktimer_node_start_once(&first->deadline, &holder::timeout_cb, first, 5));
+    EXPECT_TRUE(error_multiple_start == ktimer_node_start_once(&first->deadline, &holder::timeout_cb, first, 5));
+    EXPECT_TRUE(error_ok == ktimer_node_start_once(&second->deadline, &holder::timeout_cb, second, 5));
+    // Ƴٵʱ
+    EXPECT_TRUE(error_ok == ktimer_node_restart(&second->deadline, 1000));
+    EXPECT_TRUE(ktimer_node_check_start(&second->deadline));
+    for (int i = 0; (i < 1000) && (Test_Timer_i < 1); i++) {
+        thread_sleep_ms(1);
+        ktimer_loop_run_once(l);
+    }
+    EXPECT_TRUE(1 == Test_Timer_i);
+    ktimer_node_stop(&second->deadline);
+    EXPECT_FALSE(ktimer_node_check_start(&second->deadline));
+    delete second;
+
+    Test_Timer_i = 0;
+    ktimer_node_init(&n, l);
+    EXPECT_TRUE(error_invalid_parameters == ktimer_node_restart(&n, 1));
+    EXPECT_TRUE(error_ok == ktimer_node_start(&n, &holder::period_cb, 0, 2));
+    for (int i = 0; (i < 1000) && ktimer_node_check_start(&n); i++) {
+        thread_sleep_ms(1);
+        ktimer_loop_run_once(l);
+    }
+    EXPECT_TRUE(3 == Test_Timer_i);
+    EXPECT_FALSE(ktimer_node_check_start(&n));
+    // ٶʱѭʱδֹͣǶʽʱȡ, ͷ
+    EXPECT_TRUE(error_ok == ktimer_node_start(&n, &holder::period_cb, 0, 1000));
+    ktimer_loop_destroy(l);
+    EXPECT_FALSE(ktimer_node_check_start(&n));
+}
+
+CASE(Test_Timer_Slack) {
+    struct holder {
+        static void timer_cb(ktimer_t*, void* data) {
+            // ֻƳ, ǰ
+            EXPECT_TRUE(time_get_milliseconds_19700101() >= *(uint64_t*)data);
+            Test_Timer_i++;
+        }
+    };
+
+    // ʱ϶뵽100, ڴǰʱ110뵽ڵĶʱ뵽ͬһʱ,
+    // ͬһѭһ
+    ktimer_loop_type_e types[] = { ktimer_loop_type_rbtree, ktimer_loop_type_wheel };
+    for (int k = 0; k < 2; k++) {
+        Test_Timer_i = 0;
+        ktimer_loop_t* l = ktimer_loop_create_with_type(0, types[k]);
+        while (time_get_milliseconds_19700101() % 100 >= 50) {
+            thread_sleep_ms(1);
+        }
+        uint64_t deadlines[10];
+        for (int i = 0; i < 10; i++) {
+            ktimer_t* t = ktimer_create(l);
+            ktimer_set_slack(t, 100);
+            deadlines[i] = time_get_milliseconds_19700101() + i + 1;
+            ktimer_start_once(t, &holder::timer_cb, &deadlines[i], i + 1);
+        }
+        int wakeup = 0;
+        for (int i = 0; (i < 1000) && (Test_Timer_i < 10); i++) {
+            thread_sleep_ms(1);
+            if (ktimer_loop_run_once(l)) {
+                wakeup++;
+            }
+        }
+        EXPECT_TRUE(10 == Test_Timer_i);
+        EXPECT_TRUE(1 == wakeup);
+        ktimer_loop_destroy(l);
+    }
+}
+
+CASE(Test_Timer_Microseconds) {
+    struct holder {
+        static void node_cb(ktimer_node_t*, void* data) {
+            // ǰ
+            EXPECT_TRUE(time_get_microseconds_19700101() >= *(uint64_t*)data);
+            Test_Timer_i++;
+        }
+        static void timer_cb(ktimer_t* timer, void*) {
+            if (++Test_Timer_i == 3) {
+                ktimer_stop(timer);
+            }
+        }
+    };
+
+    // ԺΪ, ֧΢붨ʱ
+    ktimer_loop_t* r = ktimer_loop_create(0);
+    EXPECT_TRUE(error_invalid_parameters == ktimer_loop_set_tick_us(r, 100));
+    ktimer_t* t = ktimer_create(r);
+    EXPECT_TRUE(error_invalid_parameters == ktimer_start_once_us(t, &holder::timer_cb, 0, 100));
+    // δĶʱֹͣʱֱ
+    ktimer_stop(t);
+    ktimer_loop_destroy(r);
+
+    Test_Timer_i = 0;
+    ktimer_loop_t* l = ktimer_loop_create_with_type(0, ktimer_loop_type_wheel);
+    // ̵δǰĶʱԭĵʱ
+    ktimer_node_t n;
+    ktimer_node_init(&n, l);
+    uint64_t deadline = time_get_microseconds_19700101() + 20000;
+    EXPECT_TRUE(error_ok == ktimer_node_start_once(&n, &holder::node_cb, &deadline, 20));
+    EXPECT_TRUE(error_ok == ktimer_loop_set_tick_us(l, 100));
+    EXPECT_TRUE(ktimer_node_check_start(&n));
+    time_t us = ktimer_loop_get_next_timeout_us(l);
+    // ԭĵʱѾȡ1
+    EXPECT_TRUE((us > 0) && (us <= 20000 + 1000));
+    while (Test_Timer_i < 1) {
+        ktimer_loop_run_once(l);
+    }
+
+    // Ǻ붨ʱ
+    Test_Timer_i = 0;
+    deadline = time_get_microseconds_19700101() + 300;
+    EXPECT_TRUE(error_ok == ktimer_node_start_once_us(&n, &holder::node_cb, &deadline, 300));
+    // ʱȡδ
+    EXPECT_TRUE(ktimer_loop_get_next_timeout_us(l) <= 300 + 100);
+    while (Test_Timer_i < 1) {
+        ktimer_loop_run_once(l);
+    }
+    EXPECT_FALSE(ktimer_node_check_start(&n));
+
+    Test_Timer_i = 0;
+    EXPECT_TRUE(error_ok == ktimer_start_us(ktimer_create(l), &holder::timer_cb, 0, 200));
+    for (int i = 0; (i < 1000) && (Test_Timer_i < 3); i++) {
+        thread_sleep_us(100);
+        ktimer_loop_run_once(l);
+    }
+    EXPECT_TRUE(3 == Test_Timer_i);
+    EXPECT_TRUE(-1 == ktimer_loop_get_next_timeout_us(l));
+    ktimer_loop_destroy(l);
+}